@@ -82,19 +82,47 @@ class rb_tree {
                            // It is always black and its parent is always itself. 
                            // max/min correspond to its right/left child,
                            // or NULL if the tree is empty (see init_tree)
-  size_type      node_count;
-  node_allocator node_alloc;
 
-  public:
+  /*
+   * The comparator, key extractor and node allocator, folded into
+   * node_count's storage : with std::less and std::allocator they
+   * are empty and take no room (see compressed_pair), so the tree is
+   * three pointers.
+   */
+  typedef compressed_pair<key_extractor, node_allocator> extractor_alloc;
+  typedef compressed_pair<key_compare, extractor_alloc>  tree_policies;
+
+  compressed_pair<size_type, tree_policies> _count_policies;
+
+  size_type& node_count() { return _count_policies.first(); }
+  size_type node_count() const { return _count_policies.first(); }
+
+  node_allocator& node_alloc() {
+    return _count_policies.second().second().second();
+  }
+
+  const node_allocator& node_alloc() const {
+    return _count_policies.second().second().second();
+  }
+
+  bool key_cmp( const Key& x, const Key& y ) {
+    return _count_policies.second().first()(x, y);
+  }
+
+  bool key_cmp( const Key& x, const Key& y ) const {
+    return _count_policies.second().first()(x, y);
+  }
+
+  Key key_of_val( const Val& value ) const {
+    return _count_policies.second().second().first()(value);
+  }
 
-  key_compare    key_cmp;
-  key_extractor  key_of_val;
+  public:
 
   rb_tree()
   :
     _root(0),
-    node_count(0),
-    node_alloc()
+    _count_policies()
   {
     init_tree();
   }
@@ -102,8 +130,7 @@ class rb_tree {
   rb_tree( const rb_tree& other )
   :
     _root(0),
-    node_count(0),
-    node_alloc(other.node_alloc)
+    _count_policies(0, other._count_policies.second())
   {
     init_tree();
     for (rb_tree::const_iterator it = other.begin(); it != other.end(); it++) {
@@ -111,19 +138,47 @@ class rb_tree {
     }
   }
 
-  rb_tree( const Compare& comp )
+#ifdef FT_CONTAINERS_CXX11
+  /*
+   * Takes other's nodes and sentinel. other is left pointing at the
+   * shared empty sentinel (see empty_sentinel), so nothing is
+   * allocated and the move cannot throw.
+   */
+  rb_tree( rb_tree&& other ) noexcept
+  :
+    _root(other._root),
+    node_end(other.node_end),
+    _count_policies(other._count_policies)
+  {
+    other.node_count() = 0;
+    other.node_end = empty_sentinel();
+    other._root = other.node_end;
+  }
+
+  rb_tree& operator=( rb_tree&& other ) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+#endif
+
+  rb_tree( const Compare& comp, const Allocator& alloc = Allocator() )
   :
     _root(0),
-    node_count(0),
-    node_alloc(),
-    key_cmp(comp)
+    _count_policies(0, tree_policies(comp,
+                         extractor_alloc(key_extractor(),
+                                         node_allocator(alloc))))
   {
     init_tree();
   }
 
   ~rb_tree() {
     delete_subtree(_root);
-    destroy_node(node_end);
+    if (owns_sentinel()) {
+      destroy_node(node_end);
+    }
   }
 
   node_ptr get_node_end() const {
@@ -146,7 +201,7 @@ class rb_tree {
       delete_subtree(node->right);
       node_ptr save = node->left;
       destroy_node(node);
-      --node_count;
+      --node_count();
       node = save;
     }
   }
@@ -172,7 +227,11 @@ class rb_tree {
 
   // Node end acts as nil. Starts being root
   void init_tree() {
+#ifdef FT_CONTAINERS_CXX11
+    node_end = emplace_node(0);
+#else
     node_end = construct_node(Val(), 0);
+#endif
     node_end->assign_parent(node_end);
     node_end->assign_left_child(0);
     node_end->assign_right_child(0);
@@ -180,15 +239,71 @@ class rb_tree {
     _root = node_end;
   }
 
+#ifdef FT_CONTAINERS_CXX11
+  /*
+   * The sentinel of every moved-from tree of this type : never
+   * allocated, never written to. The first insertion gives the tree a
+   * sentinel of its own (see ensure_tree).
+   */
+  struct shared_sentinel : node_type {
+    shared_sentinel() : node_type(node_ptr(0)) {
+      this->assign_parent(this);
+      this->assign_left_child(0);
+      this->assign_right_child(0);
+      this->color = black;
+    }
+  };
+
+  static node_ptr empty_sentinel() {
+    static shared_sentinel sentinel;
+    return &sentinel;
+  }
+
+  bool owns_sentinel() const {
+    return node_end != empty_sentinel();
+  }
+#else
+  bool owns_sentinel() const {
+    return true;
+  }
+#endif
+
+  // called before a node is built with node_end
+  void ensure_tree() {
+    if (!owns_sentinel()) {
+      init_tree();
+    }
+  }
+
+#ifndef FT_CONTAINERS_CXX11
   node_ptr construct_node(const Val& value, node_ptr node_end) {
-    node_ptr new_node = node_alloc.allocate(1);
-    node_alloc.construct(new_node, node_type(value, node_end));
+    node_ptr new_node = node_alloc().allocate(1);
+    node_alloc().construct(new_node, node_type(value, node_end));
     return new_node;
   }
+#else
+  node_ptr construct_node(const Val& value, node_ptr node_end) {
+    return emplace_node(node_end, value);
+  }
+
+  template <typename... Args>
+  node_ptr emplace_node(node_ptr node_end, Args&&... args) {
+    typedef std::allocator_traits<node_allocator> node_traits;
+    node_ptr new_node = node_alloc().allocate(1);
+    try {
+      node_traits::construct(node_alloc(), new_node, node_end,
+                             std::forward<Args>(args)...);
+    } catch (...) {
+      node_alloc().deallocate(new_node, 1);
+      throw;
+    }
+    return new_node;
+  }
+#endif
 
   void destroy_node(node_ptr node) {
-    node_alloc.destroy(node);
-    node_alloc.deallocate(node, 1);
+    node_alloc().destroy(node);
+    node_alloc().deallocate(node, 1);
   }
 
   /* 
@@ -310,12 +425,12 @@ class rb_tree {
 
   node_ptr find_and_insert(node_ptr new_node, node_ptr init) {
 
-    if (node_count == 0) {
+    if (node_count() == 0) {
       new_node->assign_parent(node_end);
       node_end->assign_right_child(new_node);
       node_end->assign_left_child(new_node);
       _root = new_node;
-      ++node_count;
+      ++node_count();
       return new_node;
     }
 
@@ -352,7 +467,7 @@ class rb_tree {
       }
       parent->assign_left_child(new_node);
     }
-    ++node_count;
+    ++node_count();
     return new_node;
   }
 
@@ -382,29 +497,21 @@ class rb_tree {
   }
 
   /*
-   * To swap values, since val = pair <const Key, Val>, it is not doable
-   * with some swap method. The value data iside the node pointer must be
-   * destructed, and reconstructed.
-   * mantaining allocated space is crucial. So we clone,
-   * destroy, then construct as we please, without calling deallocate
+   * n has two children. Swaps the positions (links and colors) of n
+   * and its inorder predecessor r, values stay where they are : val
+   * is pair<const Key, T>, swapping values would mean destroying and
+   * copy-constructing both, this is a handful of pointer writes.
+   * Every node keeps its value, so min/max and iterators to r stay
+   * valid. Returns n, now at r's old place, with at most a left child.
+   *
+   *        n                 r
+   *      /   \             /      *     A     B   ===>    A     B
+   *      \                    *       r                 n
+   *      /                 /
+   *     rL                rL
+   *
+   * (or, when r == n->left, r takes n's place and n becomes r's left)
    */
-  void swap_node_values(node_ptr n1, node_ptr n2) {
-    node_type n1_tmp_clone(*n1); // cannot use assignment because of const Key
-    node_type n2_tmp_clone(*n2);
-    node_alloc.destroy(n1);
-    node_alloc.destroy(n2);
-    node_alloc.construct(n1, node_type(n2_tmp_clone.data,
-                                       n1_tmp_clone.parent,
-                                       n1_tmp_clone.left,
-                                       n1_tmp_clone.right,
-                                       n1_tmp_clone.color));
-    node_alloc.construct(n2, node_type(n1_tmp_clone.data,
-                                       n2_tmp_clone.parent,
-                                       n2_tmp_clone.left,
-                                       n2_tmp_clone.right,
-                                       n2_tmp_clone.color));
-  }
-
   node_ptr switch_with_inorder_predecessor(node_ptr n) {
 
     node_ptr r = n->left;
@@ -412,15 +519,38 @@ class rb_tree {
     while (r->right != node_end) {
       r = r->right;
     }
-    // update min/max before switching !! else this causes use after free
-    if (r == node_end->left) {
-      node_end->left = n;
+    node_ptr n_parent = n->parent;
+    node_ptr n_left = n->left;
+    node_ptr n_right = n->right;
+    node_ptr r_parent = r->parent;
+    node_ptr r_left = r->left;
+
+    if (n == _root) {
+      _root = r;
+    } else if (n->is_left_child()) {
+      n_parent->assign_left_child(r);
+    } else {
+      n_parent->assign_right_child(r);
+    }
+    r->assign_parent(n_parent);
+    r->assign_right_child(n_right);
+    n_right->assign_parent(r);
+    if (r_parent == n) {
+      r->assign_left_child(n);
+      n->assign_parent(r);
+    } else {
+      r->assign_left_child(n_left);
+      n_left->assign_parent(r);
+      r_parent->assign_right_child(n);
+      n->assign_parent(r_parent);
     }
-    if (r == node_end->right) {
-      node_end->right = n;
+    n->assign_left_child(r_left);
+    if (r_left != node_end) {
+      r_left->assign_parent(n);
     }
-    swap_node_values(r, n);
-    return r;
+    n->assign_right_child(node_end);
+    ft::swap(n->color, r->color);
+    return n;
   }
 
   /* 
@@ -580,9 +710,9 @@ class rb_tree {
     bool update_max = n == node_end->right;
 
     // deleting the only node
-    if (n == _root && node_count == 1) {
+    if (n == _root && node_count() == 1) {
       destroy_node(n);
-      --node_count;
+      --node_count();
       node_end->assign_left_child(0);
       node_end->assign_right_child(0);
       _root = node_end;
@@ -652,28 +782,40 @@ class rb_tree {
                 const_cast<node_ptr>(get_maximum_the_hard_way()));
     }
     destroy_node(n);
-    --node_count;
+    --node_count();
     return node_end;
   }
 
   public:
 
-  // allocator and key_cmp are dumb to swap, since 
-  // the other tree has the same types as this one.
+  // the comparator and allocator go with the nodes
   void swap(rb_tree& other) {
     ft::swap(_root, other._root);
     ft::swap(node_end, other.node_end);
-    ft::swap(node_count, other.node_count);
+    ft::swap(_count_policies, other._count_policies);
+  }
+
+  key_compare key_comp() const {
+    return _count_policies.second().first();
+  }
+
+  node_allocator get_node_allocator() const {
+    return node_alloc();
   }
 
+  // keeps the sentinel : clearing allocates nothing
   void clear() {
+    if (empty()) {
+      return;
+    }
     delete_subtree(_root);
-    destroy_node(node_end);
-    init_tree();
+    node_end->assign_left_child(0);
+    node_end->assign_right_child(0);
+    _root = node_end;
   }
 
   size_type max_size() const {
-    return node_alloc.max_size();
+    return node_alloc().max_size();
   }
 
   /*
@@ -737,22 +879,22 @@ class rb_tree {
   }
 
   node_ptr get_maximum() {
-    return node_count < 2 ? const_cast<node_ptr>(get_maximum_the_hard_way())
+    return node_count() < 2 ? const_cast<node_ptr>(get_maximum_the_hard_way())
                           : node_end->right;
   }
 
   const_node_ptr get_maximum() const {
-    return node_count < 2 ? get_maximum_the_hard_way()
+    return node_count() < 2 ? get_maximum_the_hard_way()
                           : node_end->right;
   }
 
   node_ptr get_minimum() {
-    return node_count < 2 ? const_cast<node_ptr>(get_minimum_the_hard_way())
+    return node_count() < 2 ? const_cast<node_ptr>(get_minimum_the_hard_way())
                           : node_end->left;
   }
 
   const_node_ptr get_minimum() const {
-    return node_count < 2 ? get_minimum_the_hard_way()
+    return node_count() < 2 ? get_minimum_the_hard_way()
                           : node_end->left;
   }
 
@@ -789,16 +931,21 @@ class rb_tree {
   }
 
   inline bool empty() const {
-    return node_count == 0;
+    return node_count() == 0;
   }
 
   inline size_type size() const {
-    return node_count;
+    return node_count();
   }
 
-  ft::pair<iterator, bool> insert(const Val& value) {
+  private:
+
+  /*
+   * Links an already built node n. If its key is already there, n is
+   * destroyed and the existing node is returned instead.
+   */
+  ft::pair<iterator, bool> insert_node(node_ptr n) {
 
-    node_ptr n = construct_node(value, node_end);
     node_ptr m = NULL;
     
     if ((m = find_and_insert(n, _root)) != n) {
@@ -809,27 +956,42 @@ class rb_tree {
     return ft::pair<iterator, bool>(iterator(n, node_end), true);
   }
 
-  iterator insert_with_hint( iterator hint, const Val& value)
-  {
-    node_ptr n = construct_node(value, node_end);
+  node_ptr insert_node_with_hint(node_ptr hint, node_ptr n) {
+
     node_ptr m = NULL;
 
-    if (hint == end()) {
+    // an empty tree's hint may be a moved-from sentinel (ensure_tree)
+    if (hint == node_end || node_count() == 0) {
       m = find_and_insert(n, _root);
     } else {
-      bool good_hint = check_hint(hint.base(), value);
+      bool good_hint = check_hint(hint, n->data);
       if (good_hint) {
-        m = find_and_insert(n, hint.base());
+        m = find_and_insert(n, hint);
       } else {
         m = find_and_insert(n, _root);
       }
     }
     if (m != n) {
       destroy_node(n);
-      return iterator(m, node_end);
+      return m;
     }
     rebalance_after_insertion(n);
-    return iterator(n, node_end);
+    return n;
+  }
+
+  public:
+
+  ft::pair<iterator, bool> insert(const Val& value) {
+    ensure_tree();
+    return insert_node(construct_node(value, node_end));
+  }
+
+  iterator insert_with_hint( iterator hint, const Val& value)
+  {
+    ensure_tree();
+    return iterator(insert_node_with_hint(hint.base(),
+                                          construct_node(value, node_end)),
+                    node_end);
   }
 
   /* Insert with hint for set. Problem is, set has no knowledge whatsoever
@@ -839,26 +1001,31 @@ class rb_tree {
    */
   const_iterator insert_with_hint( const_iterator hint, const Val& value)
   {
-    node_ptr n = construct_node(value, node_end);
-    node_ptr m = NULL;
+    ensure_tree();
+    return const_iterator(insert_node_with_hint(
+                            const_cast<node_ptr>(hint.base()),
+                            construct_node(value, node_end)),
+                          node_end);
+  }
 
-    if (hint == end()) {
-      m = find_and_insert(n, _root);
-    } else {
-      bool good_hint = check_hint(const_cast<node_ptr>(hint.base()), value);
-      if (good_hint) {
-        m = find_and_insert(n, const_cast<node_ptr>(hint.base()));
-      } else {
-        m = find_and_insert(n, _root);
-      }
-    }
-    if (m != n) {
-      destroy_node(n);
-      return const_iterator(m, node_end);
-    }
-    rebalance_after_insertion(n);
-    return const_iterator(n, node_end);
+#ifdef FT_CONTAINERS_CXX11
+  /*
+   * The value is built once, straight inside the new node, then
+   * linked (or destroyed if the key is a duplicate, like std::map).
+   */
+  template <typename... Args>
+  ft::pair<iterator, bool> emplace(Args&&... args) {
+    ensure_tree();
+    return insert_node(emplace_node(node_end, std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  node_ptr emplace_hint(node_ptr hint, Args&&... args) {
+    ensure_tree();
+    return insert_node_with_hint(hint,
+              emplace_node(node_end, std::forward<Args>(args)...));
   }
+#endif
 
   node_ptr find(const Key& key) const {
 
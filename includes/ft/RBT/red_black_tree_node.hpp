@@ -3,6 +3,9 @@
 #pragma once
 
 #include <string.h>
+#if __cplusplus >= 201103L
+# include <utility> /* std::forward */
+#endif
 //#include <iostream> 
 
 enum rb_tree_node_color {
@@ -41,19 +44,21 @@ struct rb_tree_node {
     color(red)
   {}
 
+#if __cplusplus >= 201103L
   /*
-   * Trick: This is not a copy constructor. This is used to bypass 
-   * Key being const and be able to swap nodes more easily
+   * Builds data in place from args (emplace, and every insertion in
+   * C++11 mode : no temporary node is copied into the allocation).
    */
-  rb_tree_node(const T& value, node_ptr parent, node_ptr left,
-                               node_ptr right, n_color c)
+  template <typename... Args>
+  rb_tree_node(node_ptr node_end, Args&&... args)
   :
-    parent(parent),
-    left(left),
-    right(right),
-    data(value),
-    color(c)
+    parent(node_end),
+    left(node_end),
+    right(node_end),
+    data(std::forward<Args>(args)...),
+    color(red)
   {}
+#endif
 
   template <typename V>
   rb_tree_node(const rb_tree_node<T>& node)
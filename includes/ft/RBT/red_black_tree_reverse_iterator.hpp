@@ -31,6 +31,11 @@ class rb_tree_reverse_iterator {
     iter(x)
   {}
 
+  rb_tree_reverse_iterator(const rb_tree_reverse_iterator& x)
+  :
+    iter(x.iter)
+  {}
+
   template < typename U >
   rb_tree_reverse_iterator(const rb_tree_reverse_iterator<U>& x,
                   typename ft::enable_if<
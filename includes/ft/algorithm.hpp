@@ -0,0 +1,383 @@
+#ifndef FT_CONTAINERS_ALGORITHM_HPP
+# define FT_CONTAINERS_ALGORITHM_HPP
+#pragma once
+
+#include <cstddef> /* std::size_t */
+#include <cstring> /* std::memmove, std::memset */
+
+#include "ft/utils/utils.hpp"
+#include "ft/utils/iterator_traits.hpp"
+#include "ft/utils/simd.hpp"
+#include "ft/utils/sort.hpp"
+
+/*
+ * A few of <algorithm> and <numeric> : find, count, fill, copy,
+ * min_element, max_element, accumulate. See :
+ * https://en.cppreference.com/w/cpp/algorithm
+ *
+ * Each one is the plain iterator loop, plus a fast path taken when
+ * the range is contiguous (raw pointers, ft::vector iterators) and
+ * holds integers, picked at compile time the same way ft::equal
+ * picks memcmp (is_contiguous_iterator, is_integral). The fast path
+ * runs the kernels of utils/simd.hpp, AVX2 when the cpu has it.
+ * copy only needs the elements to be trivially copyable, and becomes
+ * a memmove.
+ *
+ * Floating point ranges always take the loop : the order of a sum
+ * changes its rounding, and NaN / -0.0 break min, max and find on
+ * bits.
+ *
+ * The sorts (sort, stable_sort, radix_sort, parallel_sort) are in
+ * utils/sort.hpp, next to the heap algorithms they fall back on.
+ */
+
+namespace ft {
+
+/* Exactly the same type, unlike is_same_type const is not ignored. */
+template < typename T, typename U >
+struct is_same_exact : false_type {};
+
+template < typename T >
+struct is_same_exact<T, T> : true_type {};
+
+/*
+ * The kernels read V through the fixed width type of its size
+ * (simd_view below), which strict aliasing only allows if that type
+ * is V itself or its signed / unsigned counterpart : int and int32_t,
+ * long and int64_t on LP64. One byte types are char-like and alias
+ * anything. long long, wchar_t and friends of another name than the
+ * fixed width type take the loop instead.
+ */
+template < typename V, bool Integral = is_integral<V>::value >
+struct is_simd_aliasable : false_type {};
+
+template < typename V >
+struct is_simd_aliasable<V, true>
+  : bool_constant<sizeof(V) == 1
+                  || is_same_exact<V, typename simd_integer<sizeof(V),
+                       is_signed_integer<V>::value>::type>::value>
+{};
+
+/* Contiguous range of integers the kernels may read. */
+template < class It >
+struct is_simd_range
+  : bool_constant<is_contiguous_iterator<It>::value
+                  && is_simd_aliasable<typename remove_const<
+                       typename iterator_traits<It>::value_type>::type
+                     >::value>
+{};
+
+/*
+ * The kernel type of It's elements : same size, unsigned for
+ * find / count / fill / accumulate (only the bits matter), same
+ * signedness for min / max.
+ */
+template < class It >
+struct simd_view {
+  typedef typename remove_const<
+    typename iterator_traits<It>::value_type>::type            value_type;
+  typedef typename simd_integer<sizeof(value_type), false>::type bits;
+  typedef typename simd_integer<sizeof(value_type),
+    is_signed_integer<value_type>::value>::type                 ordered;
+};
+
+template < class It >
+inline const typename simd_view<It>::bits* simd_bits( It it ) {
+  typedef typename simd_view<It>::bits Bits;
+  // unqualified : to_address of ft iterators is found by ADL
+  return reinterpret_cast<const Bits*>(to_address(it));
+}
+
+/*
+ * value can only compare equal to an element if it survives the trip
+ * through the element type : -1 is no unsigned char, 300 no char.
+ */
+template < class V, class T >
+inline bool representable( const T& value ) {
+  return T(V(value)) == value;
+}
+
+/* find
+ * https://en.cppreference.com/w/cpp/algorithm/find
+ *
+ * First element equal to value, or last.
+ */
+template< class InputIt, class T >
+InputIt find_dispatch( InputIt first, InputIt last, const T& value,
+                       false_type )
+{
+  while (first != last && !(*first == value)) {
+    ++first;
+  }
+  return first;
+}
+
+template< class It, class T >
+It find_dispatch( It first, It last, const T& value, true_type )
+{
+  typedef typename simd_view<It>::value_type V;
+  typedef typename simd_view<It>::bits       Bits;
+  if (first == last || !representable<V>(value)) {
+    return last;
+  }
+  return first + ft::simd_find(simd_bits(first), last - first,
+                               Bits(V(value)));
+}
+
+template< class InputIt, class T >
+InputIt find( InputIt first, InputIt last, const T& value )
+{
+  typedef bool_constant<is_simd_range<InputIt>::value
+                        && is_integral<T>::value> Simd;
+  return find_dispatch(first, last, value, Simd());
+}
+
+/* count
+ * https://en.cppreference.com/w/cpp/algorithm/count
+ */
+template< class InputIt, class T >
+typename iterator_traits<InputIt>::difference_type
+    count_dispatch( InputIt first, InputIt last, const T& value,
+                    false_type )
+{
+  typename iterator_traits<InputIt>::difference_type result = 0;
+  for (; first != last; ++first) {
+    if (*first == value) {
+      ++result;
+    }
+  }
+  return result;
+}
+
+template< class It, class T >
+typename iterator_traits<It>::difference_type
+    count_dispatch( It first, It last, const T& value, true_type )
+{
+  typedef typename simd_view<It>::value_type V;
+  typedef typename simd_view<It>::bits       Bits;
+  if (first == last || !representable<V>(value)) {
+    return 0;
+  }
+  return ft::simd_count(simd_bits(first), last - first, Bits(V(value)));
+}
+
+template< class InputIt, class T >
+typename iterator_traits<InputIt>::difference_type
+    count( InputIt first, InputIt last, const T& value )
+{
+  typedef bool_constant<is_simd_range<InputIt>::value
+                        && is_integral<T>::value> Simd;
+  return count_dispatch(first, last, value, Simd());
+}
+
+/* fill
+ * https://en.cppreference.com/w/cpp/algorithm/fill
+ */
+template< class ForwardIt, class T >
+void fill_dispatch( ForwardIt first, ForwardIt last, const T& value,
+                    false_type )
+{
+  for (; first != last; ++first) {
+    *first = value;
+  }
+}
+
+template< class It, class T >
+void fill_dispatch( It first, It last, const T& value, true_type )
+{
+  typedef typename simd_view<It>::value_type V;
+  typedef typename simd_view<It>::bits       Bits;
+  if (first == last) {
+    return ;
+  }
+  Bits bits = Bits(V(value));
+  Bits* dest = const_cast<Bits*>(simd_bits(first));
+  if (sizeof(V) == 1) {
+    std::memset(dest, bits, last - first);
+  } else {
+    ft::simd_fill(dest, last - first, bits);
+  }
+}
+
+template< class ForwardIt, class T >
+void fill( ForwardIt first, ForwardIt last, const T& value )
+{
+  typedef is_simd_range<ForwardIt> Simd;
+  fill_dispatch(first, last, value, Simd());
+}
+
+/* copy
+ * https://en.cppreference.com/w/cpp/algorithm/copy
+ *
+ * d_first must not be in [first, last).
+ */
+template< class InputIt, class OutputIt >
+OutputIt copy_dispatch( InputIt first, InputIt last, OutputIt d_first,
+                        false_type )
+{
+  for (; first != last; ++first, ++d_first) {
+    *d_first = *first;
+  }
+  return d_first;
+}
+
+template< class It, class OutputIt >
+OutputIt copy_dispatch( It first, It last, OutputIt d_first, true_type )
+{
+  std::size_t count = last - first;
+  if (count) {
+    std::memmove(to_address(d_first), to_address(first),
+                 count * sizeof(*first));
+  }
+  return d_first + count;
+}
+
+/* Both contiguous, same trivially copyable element. */
+template < class InputIt, class OutputIt >
+struct is_memmove_copyable
+  : bool_constant<is_contiguous_iterator<InputIt>::value
+                  && is_contiguous_iterator<OutputIt>::value
+                  && is_same_exact<
+                       typename remove_const<typename
+                         iterator_traits<InputIt>::value_type>::type,
+                       typename iterator_traits<OutputIt>::value_type
+                     >::value
+                  && is_trivially_copyable<typename
+                       iterator_traits<OutputIt>::value_type>::value>
+{};
+
+template< class InputIt, class OutputIt >
+OutputIt copy( InputIt first, InputIt last, OutputIt d_first )
+{
+  typedef is_memmove_copyable<InputIt, OutputIt> Bulk;
+  return copy_dispatch(first, last, d_first, Bulk());
+}
+
+/* min_element / max_element
+ * https://en.cppreference.com/w/cpp/algorithm/min_element
+ * https://en.cppreference.com/w/cpp/algorithm/max_element
+ *
+ * The first smallest (largest) element, or last if the range is
+ * empty. The fast path finds the value with the kernel, then its
+ * first position with simd_find.
+ */
+template< bool Max, class ForwardIt >
+ForwardIt extremum_dispatch( ForwardIt first, ForwardIt last, false_type )
+{
+  if (first == last) {
+    return last;
+  }
+  ForwardIt best = first;
+  while (++first != last) {
+    if (Max ? *best < *first : *first < *best) {
+      best = first;
+    }
+  }
+  return best;
+}
+
+template< bool Max, class It >
+It extremum_dispatch( It first, It last, true_type )
+{
+  typedef typename simd_view<It>::ordered Ordered;
+  typedef typename simd_view<It>::bits    Bits;
+  if (first == last) {
+    return last;
+  }
+  std::size_t count = last - first;
+  Ordered best = ft::simd_extremum_value<Max>(
+    reinterpret_cast<const Ordered*>(to_address(first)), count);
+  return first + ft::simd_find(simd_bits(first), count, Bits(best));
+}
+
+template< class ForwardIt >
+ForwardIt min_element( ForwardIt first, ForwardIt last )
+{
+  typedef is_simd_range<ForwardIt> Simd;
+  return extremum_dispatch<false>(first, last, Simd());
+}
+
+template< class ForwardIt, class Compare >
+ForwardIt min_element( ForwardIt first, ForwardIt last, Compare comp )
+{
+  if (first == last) {
+    return last;
+  }
+  ForwardIt best = first;
+  while (++first != last) {
+    if (comp(*first, *best)) {
+      best = first;
+    }
+  }
+  return best;
+}
+
+template< class ForwardIt >
+ForwardIt max_element( ForwardIt first, ForwardIt last )
+{
+  typedef is_simd_range<ForwardIt> Simd;
+  return extremum_dispatch<true>(first, last, Simd());
+}
+
+template< class ForwardIt, class Compare >
+ForwardIt max_element( ForwardIt first, ForwardIt last, Compare comp )
+{
+  if (first == last) {
+    return last;
+  }
+  ForwardIt best = first;
+  while (++first != last) {
+    if (comp(*best, *first)) {
+      best = first;
+    }
+  }
+  return best;
+}
+
+/* accumulate
+ * https://en.cppreference.com/w/cpp/algorithm/accumulate
+ *
+ * init + *first + ... in the type of init. The fast path needs init
+ * to be of the element type (then the sum wraps the same way in any
+ * order), bool excepted since it saturates instead.
+ */
+template< class InputIt, class T >
+T accumulate_dispatch( InputIt first, InputIt last, T init, false_type )
+{
+  for (; first != last; ++first) {
+    init = init + *first;
+  }
+  return init;
+}
+
+template< class It, class T >
+T accumulate_dispatch( It first, It last, T init, true_type )
+{
+  typedef typename simd_view<It>::bits Bits;
+  Bits sum = ft::simd_sum(simd_bits(first), last - first);
+  return T(Bits(sum + Bits(init)));
+}
+
+template< class InputIt, class T >
+T accumulate( InputIt first, InputIt last, T init )
+{
+  typedef typename remove_const<
+    typename iterator_traits<InputIt>::value_type>::type V;
+  typedef bool_constant<is_simd_range<InputIt>::value
+                        && is_same_exact<T, V>::value
+                        && !is_same_exact<V, bool>::value> Simd;
+  return accumulate_dispatch(first, last, init, Simd());
+}
+
+template< class InputIt, class T, class BinaryOperation >
+T accumulate( InputIt first, InputIt last, T init, BinaryOperation op )
+{
+  for (; first != last; ++first) {
+    init = op(init, *first);
+  }
+  return init;
+}
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_ALGORITHM_HPP */
@@ -0,0 +1,237 @@
+#ifndef FT_CONTAINERS_CONCURRENT_STACK_HPP
+# define FT_CONTAINERS_CONCURRENT_STACK_HPP
+#pragma once
+
+#include <memory> /* std::allocator */
+#include <cstddef> /* std::size_t */
+#include <stdint.h> /* uint32_t, uint64_t */
+#include <stdexcept>
+
+#include "ft/utils/utils.hpp"
+#include "ft/utils/atomic.hpp"
+
+/*
+ * Lock-free LIFO for many producers and many consumers, a Treiber
+ * stack. See :
+ * https://en.wikipedia.org/wiki/Treiber_stack
+ * https://en.wikipedia.org/wiki/ABA_problem
+ *
+ * Every element lives in a node of a pool allocated once by the
+ * constructor, so push / pop never call the allocator : capacity()
+ * is fixed and push on a full stack returns false.
+ *
+ * Nodes are linked by their index in the pool, and a list head is a
+ * 64 bit word, index in the low half, a tag in the high half :
+ *
+ *    head = [ tag : 32 | index : 32 ]
+ *
+ * Two lists share the pool, the stack itself and the free nodes.
+ * Each successful compare_exchange on a head bumps its tag, which is
+ * what defeats ABA : a pop that read head = A then next = B can not
+ * succeed if, meanwhile, A was popped, reused and pushed back, since
+ * the head is then A with another tag. The pool is never freed while
+ * the stack lives, so reading the next link of a node that was just
+ * taken by another thread is harmless (the CAS then fails).
+ *
+ * T's copy (or move) assignment is used by pop, elements are
+ * constructed and destroyed in place.
+ */
+
+namespace ft {
+
+template < class T, class Allocator = std::allocator<T> >
+class concurrent_stack {
+
+  public:
+  typedef T                                            value_type;
+  typedef Allocator                                    allocator_type;
+  typedef std::size_t                                  size_type;
+  typedef typename Allocator::pointer                  pointer;
+
+  private:
+
+  typedef uint32_t                                     index_type;
+  typedef uint64_t                                     tagged_index;
+  typedef ft::atomic<index_type>                       link;
+  typedef typename Allocator::template rebind<link>::other
+                                                       link_allocator;
+
+  static const index_type null_index = 0xffffffffu;
+
+  allocator_type  _alloc;
+  link_allocator  _link_alloc;
+  pointer         _values;    // element of node i
+  link*           _next;      // next node of node i, in either list
+  size_type       _capacity;
+
+  /* Both heads are hammered by every thread, each gets its own line. */
+  ft::cache_padded<ft::atomic<tagged_index> > _head;
+  ft::cache_padded<ft::atomic<tagged_index> > _free;
+
+  concurrent_stack( const concurrent_stack& );            // not copyable
+  concurrent_stack& operator=( const concurrent_stack& );
+
+  static tagged_index pack( index_type index, uint32_t tag ) {
+    return (tagged_index(tag) << 32) | index;
+  }
+
+  static index_type index_of( tagged_index head ) {
+    return index_type(head);
+  }
+
+  static uint32_t tag_of( tagged_index head ) {
+    return uint32_t(head >> 32);
+  }
+
+  /*
+   * Unlinks the first node of list, or returns null_index if it is
+   * empty. acquire : the node's value written before it was pushed
+   * is visible after this.
+   */
+  index_type pop_node( ft::atomic<tagged_index>& list ) {
+    tagged_index head = list.load(ft::memory_order_acquire);
+    for (;;) {
+      index_type node = index_of(head);
+      if (node == null_index) {
+        return null_index;
+      }
+      index_type next = _next[node].load(ft::memory_order_relaxed);
+      if (list.compare_exchange_weak(head, pack(next, tag_of(head) + 1),
+                                     ft::memory_order_acquire,
+                                     ft::memory_order_acquire))
+      {
+        return node;
+      }
+    }
+  }
+
+  /* Links node in front of list. release : publishes its value. */
+  void push_node( ft::atomic<tagged_index>& list, index_type node ) {
+    tagged_index head = list.load(ft::memory_order_relaxed);
+    for (;;) {
+      _next[node].store(index_of(head), ft::memory_order_relaxed);
+      if (list.compare_exchange_weak(head, pack(node, tag_of(head) + 1),
+                                     ft::memory_order_release,
+                                     ft::memory_order_relaxed))
+      {
+        return;
+      }
+    }
+  }
+
+  public:
+
+  /* Allocates the whole pool, capacity nodes. */
+  explicit concurrent_stack( size_type capacity,
+                             const Allocator& alloc = Allocator() )
+  :
+    _alloc(alloc),
+    _link_alloc(alloc),
+    _values(0),
+    _next(0),
+    _capacity(capacity),
+    _head(pack(null_index, 0)),
+    _free(pack(capacity ? 0 : null_index, 0))
+  {
+    if (capacity >= null_index || capacity > _alloc.max_size()) {
+      throw std::length_error("ft::concurrent_stack");
+    }
+    _values = _alloc.allocate(capacity ? capacity : 1);
+    try {
+      _next = _link_alloc.allocate(capacity ? capacity : 1);
+    } catch (...) {
+      _alloc.deallocate(_values, capacity ? capacity : 1);
+      throw;
+    }
+    for (size_type i = 0; i < capacity; ++i) {
+      ::new (static_cast<void*>(_next + i)) link(
+        i + 1 < capacity ? index_type(i + 1) : null_index);
+    }
+  }
+
+  /* Not thread safe, nobody else may use the stack anymore. */
+  ~concurrent_stack() {
+    index_type node = index_of(_head.value.load(ft::memory_order_acquire));
+    while (node != null_index) {
+      _alloc.destroy(_values + node);
+      node = _next[node].load(ft::memory_order_relaxed);
+    }
+    for (size_type i = 0; i < _capacity; ++i) {
+      _next[i].~link();
+    }
+    _link_alloc.deallocate(_next, _capacity ? _capacity : 1);
+    _alloc.deallocate(_values, _capacity ? _capacity : 1);
+  }
+
+  allocator_type get_allocator() const {
+    return _alloc;
+  }
+
+  size_type capacity() const {
+    return _capacity;
+  }
+
+  /* A snapshot, it may be stale by the time it is read. */
+  bool empty() const {
+    return index_of(_head.value.load(ft::memory_order_acquire)) == null_index;
+  }
+
+  /* Pushes a copy of value, or returns false if the pool is used up. */
+  bool push( const T& value ) {
+    index_type node = pop_node(_free.value);
+    if (node == null_index) {
+      return false;
+    }
+    try {
+      _alloc.construct(_values + node, value);
+    } catch (...) {
+      push_node(_free.value, node);
+      throw;
+    }
+    push_node(_head.value, node);
+    return true;
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  bool push( T&& value ) {
+    index_type node = pop_node(_free.value);
+    if (node == null_index) {
+      return false;
+    }
+    try {
+      _alloc.construct(_values + node, std::move(value));
+    } catch (...) {
+      push_node(_free.value, node);
+      throw;
+    }
+    push_node(_head.value, node);
+    return true;
+  }
+#endif
+
+  /*
+   * Moves the top element to out and removes it, or returns false if
+   * the stack is empty. There is no top() : with other threads
+   * popping, the element could be gone before it is read.
+   */
+  bool pop( T& out ) {
+    index_type node = pop_node(_head.value);
+    if (node == null_index) {
+      return false;
+    }
+    try {
+      out = FT_MOVE(_values[node]);
+    } catch (...) {
+      push_node(_head.value, node);
+      throw;
+    }
+    _alloc.destroy(_values + node);
+    push_node(_free.value, node);
+    return true;
+  }
+
+}; /* class concurrent_stack */
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_CONCURRENT_STACK_HPP */
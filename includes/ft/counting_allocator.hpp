@@ -0,0 +1,159 @@
+#ifndef FT_CONTAINERS_COUNTING_ALLOCATOR_HPP
+# define FT_CONTAINERS_COUNTING_ALLOCATOR_HPP
+#pragma once
+
+#include <memory> /* std::allocator */
+#include <cstddef> /* std::size_t, std::ptrdiff_t */
+
+/*
+ * An allocator that forwards to Base and counts what goes through it :
+ *
+ *    typedef ft::counting_allocator< ft::pair<const int, int> > counting;
+ *    ft::allocation_stats stats;
+ *    ft::map<int, int, std::less<int>, counting>
+ *        m((std::less<int>()), counting(stats));
+ *    m[1] = 1;   // stats.allocations == 2 : the sentinel and a node
+ *
+ * Every copy and every rebind of an allocator writes to the same
+ * allocation_stats, so the node allocator a map rebinds to still
+ * counts into the stats the map was given. A default constructed
+ * counting_allocator counts into ft::default_allocation_stats(),
+ * which is what a container built without an allocator argument
+ * gets.
+ *
+ * The counters are plain integers : one allocation_stats per thread.
+ */
+
+namespace ft {
+
+struct allocation_stats {
+  std::size_t allocations;
+  std::size_t deallocations;
+  std::size_t bytes_allocated;
+  std::size_t bytes_deallocated;
+  std::size_t live_bytes;
+  std::size_t peak_bytes;   // highest live_bytes
+
+  allocation_stats()
+  :
+    allocations(0),
+    deallocations(0),
+    bytes_allocated(0),
+    bytes_deallocated(0),
+    live_bytes(0),
+    peak_bytes(0)
+  {}
+
+  std::size_t live_allocations() const {
+    return allocations - deallocations;
+  }
+
+  void on_allocate( std::size_t bytes ) {
+    allocations++;
+    bytes_allocated += bytes;
+    live_bytes += bytes;
+    if (live_bytes > peak_bytes) {
+      peak_bytes = live_bytes;
+    }
+  }
+
+  void on_deallocate( std::size_t bytes ) {
+    deallocations++;
+    bytes_deallocated += bytes;
+    live_bytes -= bytes;
+  }
+};
+
+inline allocation_stats& default_allocation_stats() {
+  static allocation_stats stats;
+  return stats;
+}
+
+template < class T, class Base = std::allocator<T> >
+class counting_allocator {
+
+  public:
+  typedef Base                                    base_allocator;
+  typedef typename Base::value_type               value_type;
+  typedef typename Base::pointer                  pointer;
+  typedef typename Base::const_pointer            const_pointer;
+  typedef typename Base::reference                reference;
+  typedef typename Base::const_reference          const_reference;
+  typedef typename Base::size_type                size_type;
+  typedef typename Base::difference_type          difference_type;
+
+  template < class U >
+  struct rebind {
+    typedef counting_allocator<U,
+              typename Base::template rebind<U>::other>  other;
+  };
+
+  private:
+
+  Base              _base;
+  allocation_stats* _stats;
+
+  public:
+
+  counting_allocator() : _base(), _stats(&default_allocation_stats()) {}
+
+  explicit counting_allocator( allocation_stats& stats,
+                               const Base& base = Base() )
+  :
+    _base(base),
+    _stats(&stats)
+  {}
+
+  template < class U, class B >
+  counting_allocator( const counting_allocator<U, B>& other )
+  :
+    _base(other.base()),
+    _stats(&other.stats())
+  {}
+
+  const Base& base() const { return _base; }
+  allocation_stats& stats() const { return *_stats; }
+
+  pointer address( reference x ) const { return _base.address(x); }
+  const_pointer address( const_reference x ) const {
+    return _base.address(x);
+  }
+
+  pointer allocate( size_type n, const void* = 0 ) {
+    pointer p = _base.allocate(n);
+    _stats->on_allocate(n * sizeof(value_type));
+    return p;
+  }
+
+  void deallocate( pointer p, size_type n ) {
+    _stats->on_deallocate(n * sizeof(value_type));
+    _base.deallocate(p, n);
+  }
+
+  size_type max_size() const { return _base.max_size(); }
+
+  void construct( pointer p, const value_type& value ) {
+    _base.construct(p, value);
+  }
+
+  void destroy( pointer p ) { _base.destroy(p); }
+};
+
+/* Equal when they count into the same stats : one frees what the other got. */
+template < class T1, class B1, class T2, class B2 >
+bool operator==( const counting_allocator<T1, B1>& x,
+                 const counting_allocator<T2, B2>& y )
+{
+  return &x.stats() == &y.stats();
+}
+
+template < class T1, class B1, class T2, class B2 >
+bool operator!=( const counting_allocator<T1, B1>& x,
+                 const counting_allocator<T2, B2>& y )
+{
+  return !(x == y);
+}
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_COUNTING_ALLOCATOR_HPP */
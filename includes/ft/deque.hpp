@@ -0,0 +1,736 @@
+#ifndef FT_CONTAINERS_DEQUE_HPP
+# define FT_CONTAINERS_DEQUE_HPP
+#pragma once
+
+#include <memory> /* std::allocator */
+#include <cstddef> /* std::size_t, std::ptrdiff_t */
+#include <cstring> /* memmove */
+#include <stdexcept>
+
+#include "ft/utils/utils.hpp"
+#include "ft/utils/deque_iterator.hpp"
+#include "ft/utils/reverse_iterator.hpp"
+
+/*
+ * See :
+ * https://en.cppreference.com/w/cpp/container/deque
+ *
+ * A segmented vector : elements are stored in fixed-size blocks
+ * (see deque_block) and the blocks are reached through the map, an
+ * array of block pointers. Growing at either end either fills the
+ * current edge block or adds a new one, existing elements never
+ * move. So, unlike ft::vector :
+ *  - push_back / push_front are O(1), not amortized O(1) : there is
+ *    no "copy everything" step, the worst case is one block
+ *    allocation plus, rarely, moving the map (a few pointers).
+ *  - references and pointers to elements stay valid across any
+ *    push / pop at the ends (iterators do not, like std::deque).
+ *
+ * Layout : the element at position i lives at the absolute index
+ * _offset + i of the map, see deque_iterator. Live elements occupy
+ * [_offset, _offset + _size). Blocks outside that range are freed
+ * as soon as they empty, except for one spare block kept around so
+ * a push / pop oscillation across a block boundary never hits the
+ * allocator.
+ */
+
+namespace ft {
+
+template < class T, class Allocator = std::allocator<T> >
+class deque {
+
+  public:
+  typedef T                                            value_type;
+  typedef Allocator                                    allocator_type;
+  typedef std::size_t                                  size_type;
+  typedef std::ptrdiff_t                               difference_type;
+  typedef typename Allocator::reference                reference;
+  typedef typename Allocator::const_reference          const_reference;
+  typedef typename Allocator::pointer                  pointer;
+  typedef typename Allocator::const_pointer            const_pointer;
+
+  typedef ft::deque_iterator<T, T>                     iterator;
+  typedef ft::deque_iterator<T, const T>               const_iterator;
+  typedef ft::reverse_iterator<iterator>               reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator>         const_reverse_iterator;
+
+  private:
+
+  typedef typename Allocator::
+          template rebind<pointer>::other              map_allocator;
+  typedef ft::deque_block<T>                           block;
+  typedef typename ft::is_trivially_copyable<T>        Relocatable;
+
+  allocator_type _alloc;
+  map_allocator  _map_alloc;
+  pointer*       _map;      // block pointers, null when not allocated
+  size_type      _map_cap;  // slots in _map
+  size_type      _offset;   // absolute index of the first element
+  size_type      _size;
+  pointer        _spare;    // one cached empty block, or null
+
+  pointer slot( size_type index ) const {
+    return _map[index >> block::shift] + (index & block::mask);
+  }
+
+  pointer get_block() {
+    if (_spare) {
+      pointer b = _spare;
+      _spare = 0;
+      return b;
+    }
+    return _alloc.allocate(block::size);
+  }
+
+  void release_block( size_type b ) {
+    if (!_spare) {
+      _spare = _map[b];
+    } else {
+      _alloc.deallocate(_map[b], block::size);
+    }
+    _map[b] = 0;
+  }
+
+  size_type first_block() const {
+    return _offset >> block::shift;
+  }
+
+  size_type used_blocks() const {
+    if (!_size) {
+      return 0;
+    }
+    return ((_offset + _size - 1) >> block::shift) - first_block() + 1;
+  }
+
+  /*
+   * Moves the live block pointers to the middle of a map of new_cap
+   * slots (the same one if new_cap == _map_cap). Blocks outside the
+   * live range (only left behind by a throwing constructor) are
+   * released first. Elements do not move.
+   */
+  void relocate_map( size_type new_cap ) {
+    size_type first = first_block();
+    size_type used = used_blocks();
+    for (size_type b = 0; b < _map_cap; ++b) {
+      if (_map[b] && (b < first || b >= first + used)) {
+        release_block(b);
+      }
+    }
+    size_type new_first = (new_cap - used) / 2;
+    if (new_cap != _map_cap) {
+      pointer* new_map = _map_alloc.allocate(new_cap);
+      for (size_type b = 0; b < new_cap; ++b) {
+        new_map[b] = 0;
+      }
+      for (size_type b = 0; b < used; ++b) {
+        new_map[new_first + b] = _map[first + b];
+      }
+      if (_map) {
+        _map_alloc.deallocate(_map, _map_cap);
+      }
+      _map = new_map;
+      _map_cap = new_cap;
+    } else if (new_first != first) {
+      memmove(_map + new_first, _map + first, used * sizeof(pointer));
+      for (size_type b = 0; b < new_first; ++b) {
+        _map[b] = 0;
+      }
+      for (size_type b = new_first + used; b < _map_cap; ++b) {
+        _map[b] = 0;
+      }
+    }
+    _offset = (new_first << block::shift) + (_offset & block::mask);
+  }
+
+  /*
+   * Called when an end of the map is reached. Recenters the blocks
+   * if the map is at most half full, else doubles it. Either way
+   * there is a free slot at both ends afterwards, and a quarter of
+   * the map is free on each side, so this is amortized O(1).
+   */
+  void make_room() {
+    size_type new_cap = _map_cap;
+    if (used_blocks() + 2 > _map_cap / 2) {
+      new_cap = _map_cap ? _map_cap * 2 : 8;
+    }
+    relocate_map(new_cap);
+  }
+
+  /* An empty deque restarts from the middle of its map. */
+  void recenter() {
+    _offset = (_map_cap / 2) << block::shift;
+  }
+
+  void destroy_elements( false_type ) {
+    for (size_type i = 0; i < _size; ++i) {
+      _alloc.destroy(slot(_offset + i));
+    }
+  }
+
+  void destroy_elements( true_type ) {}
+
+  template <typename InputIt>
+  void constructor_dispatch( InputIt first, InputIt last, false_type ) {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  template <typename InputIt>
+  void constructor_dispatch( InputIt first, InputIt last, true_type ) {
+    assign((size_type)first, last);
+  }
+
+  template <typename InputIt>
+  void assign_dispatch( InputIt first, InputIt last, false_type ) {
+    clear();
+    constructor_dispatch(first, last, false_type());
+  }
+
+  template <typename InputIt>
+  void assign_dispatch( InputIt first, InputIt last, true_type ) {
+    assign((size_type)first, last);
+  }
+
+  /*
+   * Reverses [first, last) in place, the building block of the
+   * rotations used by insert.
+   */
+  void reverse( size_type first, size_type last ) {
+    while (first + 1 < last) {
+      ft::swap((*this)[first++], (*this)[--last]);
+    }
+  }
+
+  template <typename InputIt>
+  iterator insert_dispatch( const_iterator pos, InputIt first,
+                            InputIt last, false_type )
+  {
+    size_type index = pos - begin();
+    size_type old_size = _size;
+    constructor_dispatch(first, last, false_type());
+    // rotate [index, old_size) behind the new elements
+    reverse(index, old_size);
+    reverse(old_size, _size);
+    reverse(index, _size);
+    return begin() + index;
+  }
+
+  template <typename InputIt>
+  iterator insert_dispatch( const_iterator pos, InputIt first,
+                            InputIt last, true_type )
+  {
+    return insert(pos, (size_type)first, last);
+  }
+
+  public:
+
+  deque()
+  :
+    _alloc(),
+    _map_alloc(),
+    _map(0),
+    _map_cap(0),
+    _offset(0),
+    _size(0),
+    _spare(0)
+  {}
+
+  explicit deque( size_type count, const T& value = T(),
+                  const Allocator& alloc = Allocator() )
+  :
+    _alloc(alloc),
+    _map_alloc(alloc),
+    _map(0),
+    _map_cap(0),
+    _offset(0),
+    _size(0),
+    _spare(0)
+  {
+    assign(count, value);
+  }
+
+  template< class InputIt >
+  deque( InputIt first, InputIt last,
+         const Allocator& alloc = Allocator() )
+  :
+    _alloc(alloc),
+    _map_alloc(alloc),
+    _map(0),
+    _map_cap(0),
+    _offset(0),
+    _size(0),
+    _spare(0)
+  {
+    typedef typename ft::is_integer<InputIt> Integer;
+    constructor_dispatch(first, last, Integer());
+  }
+
+  deque( const deque& other )
+  :
+    _alloc(other._alloc),
+    _map_alloc(other._map_alloc),
+    _map(0),
+    _map_cap(0),
+    _offset(0),
+    _size(0),
+    _spare(0)
+  {
+    constructor_dispatch(other.begin(), other.end(), false_type());
+  }
+
+  ~deque() {
+    clear();
+    if (_spare) {
+      _alloc.deallocate(_spare, block::size);
+    }
+    if (_map) {
+      _map_alloc.deallocate(_map, _map_cap);
+    }
+  }
+
+  /*
+   * Assigns over the elements already here, then pushes or pops the
+   * difference : blocks are reused.
+   */
+  deque& operator=( const deque& other ) {
+    if (this == &other) {
+      return *this;
+    }
+    size_type common = _size < other._size ? _size : other._size;
+    for (size_type i = 0; i < common; ++i) {
+      (*this)[i] = other[i];
+    }
+    while (_size > other._size) {
+      pop_back();
+    }
+    for (size_type i = common; i < other._size; ++i) {
+      push_back(other[i]);
+    }
+    return *this;
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  deque( deque&& other ) noexcept
+  :
+    _alloc(std::move(other._alloc)),
+    _map_alloc(std::move(other._map_alloc)),
+    _map(other._map),
+    _map_cap(other._map_cap),
+    _offset(other._offset),
+    _size(other._size),
+    _spare(other._spare)
+  {
+    other._map = 0;
+    other._map_cap = 0;
+    other._offset = 0;
+    other._size = 0;
+    other._spare = 0;
+  }
+
+  deque& operator=( deque&& other ) noexcept {
+    if (this != &other) {
+      swap(other);
+      other.clear();
+    }
+    return *this;
+  }
+#endif
+
+  void assign( size_type count, const T& value ) {
+    clear();
+    while (count--) {
+      push_back(value);
+    }
+  }
+
+  template< class InputIt >
+  void assign( InputIt first, InputIt last ) {
+    typedef typename ft::is_integer<InputIt> Integer;
+    assign_dispatch(first, last, Integer());
+  }
+
+  allocator_type get_allocator() const {
+    return _alloc;
+  }
+
+  /* ------------------------------------------
+   * Element access
+   */
+
+  reference at( size_type pos ) {
+    if (!(pos < _size)) {
+      throw std::out_of_range("ft::deque::at( size_type )");
+    }
+    return *slot(_offset + pos);
+  }
+
+  const_reference at( size_type pos ) const {
+    if (!(pos < _size)) {
+      throw std::out_of_range("ft::deque::at( size_type ) const");
+    }
+    return *slot(_offset + pos);
+  }
+
+  reference operator[]( size_type pos ) {
+    return *slot(_offset + pos);
+  }
+
+  const_reference operator[]( size_type pos ) const {
+    return *slot(_offset + pos);
+  }
+
+  reference front() {
+    return *slot(_offset);
+  }
+
+  const_reference front() const {
+    return *slot(_offset);
+  }
+
+  reference back() {
+    return *slot(_offset + _size - 1);
+  }
+
+  const_reference back() const {
+    return *slot(_offset + _size - 1);
+  }
+
+  /* ------------------------------------------
+   * Iterators
+   */
+
+  iterator begin() {
+    return iterator(_map, _offset);
+  }
+
+  const_iterator begin() const {
+    return const_iterator(_map, _offset);
+  }
+
+  iterator end() {
+    return iterator(_map, _offset + _size);
+  }
+
+  const_iterator end() const {
+    return const_iterator(_map, _offset + _size);
+  }
+
+  reverse_iterator rbegin() {
+    return reverse_iterator(end());
+  }
+
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  /* ------------------------------------------
+   * Capacity
+   */
+
+  bool empty() const {
+    return _size == 0;
+  }
+
+  size_type size() const {
+    return _size;
+  }
+
+  size_type max_size() const {
+    return _alloc.max_size();
+  }
+
+  /*
+   * Gives back the spare block and trims the map down to the live
+   * blocks (plus a free slot at each end). An empty deque releases
+   * everything.
+   */
+  void shrink_to_fit() {
+    if (_spare) {
+      _alloc.deallocate(_spare, block::size);
+      _spare = 0;
+    }
+    if (!_size) {
+      if (_map) {
+        _map_alloc.deallocate(_map, _map_cap);
+      }
+      _map = 0;
+      _map_cap = 0;
+      _offset = 0;
+      return ;
+    }
+    size_type fit = used_blocks() + 2;
+    if (fit < _map_cap) {
+      relocate_map(fit);
+    }
+    if (_spare) { // relocate_map may have released a stray block
+      _alloc.deallocate(_spare, block::size);
+      _spare = 0;
+    }
+  }
+
+  /* ------------------------------------------
+   * Modifiers
+   */
+
+  void clear() {
+    destroy_elements(Relocatable());
+    for (size_type b = 0; b < _map_cap; ++b) {
+      if (_map[b]) {
+        release_block(b);
+      }
+    }
+    _size = 0;
+    recenter();
+  }
+
+  void push_back( const T& value ) {
+    if (((_offset + _size) >> block::shift) >= _map_cap) {
+      make_room();
+    }
+    size_type index = _offset + _size;
+    pointer& b = _map[index >> block::shift];
+    if (!b) {
+      b = get_block();
+    }
+    _alloc.construct(b + (index & block::mask), value);
+    ++_size;
+  }
+
+  void push_front( const T& value ) {
+    if (_offset == 0) {
+      make_room();
+    }
+    size_type index = _offset - 1;
+    pointer& b = _map[index >> block::shift];
+    if (!b) {
+      b = get_block();
+    }
+    _alloc.construct(b + (index & block::mask), value);
+    --_offset;
+    ++_size;
+  }
+
+  void pop_back() {
+    size_type index = _offset + _size - 1;
+    _alloc.destroy(slot(index));
+    --_size;
+    if ((index & block::mask) == 0 || _size == 0) {
+      release_block(index >> block::shift);
+    }
+    if (_size == 0) {
+      recenter();
+    }
+  }
+
+  void pop_front() {
+    size_type index = _offset;
+    _alloc.destroy(slot(index));
+    ++_offset;
+    --_size;
+    if ((_offset & block::mask) == 0 || _size == 0) {
+      release_block(index >> block::shift);
+    }
+    if (_size == 0) {
+      recenter();
+    }
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  void push_back( T&& value ) {
+    emplace_back(std::move(value));
+  }
+
+  void push_front( T&& value ) {
+    emplace_front(std::move(value));
+  }
+
+  template< class... Args >
+  reference emplace_back( Args&&... args ) {
+    typedef std::allocator_traits<Allocator> alloc_traits;
+    if (((_offset + _size) >> block::shift) >= _map_cap) {
+      make_room();
+    }
+    size_type index = _offset + _size;
+    pointer& b = _map[index >> block::shift];
+    if (!b) {
+      b = get_block();
+    }
+    alloc_traits::construct(_alloc, b + (index & block::mask),
+                            std::forward<Args>(args)...);
+    ++_size;
+    return back();
+  }
+
+  template< class... Args >
+  reference emplace_front( Args&&... args ) {
+    typedef std::allocator_traits<Allocator> alloc_traits;
+    if (_offset == 0) {
+      make_room();
+    }
+    size_type index = _offset - 1;
+    pointer& b = _map[index >> block::shift];
+    if (!b) {
+      b = get_block();
+    }
+    alloc_traits::construct(_alloc, b + (index & block::mask),
+                            std::forward<Args>(args)...);
+    --_offset;
+    ++_size;
+    return front();
+  }
+#endif
+
+  /*
+   * Inserts value before pos, pushing at the closer end and moving
+   * the elements in between by one : O(min(pos, size() - pos)).
+   */
+  iterator insert( const_iterator pos, const T& value ) {
+    size_type index = pos - begin();
+    if (index < _size / 2) {
+      push_front(value);
+      for (size_type i = 0; i < index; ++i) {
+        ft::swap((*this)[i], (*this)[i + 1]);
+      }
+    } else {
+      push_back(value);
+      for (size_type i = _size - 1; i > index; --i) {
+        ft::swap((*this)[i], (*this)[i - 1]);
+      }
+    }
+    return begin() + index;
+  }
+
+  iterator insert( const_iterator pos, size_type count, const T& value ) {
+    size_type index = pos - begin();
+    size_type old_size = _size;
+    while (count--) {
+      push_back(value);
+    }
+    reverse(index, old_size);
+    reverse(old_size, _size);
+    reverse(index, _size);
+    return begin() + index;
+  }
+
+  template< class InputIt >
+  iterator insert( const_iterator pos, InputIt first, InputIt last ) {
+    typedef typename ft::is_integer<InputIt> Integer;
+    return insert_dispatch(pos, first, last, Integer());
+  }
+
+  iterator erase( iterator pos ) {
+    return erase(pos, pos + 1);
+  }
+
+  /*
+   * The shorter side of the hole is moved over it, then the leftover
+   * elements are popped from that end.
+   */
+  iterator erase( iterator first, iterator last ) {
+    size_type index = first - begin();
+    size_type count = last - first;
+    if (!count) {
+      return first;
+    }
+    if (index < _size - (index + count)) {
+      for (size_type i = index; i > 0; --i) {
+        (*this)[i - 1 + count] = FT_MOVE((*this)[i - 1]);
+      }
+      while (count--) {
+        pop_front();
+      }
+    } else {
+      for (size_type i = index + count; i < _size; ++i) {
+        (*this)[i - count] = FT_MOVE((*this)[i]);
+      }
+      while (count--) {
+        pop_back();
+      }
+    }
+    return begin() + index;
+  }
+
+  void resize( size_type count, T value = T() ) {
+    while (_size > count) {
+      pop_back();
+    }
+    while (_size < count) {
+      push_back(value);
+    }
+  }
+
+  void swap( deque& other ) {
+    if (this != &other) {
+      ft::swap(_alloc, other._alloc);
+      ft::swap(_map_alloc, other._map_alloc);
+      ft::swap(_map, other._map);
+      ft::swap(_map_cap, other._map_cap);
+      ft::swap(_offset, other._offset);
+      ft::swap(_size, other._size);
+      ft::swap(_spare, other._spare);
+    }
+  }
+
+}; /* class deque */
+
+template< class T, class Alloc >
+bool operator==( const ft::deque<T,Alloc>& x,
+                 const ft::deque<T,Alloc>& y )
+{
+  return x.size() == y.size()
+         && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template< class T, class Alloc >
+bool operator!=( const ft::deque<T,Alloc>& x,
+                 const ft::deque<T,Alloc>& y )
+{
+  return !(x == y);
+}
+
+template< class T, class Alloc >
+bool operator<( const ft::deque<T,Alloc>& x,
+                const ft::deque<T,Alloc>& y )
+{
+  return ft::lexicographical_compare(x.begin(), x.end(),
+                                     y.begin(), y.end());
+}
+
+template< class T, class Alloc >
+bool operator<=( const ft::deque<T,Alloc>& x,
+                 const ft::deque<T,Alloc>& y )
+{
+  return !(y < x);
+}
+
+template< class T, class Alloc >
+bool operator>( const ft::deque<T,Alloc>& x,
+                const ft::deque<T,Alloc>& y )
+{
+  return y < x;
+}
+
+template< class T, class Alloc >
+bool operator>=( const ft::deque<T,Alloc>& x,
+                 const ft::deque<T,Alloc>& y )
+{
+  return !(x < y);
+}
+
+template< class T, class Alloc >
+void swap( ft::deque<T,Alloc>& x, ft::deque<T,Alloc>& y ) {
+  x.swap(y);
+}
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_DEQUE_HPP */
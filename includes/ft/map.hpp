@@ -33,6 +33,9 @@ class map {
     map_get_key<Key, value_type> get_key;
     key_compare           key_cmp;
 
+    ValueCompare( const key_compare& comp = key_compare() )
+    : key_cmp(comp) {}
+
     bool operator()(const value_type& x, const value_type& y) {
       return key_cmp(get_key(x), get_key(y));
     }
@@ -47,9 +50,9 @@ class map {
                   Allocator >                        tree_type;
   typedef typename tree_type::node_ptr               node_ptr;
 
+  // the allocator and comparator live in the tree, where they take
+  // no room when empty : a map is the size of its tree.
   tree_type      tree;
-  allocator_type allocator;
-  value_compare  value_cmp;
 
   public:
 
@@ -60,17 +63,13 @@ class map {
 
   map()
   :
-    tree(),
-    allocator(),
-    value_cmp()
+    tree()
   {}
 
   explicit map( const Compare& comp,
                 const Allocator& alloc = Allocator())
   :
-    tree(comp),
-    allocator(alloc),
-    value_cmp()
+    tree(comp, alloc)
   {}
 
   template< class InputIt >
@@ -83,32 +82,45 @@ class map {
                    value_type>::value,
                  value_type>::type* = 0 )
   :
-    tree(comp),
-    allocator(alloc),
-    value_cmp()
+    tree(comp, alloc)
   {
     insert(first, last);
   }
 
   map( const map& other )
   :
-    tree(other.tree),
-    allocator(other.allocator),
-    value_cmp(other.value_cmp)
+    tree(other.tree)
+  {}
+
+#ifdef FT_CONTAINERS_CXX11
+  map( map&& other ) noexcept
+  :
+    tree(std::move(other.tree))
   {}
 
+  map& operator=( map&& other ) noexcept {
+    tree = std::move(other.tree);
+    return *this;
+  }
+#endif
+
   ~map() {}
 
+  /*
+   * Copy and swap : the comparator (and allocator) come with the
+   * elements, as by the copy constructor, and *this is left untouched
+   * if a copy throws.
+   */
   map& operator=( const map& other ) {
     if (this != &other) {
-      clear();
-      insert(other.begin(), other.end());
+      tree_type copy(other.tree);
+      tree.swap(copy);
     }
     return *this;
   }
 
   allocator_type get_allocator() const {
-    return allocator;
+    return allocator_type(tree.get_node_allocator());
   }
 
   T& at( const Key& key ) {
@@ -128,6 +140,9 @@ class map {
   }
 
   T& operator[]( const Key& key ) {
+#ifdef FT_CONTAINERS_CXX11
+    return try_emplace(key).first->second;
+#else
     node_ptr n = tree.find(key);
     if (!n) {
       // tree.insert(pair).first == iterator
@@ -136,6 +151,7 @@ class map {
       return (*tree.insert(value_type(key, T())).first).second;
     }
     return n->data.second;
+#endif
   }
 
   inline iterator begin() {
@@ -208,15 +224,47 @@ class map {
     }
   }
 
+#ifdef FT_CONTAINERS_CXX11
+  ft::pair<iterator, bool> insert( value_type&& value ) {
+    return tree.emplace(std::move(value));
+  }
+
+  template< class... Args >
+  ft::pair<iterator, bool> emplace( Args&&... args ) {
+    return tree.emplace(std::forward<Args>(args)...);
+  }
+
+  template< class... Args >
+  iterator emplace_hint( const_iterator hint, Args&&... args ) {
+    return iterator(tree.emplace_hint(const_cast<node_ptr>(hint.base()),
+                                      std::forward<Args>(args)...),
+                    tree.get_node_end());
+  }
+
+  /*
+   * Unlike emplace, nothing is built if key is already there : args
+   * are left untouched (not moved from).
+   */
+  template< class... Args >
+  ft::pair<iterator, bool> try_emplace( const Key& key, Args&&... args ) {
+    node_ptr n = tree.find(key);
+    if (n) {
+      return ft::pair<iterator, bool>(iterator(n, tree.get_node_end()),
+                                      false);
+    }
+    return tree.emplace(key, T(std::forward<Args>(args)...));
+  }
+#endif
+
   void erase( iterator pos ) {
     if (pos != end()) {
       tree.erase((*pos).first);
     }
   }
 
-  // This does not invalidate iterators because we substitute
-  // for inorder PREDECESSOR and an rb_tree iterator always ends
-  // up with greater key values when incrementing.
+  // This does not invalidate iterators because erasing a node
+  // only relinks the others (see switch_with_inorder_predecessor),
+  // first is already past the erased one.
   void erase( iterator first, iterator last ) {
     while (first != last) {
       tree.erase((*first++).first);
@@ -231,7 +279,6 @@ class map {
   }
 
   void swap(map& other) {
-    ft::swap(allocator, other.allocator);
     tree.swap(other.tree);
   }
 
@@ -299,11 +346,11 @@ class map {
   }
 
   key_compare key_comp() const {
-    return tree.key_cmp;
+    return tree.key_comp();
   }
 
   value_compare value_comp() const {
-    return value_cmp;
+    return value_compare(tree.key_comp());
   }
   
 }; // class ft::map
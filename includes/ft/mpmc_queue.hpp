@@ -0,0 +1,204 @@
+#ifndef FT_CONTAINERS_MPMC_QUEUE_HPP
+# define FT_CONTAINERS_MPMC_QUEUE_HPP
+#pragma once
+
+#include <memory> /* std::allocator */
+#include <cstddef> /* std::size_t */
+#include <stdexcept>
+
+#include "ft/utils/utils.hpp"
+#include "ft/utils/atomic.hpp"
+
+/*
+ * Bounded lock-free FIFO for many producers and many consumers,
+ * Dmitry Vyukov's sequence-numbered ring. See :
+ * https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ * Like ft::ring_buffer, the slots are allocated once, the capacity is
+ * a power of two and positions are never wrapped, only masked. Each
+ * slot also carries a sequence number saying whose turn it is :
+ *
+ *    sequence == pos             free, the producer of pos may write
+ *    sequence == pos + 1         full, the consumer of pos may read
+ *    sequence == pos + capacity  free again, for the next lap
+ *
+ * A producer claims pos with one compare_exchange on _enqueue_pos,
+ * writes the slot, then publishes it by storing the sequence. The
+ * consumers do the same on _dequeue_pos. Producers and consumers
+ * only meet on the slot they hand over, never on a shared counter.
+ *
+ * Once a slot is claimed it has to be filled (or emptied), so T's copy
+ * (or move) constructor and assignment must not throw.
+ */
+
+namespace ft {
+
+template < class T, class Allocator = std::allocator<T> >
+class mpmc_queue {
+
+  public:
+  typedef T                                            value_type;
+  typedef Allocator                                    allocator_type;
+  typedef std::size_t                                  size_type;
+  typedef typename Allocator::pointer                  pointer;
+
+  private:
+
+  typedef ft::atomic<size_type>                        sequence;
+  typedef typename Allocator::template rebind<sequence>::other
+                                                       sequence_allocator;
+
+  allocator_type      _alloc;
+  sequence_allocator  _sequence_alloc;
+  pointer             _values;
+  sequence*           _sequence;
+  size_type           _mask;   // capacity() - 1
+
+  ft::cache_padded<sequence> _enqueue_pos;
+  ft::cache_padded<sequence> _dequeue_pos;
+
+  mpmc_queue( const mpmc_queue& );            // not copyable
+  mpmc_queue& operator=( const mpmc_queue& );
+
+  static size_type round_up_pow2( size_type n ) {
+    size_type p = 2;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+  /* Signed distance, positions are free to overflow. */
+  static std::ptrdiff_t diff( size_type a, size_type b ) {
+    return static_cast<std::ptrdiff_t>(a - b);
+  }
+
+  /*
+   * Claims the next position of counter whose slot sequence is
+   * pos + lag, or returns false if that slot is not ready yet
+   * (queue full for producers, empty for consumers).
+   */
+  bool claim( sequence& counter, size_type lag, size_type& pos ) {
+    pos = counter.load(ft::memory_order_relaxed);
+    for (;;) {
+      size_type seq = _sequence[pos & _mask].load(ft::memory_order_acquire);
+      std::ptrdiff_t d = diff(seq, pos + lag);
+      if (d == 0) {
+        if (counter.compare_exchange_weak(pos, pos + 1,
+                                          ft::memory_order_relaxed,
+                                          ft::memory_order_relaxed))
+        {
+          return true;
+        }
+      } else if (d < 0) {
+        return false;
+      } else {
+        pos = counter.load(ft::memory_order_relaxed);
+      }
+    }
+  }
+
+  public:
+
+  /* capacity() will be the next power of two >= capacity, at least 2. */
+  explicit mpmc_queue( size_type capacity,
+                       const Allocator& alloc = Allocator() )
+  :
+    _alloc(alloc),
+    _sequence_alloc(alloc),
+    _values(0),
+    _sequence(0),
+    _mask(0),
+    _enqueue_pos(0),
+    _dequeue_pos(0)
+  {
+    if (capacity > _alloc.max_size()) {
+      throw std::length_error("ft::mpmc_queue");
+    }
+    capacity = round_up_pow2(capacity);
+    _values = _alloc.allocate(capacity);
+    try {
+      _sequence = _sequence_alloc.allocate(capacity);
+    } catch (...) {
+      _alloc.deallocate(_values, capacity);
+      throw;
+    }
+    _mask = capacity - 1;
+    for (size_type i = 0; i < capacity; ++i) {
+      ::new (static_cast<void*>(_sequence + i)) sequence(i);
+    }
+  }
+
+  /* Not thread safe, nobody else may use the queue anymore. */
+  ~mpmc_queue() {
+    size_type pos = _dequeue_pos.value.load(ft::memory_order_acquire);
+    size_type end = _enqueue_pos.value.load(ft::memory_order_acquire);
+    for (; pos != end; ++pos) {
+      _alloc.destroy(_values + (pos & _mask));
+    }
+    for (size_type i = 0; i < capacity(); ++i) {
+      _sequence[i].~sequence();
+    }
+    _sequence_alloc.deallocate(_sequence, capacity());
+    _alloc.deallocate(_values, capacity());
+  }
+
+  allocator_type get_allocator() const {
+    return _alloc;
+  }
+
+  size_type capacity() const {
+    return _mask + 1;
+  }
+
+  /* A snapshot, it may be stale by the time it is read. */
+  size_type size_approx() const {
+    size_type tail = _enqueue_pos.value.load(ft::memory_order_relaxed);
+    size_type head = _dequeue_pos.value.load(ft::memory_order_relaxed);
+    return diff(tail, head) > 0 ? tail - head : 0;
+  }
+
+  /* Appends a copy of value, or returns false if the queue is full. */
+  bool push( const T& value ) {
+    size_type pos;
+    if (!claim(_enqueue_pos.value, 0, pos)) {
+      return false;
+    }
+    _alloc.construct(_values + (pos & _mask), value);
+    _sequence[pos & _mask].store(pos + 1, ft::memory_order_release);
+    return true;
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  bool push( T&& value ) {
+    size_type pos;
+    if (!claim(_enqueue_pos.value, 0, pos)) {
+      return false;
+    }
+    _alloc.construct(_values + (pos & _mask), std::move(value));
+    _sequence[pos & _mask].store(pos + 1, ft::memory_order_release);
+    return true;
+  }
+#endif
+
+  /*
+   * Moves the oldest element to out and removes it, or returns false
+   * if the queue is empty.
+   */
+  bool pop( T& out ) {
+    size_type pos;
+    if (!claim(_dequeue_pos.value, 1, pos)) {
+      return false;
+    }
+    pointer slot = _values + (pos & _mask);
+    out = FT_MOVE(*slot);
+    _alloc.destroy(slot);
+    _sequence[pos & _mask].store(pos + capacity(), ft::memory_order_release);
+    return true;
+  }
+
+}; /* class mpmc_queue */
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_MPMC_QUEUE_HPP */
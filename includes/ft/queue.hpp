@@ -0,0 +1,320 @@
+#ifndef FT_CONTAINERS_QUEUE_HPP
+# define FT_CONTAINERS_QUEUE_HPP
+#pragma once
+
+#include <functional> /* std::less */
+#include "ft/deque.hpp"
+#include "ft/vector.hpp"
+#include "ft/utils/heap.hpp"
+
+/*
+ * Container adaptors, siblings of ft::stack. See :
+ * https://en.cppreference.com/w/cpp/container/queue
+ * https://en.cppreference.com/w/cpp/container/priority_queue
+ *
+ * ft::queue is FIFO over ft::deque (push_back / pop_front, both
+ * O(1) with no relocation).
+ * ft::priority_queue keeps its container as a 4-ary heap (see
+ * ft/utils/heap.hpp) : push and pop are O(log n), building one from
+ * a range is a single O(n) make_heap.
+ */
+
+namespace ft {
+
+template < class T, class Container = ft::deque<T> >
+class queue {
+
+  public:
+  typedef Container                                    container_type;
+  typedef typename container_type::value_type          value_type;
+  typedef typename container_type::size_type           size_type;
+  typedef typename container_type::reference           reference;
+  typedef typename container_type::const_reference     const_reference;
+
+  protected:
+
+  container_type   c;
+
+  public:
+
+  explicit queue( const container_type& cont = container_type() )
+  :
+    c(cont)
+  {}
+
+  queue( const queue& other )
+  :
+    c(other.c)
+  {}
+
+  ~queue() {}
+
+  queue& operator=( const queue& other ) {
+    if (this != &other) {
+      c = other.c;
+    }
+    return (*this);
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  queue( queue&& other )
+  :
+    c(std::move(other.c))
+  {}
+
+  queue& operator=( queue&& other ) {
+    c = std::move(other.c);
+    return (*this);
+  }
+#endif
+
+  reference front() {
+    return c.front();
+  }
+
+  const_reference front() const {
+    return c.front();
+  }
+
+  reference back() {
+    return c.back();
+  }
+
+  const_reference back() const {
+    return c.back();
+  }
+
+  bool empty() const {
+    return c.empty();
+  }
+
+  size_type size() const {
+    return c.size();
+  }
+
+  void push( const value_type& value ) {
+    c.push_back(value);
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  void push( value_type&& value ) {
+    c.push_back(std::move(value));
+  }
+
+  template< class... Args >
+  void emplace( Args&&... args ) {
+    c.emplace_back(std::forward<Args>(args)...);
+  }
+#endif
+
+  void pop() {
+    c.pop_front();
+  }
+
+  void swap( queue& other ) {
+    c.swap(other.c);
+  }
+
+  template<class A, class B>
+  friend bool operator==(const ft::queue<A, B>& lhs,
+                         const ft::queue<A, B>& rhs);
+
+  template<class A, class B>
+  friend bool operator<(const ft::queue<A, B>& lhs,
+                        const ft::queue<A, B>& rhs);
+
+}; // class queue
+
+template< class T, class Container >
+bool operator==( const ft::queue<T,Container>& x,
+                 const ft::queue<T,Container>& y )
+{
+  return x.c == y.c;
+}
+
+template< class T, class Container >
+bool operator<( const ft::queue<T,Container>& x,
+                const ft::queue<T,Container>& y )
+{
+  return x.c < y.c;
+}
+
+template< class T, class Container >
+bool operator!=( const ft::queue<T,Container>& x,
+                 const ft::queue<T,Container>& y )
+{
+  return !(x == y);
+}
+
+template< class T, class Container >
+bool operator<=( const ft::queue<T,Container>& x,
+                 const ft::queue<T,Container>& y )
+{
+  return !(y < x);
+}
+
+template< class T, class Container >
+bool operator>( const ft::queue<T,Container>& x,
+                const ft::queue<T,Container>& y )
+{
+  return y < x;
+}
+
+template< class T, class Container >
+bool operator>=( const ft::queue<T,Container>& x,
+                 const ft::queue<T,Container>& y )
+{
+  return !(x < y);
+}
+
+template< class T, class Container >
+void swap( ft::queue<T,Container>& x, ft::queue<T,Container>& y ) {
+  x.swap(y);
+}
+
+/*
+ * top() is the greatest element according to Compare (std::less :
+ * a max-heap, std::greater : a min-heap), like std::priority_queue.
+ */
+template < class T,
+           class Container = ft::vector<T>,
+           class Compare = std::less<typename Container::value_type> >
+class priority_queue {
+
+  public:
+  typedef Container                                    container_type;
+  typedef Compare                                      value_compare;
+  typedef typename container_type::value_type          value_type;
+  typedef typename container_type::size_type           size_type;
+  typedef typename container_type::reference           reference;
+  typedef typename container_type::const_reference     const_reference;
+
+  protected:
+
+  container_type   c;
+  value_compare    comp;
+
+  public:
+
+  explicit priority_queue( const Compare& compare = Compare(),
+                           const Container& cont = Container() )
+  :
+    c(cont),
+    comp(compare)
+  {
+    ft::make_heap(c.begin(), c.end(), comp);
+  }
+
+  /* Bulk construction : cont + [first, last), one O(n) make_heap. */
+  template< class InputIt >
+  priority_queue( InputIt first, InputIt last,
+                  const Compare& compare = Compare(),
+                  const Container& cont = Container() )
+  :
+    c(cont),
+    comp(compare)
+  {
+    c.insert(c.end(), first, last);
+    ft::make_heap(c.begin(), c.end(), comp);
+  }
+
+  priority_queue( const priority_queue& other )
+  :
+    c(other.c),
+    comp(other.comp)
+  {}
+
+  ~priority_queue() {}
+
+  priority_queue& operator=( const priority_queue& other ) {
+    if (this != &other) {
+      c = other.c;
+      comp = other.comp;
+    }
+    return (*this);
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  priority_queue( priority_queue&& other )
+  :
+    c(std::move(other.c)),
+    comp(std::move(other.comp))
+  {}
+
+  priority_queue& operator=( priority_queue&& other ) {
+    c = std::move(other.c);
+    comp = std::move(other.comp);
+    return (*this);
+  }
+#endif
+
+  const_reference top() const {
+    return c.front();
+  }
+
+  bool empty() const {
+    return c.empty();
+  }
+
+  size_type size() const {
+    return c.size();
+  }
+
+  void push( const value_type& value ) {
+    c.push_back(value);
+    ft::push_heap(c.begin(), c.end(), comp);
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  void push( value_type&& value ) {
+    c.push_back(std::move(value));
+    ft::push_heap(c.begin(), c.end(), comp);
+  }
+
+  template< class... Args >
+  void emplace( Args&&... args ) {
+    c.emplace_back(std::forward<Args>(args)...);
+    ft::push_heap(c.begin(), c.end(), comp);
+  }
+#endif
+
+  /*
+   * Adds [first, last) in one go. When the batch is larger than what
+   * is already queued, rebuilding the whole heap (O(n)) beats sifting
+   * every new element up (O(k log n)).
+   */
+  template< class InputIt >
+  void push_range( InputIt first, InputIt last ) {
+    size_type old_size = c.size();
+    c.insert(c.end(), first, last);
+    if (c.size() - old_size > old_size) {
+      ft::make_heap(c.begin(), c.end(), comp);
+      return ;
+    }
+    for (size_type i = old_size + 1; i <= c.size(); ++i) {
+      ft::push_heap(c.begin(), c.begin() + i, comp);
+    }
+  }
+
+  void pop() {
+    ft::pop_heap(c.begin(), c.end(), comp);
+    c.pop_back();
+  }
+
+  void swap( priority_queue& other ) {
+    c.swap(other.c);
+    ft::swap(comp, other.comp);
+  }
+
+}; // class priority_queue
+
+template< class T, class Container, class Compare >
+void swap( ft::priority_queue<T,Container,Compare>& x,
+           ft::priority_queue<T,Container,Compare>& y )
+{
+  x.swap(y);
+}
+
+} // namespace ft
+
+#endif /* FT_CONTAINERS_QUEUE_HPP */
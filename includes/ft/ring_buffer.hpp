@@ -0,0 +1,222 @@
+#ifndef FT_CONTAINERS_RING_BUFFER_HPP
+# define FT_CONTAINERS_RING_BUFFER_HPP
+#pragma once
+
+#include <memory> /* std::allocator */
+#include <cstddef> /* std::size_t */
+#include <stdexcept>
+
+#include "ft/utils/utils.hpp"
+
+/*
+ * Fixed capacity FIFO, allocated once at construction. See :
+ * https://en.wikipedia.org/wiki/Circular_buffer
+ * https://www.snellman.net/blog/archive/2016-12-13-ring-buffers/
+ *
+ * The capacity is rounded up to a power of two so a position wraps
+ * with a mask instead of a modulo. _head and _tail are never wrapped
+ * themselves, they just grow (the unsigned overflow is harmless) :
+ *
+ *    size()      = _tail - _head
+ *    slot of i   = _buffer[(_head + i) & _mask]
+ *
+ * so all capacity() slots are usable, no slot is sacrificed to tell
+ * "full" from "empty". push / pop never allocate : a push on a full
+ * buffer fails (returns false) instead of growing.
+ */
+
+namespace ft {
+
+template < class T, class Allocator = std::allocator<T> >
+class ring_buffer {
+
+  public:
+  typedef T                                            value_type;
+  typedef Allocator                                    allocator_type;
+  typedef std::size_t                                  size_type;
+  typedef typename Allocator::reference                reference;
+  typedef typename Allocator::const_reference          const_reference;
+  typedef typename Allocator::pointer                  pointer;
+
+  private:
+
+  allocator_type _alloc;
+  pointer        _buffer;
+  size_type      _mask;   // capacity() - 1
+  size_type      _head;   // next to pop
+  size_type      _tail;   // next to push
+
+  static size_type round_up_pow2( size_type n ) {
+    size_type p = 1;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+  pointer slot( size_type index ) const {
+    return _buffer + (index & _mask);
+  }
+
+  void init( size_type capacity ) {
+    if (capacity > _alloc.max_size()) {
+      throw std::length_error("ft::ring_buffer");
+    }
+    capacity = round_up_pow2(capacity ? capacity : 1);
+    _buffer = _alloc.allocate(capacity);
+    _mask = capacity - 1;
+  }
+
+  public:
+
+  /* capacity() will be the next power of two >= capacity. */
+  explicit ring_buffer( size_type capacity,
+                        const Allocator& alloc = Allocator() )
+  :
+    _alloc(alloc),
+    _buffer(0),
+    _mask(0),
+    _head(0),
+    _tail(0)
+  {
+    init(capacity);
+  }
+
+  ring_buffer( const ring_buffer& other )
+  :
+    _alloc(other._alloc),
+    _buffer(0),
+    _mask(0),
+    _head(0),
+    _tail(0)
+  {
+    init(other.capacity());
+    for (size_type i = 0; i < other.size(); ++i) {
+      push(other[i]);
+    }
+  }
+
+  ~ring_buffer() {
+    clear();
+    _alloc.deallocate(_buffer, capacity());
+  }
+
+  ring_buffer& operator=( const ring_buffer& other ) {
+    if (this != &other) {
+      ring_buffer tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const {
+    return _alloc;
+  }
+
+  /* From the oldest (0) to the newest (size() - 1). */
+  reference operator[]( size_type pos ) {
+    return *slot(_head + pos);
+  }
+
+  const_reference operator[]( size_type pos ) const {
+    return *slot(_head + pos);
+  }
+
+  reference front() {
+    return *slot(_head);
+  }
+
+  const_reference front() const {
+    return *slot(_head);
+  }
+
+  reference back() {
+    return *slot(_tail - 1);
+  }
+
+  const_reference back() const {
+    return *slot(_tail - 1);
+  }
+
+  bool empty() const {
+    return _head == _tail;
+  }
+
+  bool full() const {
+    return _tail - _head == capacity();
+  }
+
+  size_type size() const {
+    return _tail - _head;
+  }
+
+  size_type capacity() const {
+    return _mask + 1;
+  }
+
+  /* Appends value, or returns false if the buffer is full. */
+  bool push( const T& value ) {
+    if (full()) {
+      return false;
+    }
+    _alloc.construct(slot(_tail), value);
+    ++_tail;
+    return true;
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  bool push( T&& value ) {
+    if (full()) {
+      return false;
+    }
+    _alloc.construct(slot(_tail), std::move(value));
+    ++_tail;
+    return true;
+  }
+#endif
+
+  /* Removes the oldest element. The buffer must not be empty. */
+  void pop() {
+    _alloc.destroy(slot(_head));
+    ++_head;
+  }
+
+  /*
+   * Moves the oldest element to out and removes it, or returns false
+   * if the buffer is empty.
+   */
+  bool pop( T& out ) {
+    if (empty()) {
+      return false;
+    }
+    out = FT_MOVE(front());
+    pop();
+    return true;
+  }
+
+  void clear() {
+    while (!empty()) {
+      pop();
+    }
+    _head = 0;
+    _tail = 0;
+  }
+
+  void swap( ring_buffer& other ) {
+    ft::swap(_alloc, other._alloc);
+    ft::swap(_buffer, other._buffer);
+    ft::swap(_mask, other._mask);
+    ft::swap(_head, other._head);
+    ft::swap(_tail, other._tail);
+  }
+
+}; /* class ring_buffer */
+
+template< class T, class Alloc >
+void swap( ft::ring_buffer<T,Alloc>& x, ft::ring_buffer<T,Alloc>& y ) {
+  x.swap(y);
+}
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_RING_BUFFER_HPP */
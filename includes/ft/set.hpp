@@ -29,6 +29,9 @@ class set {
     set_get_key<const Key> get_key;
     key_compare            key_cmp;
 
+    ValueCompare( const key_compare& comp = key_compare() )
+    : key_cmp(comp) {}
+
     bool operator()(const value_type& x, const value_type& y) {
       return key_cmp(get_key(x), get_key(y));
     }
@@ -43,9 +46,9 @@ class set {
                   Allocator >                        tree_type;
   typedef typename tree_type::node_ptr               node_ptr;
 
+  // the allocator and comparator live in the tree, where they take
+  // no room when empty : a set is the size of its tree.
   tree_type      tree;
-  allocator_type allocator;
-  value_compare  value_cmp;
 
   public:
 
@@ -75,17 +78,13 @@ class set {
 
   set()
   :
-    tree(),
-    allocator(),
-    value_cmp()
+    tree()
   {}
 
   explicit set( const Compare& comp,
                 const Allocator& alloc = Allocator())
   :
-    tree(comp),
-    allocator(alloc),
-    value_cmp()
+    tree(comp, alloc)
   {}
 
   template< class InputIt >
@@ -98,32 +97,45 @@ class set {
                    value_type>::value,
                  value_type>::type* = 0 )
   :
-    tree(comp),
-    allocator(alloc),
-    value_cmp()
+    tree(comp, alloc)
   {
     insert(first, last);
   }
 
   set( const set& other )
   :
-    tree(other.tree),
-    allocator(other.allocator),
-    value_cmp(other.value_cmp)
+    tree(other.tree)
+  {}
+
+#ifdef FT_CONTAINERS_CXX11
+  set( set&& other ) noexcept
+  :
+    tree(std::move(other.tree))
   {}
 
+  set& operator=( set&& other ) noexcept {
+    tree = std::move(other.tree);
+    return *this;
+  }
+#endif
+
   ~set() {}
 
+  /*
+   * Copy and swap : the comparator (and allocator) come with the
+   * elements, as by the copy constructor, and *this is left untouched
+   * if a copy throws.
+   */
   set& operator=( const set& other ) {
     if (this != &other) {
-      clear();
-      insert(other.begin(), other.end());
+      tree_type copy(other.tree);
+      tree.swap(copy);
     }
     return *this;
   }
 
   allocator_type get_allocator() const {
-    return allocator;
+    return allocator_type(tree.get_node_allocator());
   }
 
   inline iterator begin() {
@@ -198,13 +210,31 @@ class set {
     }
   }
 
+#ifdef FT_CONTAINERS_CXX11
+  ft::pair<iterator, bool> insert( value_type&& value ) {
+    return tree.emplace(std::move(value));
+  }
+
+  template< class... Args >
+  ft::pair<iterator, bool> emplace( Args&&... args ) {
+    return tree.emplace(std::forward<Args>(args)...);
+  }
+
+  template< class... Args >
+  iterator emplace_hint( const_iterator hint, Args&&... args ) {
+    return iterator(tree.emplace_hint(const_cast<node_ptr>(hint.base()),
+                                      std::forward<Args>(args)...),
+                    tree.get_node_end());
+  }
+#endif
+
   void erase( iterator pos ) {
     tree.erase(*pos);
   }
 
-  // This does not invalidate iterators because we substitute
-  // for inorder PREDECESSOR and an rb_tree iterator always ends
-  // up with greater key values when incrementing.
+  // This does not invalidate iterators because erasing a node
+  // only relinks the others (see switch_with_inorder_predecessor),
+  // first is already past the erased one.
   void erase( iterator first, iterator last ) {
     while (first != last) {
       tree.erase(*first++);
@@ -219,7 +249,6 @@ class set {
   }
 
   void swap(set& other) {
-    ft::swap(allocator, other.allocator);
     tree.swap(other.tree);
   }
 
@@ -287,11 +316,11 @@ class set {
   }
 
   key_compare key_comp() const {
-    return tree.key_cmp;
+    return tree.key_comp();
   }
 
   value_compare value_comp() const {
-    return value_cmp;
+    return value_compare(tree.key_comp());
   }
 
 }; // class ft::set
@@ -10,6 +10,7 @@
  * It is a vector wrapper, with very limited methods that consist
  * on calling the underlying container methods.
  * List, vector and dequeue are suitable to be the underlying container.
+ * ft::deque never relocates elements on growth, see deque.hpp.
  */
 
 namespace ft {
@@ -51,6 +52,23 @@ class stack {
     return (*this);
   }
 
+#ifdef FT_CONTAINERS_CXX11
+  explicit stack( container_type&& cont )
+  :
+    c(std::move(cont))
+  {}
+
+  stack( stack&& other )
+  :
+    c(std::move(other.c))
+  {}
+
+  stack& operator=( stack&& other ) {
+    c = std::move(other.c);
+    return (*this);
+  }
+#endif
+
   reference top() {
     return c.back();
   }
@@ -71,10 +89,81 @@ class stack {
     c.push_back(value);
   }
 
+#ifdef FT_CONTAINERS_CXX11
+  void push( value_type&& value ) {
+    c.push_back(std::move(value));
+  }
+
+  template< class... Args >
+  void emplace( Args&&... args ) {
+    c.emplace_back(std::forward<Args>(args)...);
+  }
+#endif
+
   void pop() {
     c.pop_back();
   }
 
+  /*
+   * Bulk operations, for stacks that grow and shrink by whole batches
+   * (DFS frontiers, parser states...).
+   *
+   * push_range pushes [first, last) in order, so *(last - 1) ends on
+   * top. On ft::vector it is vector::append : one capacity check and
+   * at most one reallocation for the batch, a memcpy for contiguous
+   * trivially copyable ranges. Other containers get
+   * insert(end(), first, last).
+   */
+  template< class InputIt >
+  void push_range( InputIt first, InputIt last ) {
+    append_range(c, first, last);
+  }
+
+  /* Pops the count top elements at once, count <= size(). */
+  void pop_n( size_type count ) {
+    c.erase(c.end() - count, c.end());
+  }
+
+  /* Moves the top element to out, then pops it. */
+  void pop_into( value_type& out ) {
+    out = FT_MOVE(c.back());
+    c.pop_back();
+  }
+
+  /* Forwarded like shrink_to_fit, only for containers that have it. */
+  void reserve( size_type new_cap ) {
+    c.reserve(new_cap);
+  }
+
+  /*
+   * Capacity reclamation, forwarded to the underlying container
+   * (see ft::vector::shrink_to_fit and ft::vector::set_auto_shrink).
+   * Only instantiated if called, so containers without them still
+   * work for everything else.
+   */
+  void shrink_to_fit() {
+    c.shrink_to_fit();
+  }
+
+  void set_auto_shrink( bool enable ) {
+    c.set_auto_shrink(enable);
+  }
+
+  private:
+
+  template< class U, class A, class InputIt >
+  static void append_range( ft::vector<U, A>& cont,
+                            InputIt first, InputIt last ) {
+    cont.append(first, last);
+  }
+
+  template< class Cont, class InputIt >
+  static void append_range( Cont& cont, InputIt first, InputIt last ) {
+    cont.insert(cont.end(), first, last);
+  }
+
+  public:
+
   /* These two outter functions MUST have acces to the inner container.
    * The rest of the comparison operators can be written
    * in terms of these two.
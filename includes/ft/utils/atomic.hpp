@@ -0,0 +1,111 @@
+#ifndef FT_CONTAINERS_ATOMIC_HPP
+# define FT_CONTAINERS_ATOMIC_HPP
+#pragma once
+
+#include <cstddef> /* std::size_t */
+
+/*
+ * A tiny std::atomic for C++98, on top of the GCC / clang __atomic
+ * builtins (the same ones libstdc++ uses). See :
+ * https://en.cppreference.com/w/cpp/atomic/atomic
+ * https://gcc.gnu.org/onlinedocs/gcc/_005f_005fatomic-Builtins.html
+ *
+ * Only what the concurrent containers need : integral (or pointer)
+ * T, load / store / exchange / compare_exchange / fetch_add.
+ * memory_order maps 1:1 to the builtin constants, so it can be passed
+ * straight through.
+ */
+
+namespace ft {
+
+enum memory_order {
+  memory_order_relaxed = __ATOMIC_RELAXED,
+  memory_order_acquire = __ATOMIC_ACQUIRE,
+  memory_order_release = __ATOMIC_RELEASE,
+  memory_order_acq_rel = __ATOMIC_ACQ_REL,
+  memory_order_seq_cst = __ATOMIC_SEQ_CST
+};
+
+/*
+ * Two hot variables written by different threads should never share
+ * a cache line, or every write bounces the line between cores
+ * (false sharing). 64 bytes is the line size of x86 and most ARM.
+ */
+static const std::size_t cache_line_size = 64;
+
+template < typename T >
+class atomic {
+
+  T _value;
+
+  atomic( const atomic& );            // not copyable
+  atomic& operator=( const atomic& );
+
+  public:
+
+  atomic() : _value() {}
+  explicit atomic( T value ) : _value(value) {}
+
+  T load( memory_order order = memory_order_seq_cst ) const {
+    return __atomic_load_n(&_value, order);
+  }
+
+  void store( T value, memory_order order = memory_order_seq_cst ) {
+    __atomic_store_n(&_value, value, order);
+  }
+
+  T exchange( T value, memory_order order = memory_order_seq_cst ) {
+    return __atomic_exchange_n(&_value, value, order);
+  }
+
+  /* May fail spuriously, meant to be called in a loop. */
+  bool compare_exchange_weak( T& expected, T desired,
+                              memory_order success = memory_order_seq_cst,
+                              memory_order failure = memory_order_seq_cst ) {
+    return __atomic_compare_exchange_n(&_value, &expected, desired, true,
+                                       success, failure);
+  }
+
+  bool compare_exchange_strong( T& expected, T desired,
+                                memory_order success = memory_order_seq_cst,
+                                memory_order failure = memory_order_seq_cst ) {
+    return __atomic_compare_exchange_n(&_value, &expected, desired, false,
+                                       success, failure);
+  }
+
+  T fetch_add( T value, memory_order order = memory_order_seq_cst ) {
+    return __atomic_fetch_add(&_value, value, order);
+  }
+
+  T fetch_sub( T value, memory_order order = memory_order_seq_cst ) {
+    return __atomic_fetch_sub(&_value, value, order);
+  }
+
+}; /* class atomic */
+
+/*
+ * value alone on its cache line : the padding keeps whatever is
+ * declared around it on other lines.
+ */
+template < typename T >
+struct cache_padded {
+  char before[cache_line_size];
+  T    value;
+  char after[cache_line_size];
+
+  cache_padded() : value() {}
+
+  template < typename U >
+  explicit cache_padded( const U& init ) : value(init) {}
+};
+
+/* Spin-wait hint, lets the sibling hyperthread run. */
+inline void cpu_relax() {
+#if defined(__i386__) || defined(__x86_64__)
+  __builtin_ia32_pause();
+#endif
+}
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_ATOMIC_HPP */
@@ -0,0 +1,349 @@
+#ifndef FT_CONTAINERS_BIT_ITERATOR_HPP
+# define FT_CONTAINERS_BIT_ITERATOR_HPP
+#pragma once
+
+#include <cstddef> /* std::size_t, std::ptrdiff_t */
+#include <stdint.h> /* uint64_t */
+#include "ft/utils/iterator_traits.hpp"
+
+/*
+ * Proxy reference and iterators for the packed ft::vector<bool>.
+ * See :
+ * https://en.cppreference.com/w/cpp/container/vector_bool
+ * https://en.cppreference.com/w/cpp/container/vector_bool/reference
+ *
+ * A bit cannot be addressed, so a "pointer" to a bit is a pair
+ * (word pointer, bit offset inside the word). The iterators below
+ * are just that pair plus the arithmetic to walk over it. The
+ * mutable iterator returns a bit_reference (the proxy) on
+ * dereference, the const one returns a plain bool.
+ */
+
+namespace ft {
+
+typedef uint64_t bit_word;
+
+static const unsigned int bits_per_word = sizeof(bit_word) * 8;
+
+class bit_reference {
+
+  private:
+
+  bit_word* _word;
+  bit_word  _mask;
+
+  public:
+
+  bit_reference()
+  :
+    _word(0),
+    _mask(0)
+  {}
+
+  bit_reference(bit_word* word, unsigned int offset)
+  :
+    _word(word),
+    _mask(bit_word(1) << offset)
+  {}
+
+  bit_reference(const bit_reference& x)
+  :
+    _word(x._word),
+    _mask(x._mask)
+  {}
+
+  operator bool() const {
+    return (*_word & _mask) != 0;
+  }
+
+  bool operator~() const {
+    return (*_word & _mask) == 0;
+  }
+
+  bit_reference& operator=( bool x ) {
+    if (x) {
+      *_word |= _mask;
+    } else {
+      *_word &= ~_mask;
+    }
+    return *this;
+  }
+
+  /* Assigning a reference to another copies the bit, not the proxy. */
+  bit_reference& operator=( const bit_reference& x ) {
+    return *this = bool(x);
+  }
+
+  bool operator==( const bit_reference& x ) const {
+    return bool(*this) == bool(x);
+  }
+
+  bool operator<( const bit_reference& x ) const {
+    return !bool(*this) && bool(x);
+  }
+
+  void flip() {
+    *_word ^= _mask;
+  }
+
+}; /* class bit_reference */
+
+inline void swap( bit_reference x, bit_reference y ) {
+  bool tmp = x;
+  x = y;
+  y = tmp;
+}
+
+/*
+ * Shared state and arithmetic of both bit iterators. _offset is
+ * always kept in [0, bits_per_word).
+ */
+class bit_iterator_base {
+
+  public:
+
+  typedef ft::random_access_iterator_tag iterator_category;
+  typedef bool                           value_type;
+  typedef std::ptrdiff_t                 difference_type;
+
+  protected:
+
+  bit_word*    _word;
+  unsigned int _offset;
+
+  bit_iterator_base(bit_word* word, unsigned int offset)
+  :
+    _word(word),
+    _offset(offset)
+  {}
+
+  void bump_up() {
+    if (_offset++ == bits_per_word - 1) {
+      _offset = 0;
+      ++_word;
+    }
+  }
+
+  void bump_down() {
+    if (_offset-- == 0) {
+      _offset = bits_per_word - 1;
+      --_word;
+    }
+  }
+
+  void incr( difference_type n ) {
+    difference_type pos = n + _offset;
+    _word += pos / difference_type(bits_per_word);
+    pos = pos % difference_type(bits_per_word);
+    if (pos < 0) {
+      pos += bits_per_word;
+      --_word;
+    }
+    _offset = static_cast<unsigned int>(pos);
+  }
+
+  public:
+
+  bit_word* word() const {
+    return _word;
+  }
+
+  unsigned int offset() const {
+    return _offset;
+  }
+
+  bool operator==( const bit_iterator_base& x ) const {
+    return _word == x._word && _offset == x._offset;
+  }
+
+  bool operator!=( const bit_iterator_base& x ) const {
+    return !(*this == x);
+  }
+
+  bool operator<( const bit_iterator_base& x ) const {
+    return _word < x._word
+           || (_word == x._word && _offset < x._offset);
+  }
+
+  bool operator>( const bit_iterator_base& x ) const {
+    return x < *this;
+  }
+
+  bool operator<=( const bit_iterator_base& x ) const {
+    return !(x < *this);
+  }
+
+  bool operator>=( const bit_iterator_base& x ) const {
+    return !(*this < x);
+  }
+
+  difference_type operator-( const bit_iterator_base& x ) const {
+    return difference_type(bits_per_word) * (_word - x._word)
+           + difference_type(_offset) - difference_type(x._offset);
+  }
+
+}; /* class bit_iterator_base */
+
+class bit_iterator : public bit_iterator_base {
+
+  public:
+
+  typedef bit_reference  reference;
+  typedef bit_reference* pointer;
+  typedef bit_iterator   self;
+
+  bit_iterator()
+  :
+    bit_iterator_base(0, 0)
+  {}
+
+  bit_iterator(bit_word* word, unsigned int offset)
+  :
+    bit_iterator_base(word, offset)
+  {}
+
+  reference operator*() const {
+    return reference(_word, _offset);
+  }
+
+  reference operator[]( difference_type n ) const {
+    return *(*this + n);
+  }
+
+  self& operator++() {
+    bump_up();
+    return *this;
+  }
+
+  self operator++(int) {
+    self tmp = *this;
+    bump_up();
+    return tmp;
+  }
+
+  self& operator--() {
+    bump_down();
+    return *this;
+  }
+
+  self operator--(int) {
+    self tmp = *this;
+    bump_down();
+    return tmp;
+  }
+
+  self& operator+=( difference_type n ) {
+    incr(n);
+    return *this;
+  }
+
+  self& operator-=( difference_type n ) {
+    incr(-n);
+    return *this;
+  }
+
+  self operator+( difference_type n ) const {
+    self tmp = *this;
+    return tmp += n;
+  }
+
+  self operator-( difference_type n ) const {
+    self tmp = *this;
+    return tmp -= n;
+  }
+
+  /* Keep iterator - iterator visible next to iterator - n. */
+  using bit_iterator_base::operator-;
+
+}; /* class bit_iterator */
+
+class bit_const_iterator : public bit_iterator_base {
+
+  public:
+
+  typedef bool               reference;
+  typedef const bool*        pointer;
+  typedef bit_const_iterator self;
+
+  bit_const_iterator()
+  :
+    bit_iterator_base(0, 0)
+  {}
+
+  bit_const_iterator(const bit_word* word, unsigned int offset)
+  :
+    bit_iterator_base(const_cast<bit_word*>(word), offset)
+  {}
+
+  bit_const_iterator(const bit_iterator& it)
+  :
+    bit_iterator_base(it.word(), it.offset())
+  {}
+
+  reference operator*() const {
+    return (*_word & (bit_word(1) << _offset)) != 0;
+  }
+
+  reference operator[]( difference_type n ) const {
+    return *(*this + n);
+  }
+
+  self& operator++() {
+    bump_up();
+    return *this;
+  }
+
+  self operator++(int) {
+    self tmp = *this;
+    bump_up();
+    return tmp;
+  }
+
+  self& operator--() {
+    bump_down();
+    return *this;
+  }
+
+  self operator--(int) {
+    self tmp = *this;
+    bump_down();
+    return tmp;
+  }
+
+  self& operator+=( difference_type n ) {
+    incr(n);
+    return *this;
+  }
+
+  self& operator-=( difference_type n ) {
+    incr(-n);
+    return *this;
+  }
+
+  self operator+( difference_type n ) const {
+    self tmp = *this;
+    return tmp += n;
+  }
+
+  self operator-( difference_type n ) const {
+    self tmp = *this;
+    return tmp -= n;
+  }
+
+  using bit_iterator_base::operator-;
+
+}; /* class bit_const_iterator */
+
+inline bit_iterator operator+( std::ptrdiff_t n, const bit_iterator& it ) {
+  return it + n;
+}
+
+inline bit_const_iterator operator+( std::ptrdiff_t n,
+                                     const bit_const_iterator& it )
+{
+  return it + n;
+}
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_BIT_ITERATOR_HPP */
@@ -0,0 +1,233 @@
+#ifndef FT_CONTAINERS_DEQUE_ITERATOR_HPP
+# define FT_CONTAINERS_DEQUE_ITERATOR_HPP
+#pragma once
+
+#include <cstddef> /* std::size_t, std::ptrdiff_t */
+#include "ft/utils/iterator_traits.hpp"
+
+/*
+ * Block geometry and iterators for ft::deque.
+ * See :
+ * https://en.cppreference.com/w/cpp/container/deque
+ *
+ * Elements live in fixed-size blocks of deque_block<T>::size
+ * elements (a power of two, about 4KB worth of T, never less than
+ * 16), reached through an array of block pointers : the map.
+ * Every element has an absolute index inside the map :
+ *
+ *    block    = index >> deque_block<T>::shift
+ *    position = index &  deque_block<T>::mask
+ *
+ * so an iterator is just (map, absolute index) and the random
+ * access arithmetic is plain integer arithmetic on the index.
+ * Iterators are invalidated when the map itself moves (growth at
+ * either end), references never are.
+ */
+
+namespace ft {
+
+/* floor(log2(N)), at compile time. */
+template < std::size_t N >
+struct static_log2 {
+  static const std::size_t value = 1 + static_log2<N / 2>::value;
+};
+
+template <>
+struct static_log2<1> {
+  static const std::size_t value = 0;
+};
+
+template < typename T >
+struct deque_block {
+  static const std::size_t shift =
+    static_log2<(sizeof(T) < 256 ? 4096 / sizeof(T) : 16)>::value;
+  static const std::size_t size = std::size_t(1) << shift;
+  static const std::size_t mask = size - 1;
+};
+
+/*
+ * V is T for the mutable iterator and const T for the const one.
+ */
+template < typename T, typename V >
+class deque_iterator {
+
+  public:
+
+  typedef ft::random_access_iterator_tag iterator_category;
+  typedef T                              value_type;
+  typedef std::ptrdiff_t                 difference_type;
+  typedef V*                             pointer;
+  typedef V&                             reference;
+  typedef deque_iterator                 self;
+
+  private:
+
+  typedef deque_block<T> block;
+
+  V* const*   _map;
+  std::size_t _index;
+
+  public:
+
+  deque_iterator()
+  :
+    _map(0),
+    _index(0)
+  {}
+
+  deque_iterator(V* const* map, std::size_t index)
+  :
+    _map(map),
+    _index(index)
+  {}
+
+  deque_iterator(const deque_iterator& other)
+  :
+    _map(other._map),
+    _index(other._index)
+  {}
+
+  /* iterator -> const_iterator */
+  template < typename U >
+  deque_iterator(const deque_iterator<T, U>& other)
+  :
+    _map(other.map()),
+    _index(other.index())
+  {}
+
+  deque_iterator& operator=(const deque_iterator& other) {
+    _map = other._map;
+    _index = other._index;
+    return *this;
+  }
+
+  V* const* map() const {
+    return _map;
+  }
+
+  std::size_t index() const {
+    return _index;
+  }
+
+  /* Address of the element, what ft::reverse_iterator::operator-> uses. */
+  pointer base() const {
+    return &(operator*());
+  }
+
+  reference operator*() const {
+    return _map[_index >> block::shift][_index & block::mask];
+  }
+
+  pointer operator->() const {
+    return &(operator*());
+  }
+
+  reference operator[](difference_type n) const {
+    return *(*this + n);
+  }
+
+  self& operator++() {
+    ++_index;
+    return *this;
+  }
+
+  self operator++(int) {
+    self tmp = *this;
+    ++_index;
+    return tmp;
+  }
+
+  self& operator--() {
+    --_index;
+    return *this;
+  }
+
+  self operator--(int) {
+    self tmp = *this;
+    --_index;
+    return tmp;
+  }
+
+  self& operator+=(difference_type n) {
+    _index += n;
+    return *this;
+  }
+
+  self& operator-=(difference_type n) {
+    _index -= n;
+    return *this;
+  }
+
+  self operator+(difference_type n) const {
+    return self(_map, _index + n);
+  }
+
+  self operator-(difference_type n) const {
+    return self(_map, _index - n);
+  }
+
+}; /* class deque_iterator */
+
+/*
+ * Comparisons and difference between any mix of iterator and
+ * const_iterator.
+ */
+template < typename T, typename V1, typename V2 >
+bool operator==(const deque_iterator<T, V1>& x,
+                const deque_iterator<T, V2>& y)
+{
+  return x.index() == y.index();
+}
+
+template < typename T, typename V1, typename V2 >
+bool operator!=(const deque_iterator<T, V1>& x,
+                const deque_iterator<T, V2>& y)
+{
+  return x.index() != y.index();
+}
+
+template < typename T, typename V1, typename V2 >
+bool operator<(const deque_iterator<T, V1>& x,
+               const deque_iterator<T, V2>& y)
+{
+  return x.index() < y.index();
+}
+
+template < typename T, typename V1, typename V2 >
+bool operator>(const deque_iterator<T, V1>& x,
+               const deque_iterator<T, V2>& y)
+{
+  return x.index() > y.index();
+}
+
+template < typename T, typename V1, typename V2 >
+bool operator<=(const deque_iterator<T, V1>& x,
+                const deque_iterator<T, V2>& y)
+{
+  return x.index() <= y.index();
+}
+
+template < typename T, typename V1, typename V2 >
+bool operator>=(const deque_iterator<T, V1>& x,
+                const deque_iterator<T, V2>& y)
+{
+  return x.index() >= y.index();
+}
+
+template < typename T, typename V1, typename V2 >
+std::ptrdiff_t operator-(const deque_iterator<T, V1>& x,
+                         const deque_iterator<T, V2>& y)
+{
+  return std::ptrdiff_t(x.index() - y.index());
+}
+
+template < typename T, typename V >
+deque_iterator<T, V> operator+(std::ptrdiff_t n,
+                               const deque_iterator<T, V>& it)
+{
+  return it + n;
+}
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_DEQUE_ITERATOR_HPP */
@@ -0,0 +1,170 @@
+#ifndef FT_CONTAINERS_HEAP_HPP
+# define FT_CONTAINERS_HEAP_HPP
+#pragma once
+
+#include <functional> /* std::less */
+#include "ft/utils/iterator_traits.hpp"
+#include "ft/utils/utils.hpp"
+
+/*
+ * Heap algorithms, the backbone of ft::priority_queue. See :
+ * https://en.cppreference.com/w/cpp/algorithm/make_heap
+ * https://en.wikipedia.org/wiki/D-ary_heap
+ *
+ * Same interface and same "max-heap according to comp" meaning as
+ * std's, but the heap is 4-ary : the children of i are 4i+1 .. 4i+4
+ * and its parent is (i-1)/4. Half as many levels as a binary heap,
+ * and the four children sit next to each other in memory, so a pop
+ * touches fewer cache lines. The layout is NOT the std one : a range
+ * made with ft::make_heap must be used with ft::push_heap / pop_heap,
+ * not std's (and the other way around).
+ *
+ * make_heap is Floyd's bottom-up construction : O(n), where n pushes
+ * are O(n log n).
+ */
+
+namespace ft {
+
+static const long heap_arity = 4;
+
+/*
+ * Moves the hole at index hole down until value can be put there :
+ * each step brings the greatest child up.
+ */
+template< class RandomIt, class Distance, class T, class Compare >
+void heap_sift_down( RandomIt first, Distance len, Distance hole,
+                     T& value, Compare comp )
+{
+  for (;;) {
+    Distance child = hole * heap_arity + 1;
+    if (child >= len) {
+      break;
+    }
+    Distance last_child = child + heap_arity < len
+                          ? child + heap_arity : len;
+    Distance best = child;
+    for (++child; child < last_child; ++child) {
+      if (comp(first[best], first[child])) {
+        best = child;
+      }
+    }
+    if (!comp(value, first[best])) {
+      break;
+    }
+    first[hole] = FT_MOVE(first[best]);
+    hole = best;
+  }
+  first[hole] = FT_MOVE(value);
+}
+
+/* Moves the hole at index hole up until value can be put there. */
+template< class RandomIt, class Distance, class T, class Compare >
+void heap_sift_up( RandomIt first, Distance hole, T& value, Compare comp ) {
+  while (hole > 0) {
+    Distance parent = (hole - 1) / heap_arity;
+    if (!comp(first[parent], value)) {
+      break;
+    }
+    first[hole] = FT_MOVE(first[parent]);
+    hole = parent;
+  }
+  first[hole] = FT_MOVE(value);
+}
+
+template< class RandomIt, class Compare >
+void make_heap( RandomIt first, RandomIt last, Compare comp ) {
+  typedef typename ft::iterator_traits<RandomIt>::difference_type Distance;
+  typedef typename ft::iterator_traits<RandomIt>::value_type      Value;
+  Distance len = last - first;
+  if (len < 2) {
+    return ;
+  }
+  for (Distance parent = (len - 2) / heap_arity; ; --parent) {
+    Value value(FT_MOVE(first[parent]));
+    heap_sift_down(first, len, parent, value, comp);
+    if (parent == 0) {
+      break;
+    }
+  }
+}
+
+template< class RandomIt >
+void make_heap( RandomIt first, RandomIt last ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  ft::make_heap(first, last, std::less<Value>());
+}
+
+/* [first, last - 1) is a heap, *(last - 1) joins it. */
+template< class RandomIt, class Compare >
+void push_heap( RandomIt first, RandomIt last, Compare comp ) {
+  typedef typename ft::iterator_traits<RandomIt>::difference_type Distance;
+  typedef typename ft::iterator_traits<RandomIt>::value_type      Value;
+  Distance hole = (last - first) - 1;
+  if (hole < 1) {
+    return ;
+  }
+  Value value(FT_MOVE(first[hole]));
+  heap_sift_up(first, hole, value, comp);
+}
+
+template< class RandomIt >
+void push_heap( RandomIt first, RandomIt last ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  ft::push_heap(first, last, std::less<Value>());
+}
+
+/* Moves the top to last - 1, [first, last - 1) stays a heap. */
+template< class RandomIt, class Compare >
+void pop_heap( RandomIt first, RandomIt last, Compare comp ) {
+  typedef typename ft::iterator_traits<RandomIt>::difference_type Distance;
+  typedef typename ft::iterator_traits<RandomIt>::value_type      Value;
+  Distance len = (last - first) - 1;
+  if (len < 1) {
+    return ;
+  }
+  Value value(FT_MOVE(first[len]));
+  first[len] = FT_MOVE(first[0]);
+  heap_sift_down(first, len, Distance(0), value, comp);
+}
+
+template< class RandomIt >
+void pop_heap( RandomIt first, RandomIt last ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  ft::pop_heap(first, last, std::less<Value>());
+}
+
+template< class RandomIt, class Compare >
+bool is_heap( RandomIt first, RandomIt last, Compare comp ) {
+  typedef typename ft::iterator_traits<RandomIt>::difference_type Distance;
+  Distance len = last - first;
+  for (Distance child = 1; child < len; ++child) {
+    if (comp(first[(child - 1) / heap_arity], first[child])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template< class RandomIt >
+bool is_heap( RandomIt first, RandomIt last ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  return ft::is_heap(first, last, std::less<Value>());
+}
+
+/* Ascending order (according to comp), O(n log n). */
+template< class RandomIt, class Compare >
+void sort_heap( RandomIt first, RandomIt last, Compare comp ) {
+  while (last - first > 1) {
+    ft::pop_heap(first, last--, comp);
+  }
+}
+
+template< class RandomIt >
+void sort_heap( RandomIt first, RandomIt last ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  ft::sort_heap(first, last, std::less<Value>());
+}
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_HEAP_HPP */
@@ -2,6 +2,8 @@
 # define FT_CONTAINERS_PAIR_HPP
 #pragma once
 
+#include "ft/utils/utils.hpp" /* FT_CONTAINERS_CXX11 */
+
 namespace ft {
 
 template < class T1, class T2 >
@@ -25,6 +27,12 @@ struct pair {
     second(y)
   {}
 
+  pair( const pair& p )
+  :
+    first(p.first),
+    second(p.second)
+  {}
+
   ~pair() {}
 
   template < class U1, class U2 >
@@ -40,6 +48,54 @@ struct pair {
     return *this;
   }
 
+#ifdef FT_CONTAINERS_CXX11
+  /*
+   * Moves (or forwards) each half. With map's pair<const Key, T> the
+   * key is still copied, a const object cannot be moved from.
+   * The moves are noexcept when both halves' are, so containers
+   * relocating pairs (FT_MOVE_IF_NOEXCEPT) move them.
+   */
+  pair( pair&& p )
+    noexcept(std::is_nothrow_move_constructible<T1>::value
+             && std::is_nothrow_move_constructible<T2>::value)
+  :
+    first(std::move(p.first)),
+    second(std::move(p.second))
+  {}
+
+  /*
+   * Only for arguments convertible to both halves, like std::pair :
+   * pair<int*, int>(0, 1) is then the (const T1&, const T2&) one
+   * instead of an int* built from an int.
+   */
+  template < class U1, class U2, class = typename ft::enable_if<
+               std::is_convertible<U1, T1>::value
+               && std::is_convertible<U2, T2>::value, void >::type >
+  pair( U1&& x, U2&& y )
+    noexcept(std::is_nothrow_constructible<T1, U1&&>::value
+             && std::is_nothrow_constructible<T2, U2&&>::value)
+  :
+    first(std::forward<U1>(x)),
+    second(std::forward<U2>(y))
+  {}
+
+  template < class U1, class U2 >
+  pair( pair<U1, U2>&& p )
+  :
+    first(std::move(p.first)),
+    second(std::move(p.second))
+  {}
+
+  pair& operator=( pair&& other )
+    noexcept(std::is_nothrow_move_assignable<T1>::value
+             && std::is_nothrow_move_assignable<T2>::value)
+  {
+    first = std::move(other.first);
+    second = std::move(other.second);
+    return *this;
+  }
+#endif
+
 }; /* struct pair */
 
 template <typename T1, typename T2>
@@ -102,6 +158,74 @@ ft::pair<T1, T2> make_pair( T1 t, T2 u ) {
   return ft::pair<T1, T2>(t, u);
 }
 
+/*
+ * compressed_pair
+ *
+ * A pair for the stateless parts of a container (comparator, key
+ * extractor, allocator) : an empty half is a base class instead of a
+ * member, and the empty base optimization gives it no room at all.
+ * See :
+ * https://en.cppreference.com/w/cpp/language/ebo
+ *
+ *    sizeof(compressed_pair<size_t, std::less<int> >) == sizeof(size_t)
+ *
+ * so pairing an empty functor with a member the container already has
+ * makes it free, where a std::less member costs a padded word. Two
+ * empty halves make an empty pair, so pairs nest. The halves are
+ * reached through first() and second().
+ *
+ * Index keeps the two bases apart when T1 and T2 are the same type.
+ */
+template < typename T, int Index, bool = is_empty<T>::value >
+class compressed_pair_elem {
+
+  T _value;
+
+  public:
+
+  compressed_pair_elem() : _value() {}
+  compressed_pair_elem( const T& value ) : _value(value) {}
+
+  T& get() { return _value; }
+  const T& get() const { return _value; }
+};
+
+template < typename T, int Index >
+class compressed_pair_elem<T, Index, true> : private T {
+
+  public:
+
+  compressed_pair_elem() : T() {}
+  compressed_pair_elem( const T& value ) : T(value) {}
+
+  T& get() { return *this; }
+  const T& get() const { return *this; }
+};
+
+template < typename T1, typename T2 >
+class compressed_pair : private compressed_pair_elem<T1, 0>,
+                        private compressed_pair_elem<T2, 1> {
+
+  typedef compressed_pair_elem<T1, 0> first_base;
+  typedef compressed_pair_elem<T2, 1> second_base;
+
+  public:
+
+  typedef T1  first_type;
+  typedef T2  second_type;
+
+  compressed_pair() : first_base(), second_base() {}
+
+  compressed_pair( const T1& x, const T2& y )
+  : first_base(x), second_base(y) {}
+
+  T1& first() { return first_base::get(); }
+  const T1& first() const { return first_base::get(); }
+
+  T2& second() { return second_base::get(); }
+  const T2& second() const { return second_base::get(); }
+};
+
 } /* namespace ft */
 
 #endif /* FT_CONTAINERS_PAIR_HPP */
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include <iterator>
 #include "ft/utils/iterator_traits.hpp"
+#include "ft/utils/utils.hpp"
 #include <stddef.h> /* NULL */
 
 /* Ref: https://en.cppreference.com/w/cpp/named_req/RandomAccessIterator
@@ -39,6 +40,11 @@ class random_access_iterator {
     :
       _ptr(ptr)
     {}
+
+    random_access_iterator(const random_access_iterator& other)
+    :
+      _ptr(other._ptr)
+    {}
   
     /* 
      * This is used to create random_access_iterator<const T> from a 
@@ -208,6 +214,16 @@ operator+(typename ft::random_access_iterator<T>::difference_type n,
   return (it + n);
 }
 
+/* Wraps a plain pointer, so the elements are contiguous. */
+template <typename T>
+struct is_contiguous_iterator< random_access_iterator<T> > : true_type {};
+
+template <typename T>
+inline typename random_access_iterator<T>::pointer
+to_address( const random_access_iterator<T>& it ) {
+  return it.base();
+}
+
 } /* namespace ft */
 
 #endif /* FT_CONTAINERS_RANDOM_ACCESS_ITERATOR_HPP */
\ No newline at end of file
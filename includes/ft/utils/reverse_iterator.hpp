@@ -42,6 +42,11 @@ class reverse_iterator {
     _ptr(x)
   {}
 
+  reverse_iterator(const reverse_iterator& other)
+  :
+    _ptr(other._ptr)
+  {}
+
   template <typename U>
   reverse_iterator(const reverse_iterator<U>& other,
                    typename ft::enable_if<
@@ -0,0 +1,441 @@
+#ifndef FT_CONTAINERS_SIMD_HPP
+# define FT_CONTAINERS_SIMD_HPP
+#pragma once
+
+#include <cstddef> /* std::size_t */
+#include <cstring> /* std::memcpy */
+#include <stdint.h> /* uint8_t ... uint64_t */
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+# define FT_CONTAINERS_X86_SIMD 1
+# include <immintrin.h>
+#endif
+
+/*
+ * Byte kernels behind ft::equal / ft::lexicographical_compare for
+ * contiguous ranges of integers (see utils.hpp).
+ *
+ * mismatch_bytes(a, b, n) returns the index of the first byte where
+ * a and b differ, or n. On x86-64 it is 16 (SSE2, always there) or
+ * 32 (AVX2) bytes per compare : cmpeq gives 0xff for every equal
+ * byte, movemask packs them into one bit each, so the first zero bit
+ * is the first mismatch. See :
+ * https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html
+ *
+ * The AVX2 kernel is compiled with __attribute__((target("avx2")))
+ * so the rest of the build does not need -mavx2, and it is only
+ * picked if the cpu says it has AVX2 (__builtin_cpu_supports), once,
+ * the first time mismatch_bytes runs. Anything else gets the scalar
+ * kernel, 8 bytes at a time.
+ */
+
+namespace ft {
+
+inline std::size_t mismatch_scalar( const unsigned char* a,
+                                    const unsigned char* b,
+                                    std::size_t n ) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    uint64_t x;
+    uint64_t y;
+    std::memcpy(&x, a + i, 8);
+    std::memcpy(&y, b + i, 8);
+    if (x != y) {
+      break;
+    }
+  }
+  while (i < n && a[i] == b[i]) {
+    ++i;
+  }
+  return i;
+}
+
+#ifdef FT_CONTAINERS_X86_SIMD
+
+inline std::size_t mismatch_sse2( const unsigned char* a,
+                                  const unsigned char* b,
+                                  std::size_t n ) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    unsigned equal = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+    if (equal != 0xffffu) {
+      return i + __builtin_ctz(~equal);
+    }
+  }
+  return i + mismatch_scalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t mismatch_avx2( const unsigned char* a,
+                                  const unsigned char* b,
+                                  std::size_t n ) {
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    unsigned equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+    if (equal != 0xffffffffu) {
+      return i + __builtin_ctz(~equal);
+    }
+  }
+  return i + mismatch_sse2(a + i, b + i, n - i);
+}
+
+#endif /* FT_CONTAINERS_X86_SIMD */
+
+typedef std::size_t (*mismatch_kernel)( const unsigned char*,
+                                        const unsigned char*,
+                                        std::size_t );
+
+/* Asked once, the answer does not change while the program runs. */
+inline bool cpu_has_avx2() {
+#ifdef FT_CONTAINERS_X86_SIMD
+  static const bool avx2 = (__builtin_cpu_init(),
+                            __builtin_cpu_supports("avx2") != 0);
+  return avx2;
+#else
+  return false;
+#endif
+}
+
+/* The best kernel this cpu runs. */
+inline mismatch_kernel select_mismatch_kernel() {
+#ifdef FT_CONTAINERS_X86_SIMD
+  if (cpu_has_avx2()) {
+    return mismatch_avx2;
+  }
+  return mismatch_sse2;
+#else
+  return mismatch_scalar;
+#endif
+}
+
+inline std::size_t mismatch_bytes( const unsigned char* a,
+                                   const unsigned char* b,
+                                   std::size_t n ) {
+  if (n < 16) {                       // not worth the indirect call
+    return mismatch_scalar(a, b, n);
+  }
+  static const mismatch_kernel kernel = select_mismatch_kernel();
+  return kernel(a, b, n);
+}
+
+/*
+ * Element kernels behind ft::find, count, fill, min_element,
+ * max_element and accumulate (see algorithm.hpp), for contiguous
+ * integers. They work on the fixed width type of the same size and
+ * signedness (simd_integer), so char, short, int, long... share
+ * them (see is_simd_aliasable for the types that may) :
+ *
+ *    find / count / fill / accumulate   any width, unsigned view
+ *    min / max                          1, 2 and 4 bytes, AVX2 has
+ *                                       no 64 bit min / max
+ *
+ * Each one has a scalar version (any cpu) and an AVX2 one, 32 bytes
+ * per step, that the caller picks with cpu_has_avx2(). SSE2 is left
+ * to the compiler, which vectorizes the scalar loops for it.
+ */
+template < std::size_t Size, bool Signed >
+struct simd_integer {};
+
+template <> struct simd_integer<1, false> { typedef uint8_t  type; };
+template <> struct simd_integer<2, false> { typedef uint16_t type; };
+template <> struct simd_integer<4, false> { typedef uint32_t type; };
+template <> struct simd_integer<8, false> { typedef uint64_t type; };
+template <> struct simd_integer<1, true>  { typedef int8_t   type; };
+template <> struct simd_integer<2, true>  { typedef int16_t  type; };
+template <> struct simd_integer<4, true>  { typedef int32_t  type; };
+template <> struct simd_integer<8, true>  { typedef int64_t  type; };
+
+template < typename U >
+inline std::size_t find_scalar( const U* p, std::size_t n, U value ) {
+  std::size_t i = 0;
+  while (i < n && p[i] != value) {
+    ++i;
+  }
+  return i;
+}
+
+template < typename U >
+inline std::size_t count_scalar( const U* p, std::size_t n, U value ) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    count += (p[i] == value);
+  }
+  return count;
+}
+
+template < typename U >
+inline void fill_scalar( U* p, std::size_t n, U value ) {
+  for (std::size_t i = 0; i < n; ++i) {
+    p[i] = value;
+  }
+}
+
+/* Smallest (Max false) or largest (Max true) value of p[0, n), n > 0. */
+template < bool Max, typename U >
+inline U extremum_scalar( const U* p, std::size_t n ) {
+  U best = p[0];
+  for (std::size_t i = 1; i < n; ++i) {
+    if (Max ? best < p[i] : p[i] < best) {
+      best = p[i];
+    }
+  }
+  return best;
+}
+
+/* Wrapping sum, U is unsigned. */
+template < typename U >
+inline U sum_scalar( const U* p, std::size_t n ) {
+  U sum = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    sum = U(sum + p[i]);
+  }
+  return sum;
+}
+
+#ifdef FT_CONTAINERS_X86_SIMD
+
+# define FT_AVX2 __attribute__((target("avx2")))
+
+/* Lane-width dispatch, the overload is picked by the third argument. */
+FT_AVX2 inline __m256i simd_cmpeq( __m256i a, __m256i b, uint8_t ) {
+  return _mm256_cmpeq_epi8(a, b);
+}
+FT_AVX2 inline __m256i simd_cmpeq( __m256i a, __m256i b, uint16_t ) {
+  return _mm256_cmpeq_epi16(a, b);
+}
+FT_AVX2 inline __m256i simd_cmpeq( __m256i a, __m256i b, uint32_t ) {
+  return _mm256_cmpeq_epi32(a, b);
+}
+FT_AVX2 inline __m256i simd_cmpeq( __m256i a, __m256i b, uint64_t ) {
+  return _mm256_cmpeq_epi64(a, b);
+}
+
+FT_AVX2 inline __m256i simd_add( __m256i a, __m256i b, uint8_t ) {
+  return _mm256_add_epi8(a, b);
+}
+FT_AVX2 inline __m256i simd_add( __m256i a, __m256i b, uint16_t ) {
+  return _mm256_add_epi16(a, b);
+}
+FT_AVX2 inline __m256i simd_add( __m256i a, __m256i b, uint32_t ) {
+  return _mm256_add_epi32(a, b);
+}
+FT_AVX2 inline __m256i simd_add( __m256i a, __m256i b, uint64_t ) {
+  return _mm256_add_epi64(a, b);
+}
+
+template < bool Max >
+struct simd_pick {};
+
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, int8_t,
+                                      simd_pick<false> ) {
+  return _mm256_min_epi8(a, b);
+}
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, uint8_t,
+                                      simd_pick<false> ) {
+  return _mm256_min_epu8(a, b);
+}
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, int16_t,
+                                      simd_pick<false> ) {
+  return _mm256_min_epi16(a, b);
+}
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, uint16_t,
+                                      simd_pick<false> ) {
+  return _mm256_min_epu16(a, b);
+}
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, int32_t,
+                                      simd_pick<false> ) {
+  return _mm256_min_epi32(a, b);
+}
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, uint32_t,
+                                      simd_pick<false> ) {
+  return _mm256_min_epu32(a, b);
+}
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, int8_t,
+                                      simd_pick<true> ) {
+  return _mm256_max_epi8(a, b);
+}
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, uint8_t,
+                                      simd_pick<true> ) {
+  return _mm256_max_epu8(a, b);
+}
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, int16_t,
+                                      simd_pick<true> ) {
+  return _mm256_max_epi16(a, b);
+}
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, uint16_t,
+                                      simd_pick<true> ) {
+  return _mm256_max_epu16(a, b);
+}
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, int32_t,
+                                      simd_pick<true> ) {
+  return _mm256_max_epi32(a, b);
+}
+FT_AVX2 inline __m256i simd_extremum( __m256i a, __m256i b, uint32_t,
+                                      simd_pick<true> ) {
+  return _mm256_max_epu32(a, b);
+}
+
+FT_AVX2 inline __m256i simd_load( const void* p ) {
+  return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+}
+
+/* value in every lane. */
+template < typename U >
+FT_AVX2 inline __m256i simd_broadcast( U value ) {
+  U lanes[32 / sizeof(U)];
+  for (std::size_t i = 0; i < 32 / sizeof(U); ++i) {
+    lanes[i] = value;
+  }
+  return simd_load(lanes);
+}
+
+template < typename U >
+FT_AVX2 inline std::size_t find_avx2( const U* p, std::size_t n, U value ) {
+  const std::size_t lanes = 32 / sizeof(U);
+  __m256i needle = simd_broadcast(value);
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    __m256i equal = simd_cmpeq(simd_load(p + i), needle, U());
+    unsigned mask = _mm256_movemask_epi8(equal);
+    if (mask) {
+      return i + __builtin_ctz(mask) / sizeof(U);
+    }
+  }
+  return i + find_scalar(p + i, n - i, value);
+}
+
+/* Each equal lane sets sizeof(U) mask bits. */
+template < typename U >
+FT_AVX2 inline std::size_t count_avx2( const U* p, std::size_t n, U value ) {
+  const std::size_t lanes = 32 / sizeof(U);
+  __m256i needle = simd_broadcast(value);
+  std::size_t bits = 0;
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    __m256i equal = simd_cmpeq(simd_load(p + i), needle, U());
+    bits += __builtin_popcount(_mm256_movemask_epi8(equal));
+  }
+  return bits / sizeof(U) + count_scalar(p + i, n - i, value);
+}
+
+template < typename U >
+FT_AVX2 inline void fill_avx2( U* p, std::size_t n, U value ) {
+  const std::size_t lanes = 32 / sizeof(U);
+  __m256i pattern = simd_broadcast(value);
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + i), pattern);
+  }
+  fill_scalar(p + i, n - i, value);
+}
+
+template < bool Max, typename U >
+FT_AVX2 inline U extremum_avx2( const U* p, std::size_t n ) {
+  const std::size_t lanes = 32 / sizeof(U);
+  if (n < lanes) {
+    return extremum_scalar<Max>(p, n);
+  }
+  __m256i best = simd_load(p);
+  std::size_t i = lanes;
+  for (; i + lanes <= n; i += lanes) {
+    best = simd_extremum(best, simd_load(p + i), U(), simd_pick<Max>());
+  }
+  U lane[32 / sizeof(U)];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), best);
+  U result = extremum_scalar<Max>(lane, lanes);
+  if (i < n) {
+    U tail = extremum_scalar<Max>(p + i, n - i);
+    if (Max ? result < tail : tail < result) {
+      result = tail;
+    }
+  }
+  return result;
+}
+
+/* No 64 bit lanes for min / max in AVX2. */
+template < bool Max >
+inline int64_t extremum_avx2( const int64_t* p, std::size_t n ) {
+  return extremum_scalar<Max>(p, n);
+}
+
+template < bool Max >
+inline uint64_t extremum_avx2( const uint64_t* p, std::size_t n ) {
+  return extremum_scalar<Max>(p, n);
+}
+
+template < typename U >
+FT_AVX2 inline U sum_avx2( const U* p, std::size_t n ) {
+  const std::size_t lanes = 32 / sizeof(U);
+  __m256i sum = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    sum = simd_add(sum, simd_load(p + i), U());
+  }
+  U lane[32 / sizeof(U)];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), sum);
+  return U(sum_scalar(lane, lanes) + sum_scalar(p + i, n - i));
+}
+
+# undef FT_AVX2
+
+#endif /* FT_CONTAINERS_X86_SIMD */
+
+/* The entry points : AVX2 when the cpu has it, scalar otherwise. */
+template < typename U >
+inline std::size_t simd_find( const U* p, std::size_t n, U value ) {
+#ifdef FT_CONTAINERS_X86_SIMD
+  if (cpu_has_avx2()) {
+    return find_avx2(p, n, value);
+  }
+#endif
+  return find_scalar(p, n, value);
+}
+
+template < typename U >
+inline std::size_t simd_count( const U* p, std::size_t n, U value ) {
+#ifdef FT_CONTAINERS_X86_SIMD
+  if (cpu_has_avx2()) {
+    return count_avx2(p, n, value);
+  }
+#endif
+  return count_scalar(p, n, value);
+}
+
+template < typename U >
+inline void simd_fill( U* p, std::size_t n, U value ) {
+#ifdef FT_CONTAINERS_X86_SIMD
+  if (cpu_has_avx2()) {
+    fill_avx2(p, n, value);
+    return ;
+  }
+#endif
+  fill_scalar(p, n, value);
+}
+
+template < bool Max, typename U >
+inline U simd_extremum_value( const U* p, std::size_t n ) {
+#ifdef FT_CONTAINERS_X86_SIMD
+  if (cpu_has_avx2()) {
+    return extremum_avx2<Max>(p, n);
+  }
+#endif
+  return extremum_scalar<Max>(p, n);
+}
+
+template < typename U >
+inline U simd_sum( const U* p, std::size_t n ) {
+#ifdef FT_CONTAINERS_X86_SIMD
+  if (cpu_has_avx2()) {
+    return sum_avx2(p, n);
+  }
+#endif
+  return sum_scalar(p, n);
+}
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_SIMD_HPP */
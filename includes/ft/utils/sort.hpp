@@ -0,0 +1,556 @@
+#ifndef FT_CONTAINERS_SORT_HPP
+# define FT_CONTAINERS_SORT_HPP
+#pragma once
+
+#include <cstddef> /* std::size_t */
+#include <cstring> /* std::memset */
+#include <functional> /* std::less */
+#include <memory> /* std::allocator */
+#include <pthread.h>
+#include <unistd.h> /* sysconf */
+#include "ft/utils/iterator_traits.hpp"
+#include "ft/utils/utils.hpp"
+#include "ft/utils/heap.hpp"
+#include "ft/utils/simd.hpp"
+
+/*
+ * Sorting, for random access ranges (ft::vector, ft::deque, arrays).
+ * See :
+ * https://en.cppreference.com/w/cpp/algorithm/sort
+ * https://en.cppreference.com/w/cpp/algorithm/stable_sort
+ *
+ *  + sort : introsort. Quicksort on a median of three pivot, down to
+ *    runs of sort_insertion_cutoff elements, that one insertion sort
+ *    pass finishes at the end. A partition that goes too deep
+ *    (2 log2 n) is heap sorted instead, so the worst case stays
+ *    O(n log n). Not stable, no allocation.
+ *
+ *  + stable_sort : top-down merge sort, runs of stable_sort_run
+ *    elements insertion sorted, merges through a buffer of n / 2
+ *    elements. Two halves already in order are not merged at all, so
+ *    sorted input is O(n).
+ *
+ *  + radix_sort : ascending LSD radix sort, one byte per pass, for
+ *    integers (is_integral). All the byte histograms are counted in a
+ *    single first pass, and a byte that is the same in every key is
+ *    skipped, so small keys in wide types cost fewer passes. Needs a
+ *    buffer of n elements. Other types, and short ranges, go to sort.
+ *
+ *  + parallel_sort : sort on up to one thread per cpu, each thread
+ *    sorting one chunk, then rounds of pairwise merges, in parallel
+ *    too, between the range and a buffer of n elements. Below
+ *    parallel_sort_grain elements per thread it is just sort. comp is
+ *    shared by the threads : it must not throw, nor hold state it
+ *    changes.
+ *
+ * The buffers are copies of the range, so the elements must be copy
+ * constructible, as they are for std::stable_sort.
+ */
+
+namespace ft {
+
+static const long sort_insertion_cutoff = 16;
+static const long stable_sort_run = 32;
+static const long radix_sort_cutoff = 256;
+static const long parallel_sort_grain = 1 << 14;
+static const unsigned parallel_sort_max_threads = 64;
+
+/*
+ * Scratch space for the sorts : count copies of the elements from
+ * first on, destroyed with the buffer.
+ */
+template < typename T >
+class sort_buffer {
+
+  std::allocator<T> _alloc;
+  T*                _data;
+  std::size_t       _size;
+  std::size_t       _capacity;
+
+  sort_buffer( const sort_buffer& );
+  sort_buffer& operator=( const sort_buffer& );
+
+  public:
+
+  template < class It >
+  sort_buffer( It first, std::size_t count )
+  : _data(_alloc.allocate(count)), _size(0), _capacity(count) {
+    try {
+      for (; _size < count; ++_size, ++first) {
+        _alloc.construct(_data + _size, *first);
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  ~sort_buffer() {
+    clear();
+  }
+
+  T* data() { return _data; }
+
+  private:
+
+  void clear() {
+    for (std::size_t i = 0; i < _size; ++i) {
+      _alloc.destroy(_data + i);
+    }
+    _alloc.deallocate(_data, _capacity);
+  }
+};
+
+/* Moves the element at last down until the one before is not greater.
+ * Something before it must not be greater (the "unguarded"). */
+template< class RandomIt, class Compare >
+void unguarded_linear_insert( RandomIt last, Compare comp ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  Value value(FT_MOVE(*last));
+  RandomIt prev = last - 1;
+  while (comp(value, *prev)) {
+    *last = FT_MOVE(*prev);
+    last = prev;
+    --prev;
+  }
+  *last = FT_MOVE(value);
+}
+
+/* Stable, O(n^2) : only for short or nearly sorted ranges. */
+template< class RandomIt, class Compare >
+void insertion_sort( RandomIt first, RandomIt last, Compare comp ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  if (first == last) {
+    return ;
+  }
+  for (RandomIt it = first + 1; it != last; ++it) {
+    if (comp(*it, *first)) {
+      Value value(FT_MOVE(*it));
+      for (RandomIt hole = it; hole != first; --hole) {
+        *hole = FT_MOVE(*(hole - 1));
+      }
+      *first = FT_MOVE(value);
+    } else {
+      ft::unguarded_linear_insert(it, comp);
+    }
+  }
+}
+
+/* The median of *a, *b, *c goes to *result. */
+template< class RandomIt, class Compare >
+void move_median_to_first( RandomIt result, RandomIt a, RandomIt b,
+                           RandomIt c, Compare comp )
+{
+  if (comp(*a, *b)) {
+    if (comp(*b, *c)) {
+      ft::iter_swap(result, b);
+    } else if (comp(*a, *c)) {
+      ft::iter_swap(result, c);
+    } else {
+      ft::iter_swap(result, a);
+    }
+  } else if (comp(*a, *c)) {
+    ft::iter_swap(result, a);
+  } else if (comp(*b, *c)) {
+    ft::iter_swap(result, c);
+  } else {
+    ft::iter_swap(result, b);
+  }
+}
+
+/*
+ * Hoare partition around *pivot, which is outside [first, last).
+ * Elements equal to the pivot stop both scans and get swapped, so
+ * runs of equal keys are split evenly instead of going quadratic.
+ */
+template< class RandomIt, class Compare >
+RandomIt unguarded_partition( RandomIt first, RandomIt last,
+                              RandomIt pivot, Compare comp )
+{
+  for (;;) {
+    while (comp(*first, *pivot)) {
+      ++first;
+    }
+    --last;
+    while (comp(*pivot, *last)) {
+      --last;
+    }
+    if (!(first < last)) {
+      return first;
+    }
+    ft::iter_swap(first, last);
+    ++first;
+  }
+}
+
+/*
+ * Leaves runs of at most sort_insertion_cutoff elements, each one
+ * holding no element smaller than any of the run before it. Recurses
+ * on the smaller side and loops on the larger one : O(log n) stack.
+ */
+template< class RandomIt, class Size, class Compare >
+void introsort_loop( RandomIt first, RandomIt last, Size depth,
+                     Compare comp )
+{
+  while (last - first > sort_insertion_cutoff) {
+    if (depth == 0) {
+      ft::make_heap(first, last, comp);
+      ft::sort_heap(first, last, comp);
+      return ;
+    }
+    --depth;
+    RandomIt mid = first + (last - first) / 2;
+    ft::move_median_to_first(first, first + 1, mid, last - 1, comp);
+    RandomIt cut = ft::unguarded_partition(first + 1, last, first, comp);
+    if (cut - first < last - cut) {
+      ft::introsort_loop(first, cut, depth, comp);
+      first = cut;
+    } else {
+      ft::introsort_loop(cut, last, depth, comp);
+      last = cut;
+    }
+  }
+}
+
+/* The smallest element is in the first run : past it, no guard. */
+template< class RandomIt, class Compare >
+void final_insertion_sort( RandomIt first, RandomIt last, Compare comp ) {
+  if (last - first > sort_insertion_cutoff) {
+    ft::insertion_sort(first, first + sort_insertion_cutoff, comp);
+    for (RandomIt it = first + sort_insertion_cutoff; it != last; ++it) {
+      ft::unguarded_linear_insert(it, comp);
+    }
+  } else {
+    ft::insertion_sort(first, last, comp);
+  }
+}
+
+template< class RandomIt, class Compare >
+void sort( RandomIt first, RandomIt last, Compare comp ) {
+  typedef typename ft::iterator_traits<RandomIt>::difference_type Distance;
+  Distance len = last - first;
+  if (len < 2) {
+    return ;
+  }
+  Distance depth = 0;
+  for (Distance n = len; n > 1; n >>= 1) {
+    depth += 2;
+  }
+  ft::introsort_loop(first, last, depth, comp);
+  ft::final_insertion_sort(first, last, comp);
+}
+
+template< class RandomIt >
+void sort( RandomIt first, RandomIt last ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  ft::sort(first, last, std::less<Value>());
+}
+
+/*
+ * [buf, buf_end) and [mid, last) are sorted, [out, mid) is free :
+ * merges both into out. On ties the buffer (the left half) goes
+ * first, which keeps the sort stable. When the buffer runs out, what
+ * is left of the right half is already in place.
+ */
+template< class T, class RandomIt, class Compare >
+void merge_from_buffer( T* buf, T* buf_end, RandomIt mid, RandomIt last,
+                        RandomIt out, Compare comp )
+{
+  while (buf != buf_end) {
+    if (mid == last) {
+      for (; buf != buf_end; ++buf, ++out) {
+        *out = FT_MOVE(*buf);
+      }
+      return ;
+    }
+    if (comp(*mid, *buf)) {
+      *out = FT_MOVE(*mid);
+      ++mid;
+    } else {
+      *out = FT_MOVE(*buf);
+      ++buf;
+    }
+    ++out;
+  }
+}
+
+template< class RandomIt, class T, class Compare >
+void stable_sort_loop( RandomIt first, RandomIt last, T* buf,
+                       Compare comp )
+{
+  if (last - first <= stable_sort_run) {
+    ft::insertion_sort(first, last, comp);
+    return ;
+  }
+  RandomIt mid = first + (last - first) / 2;
+  ft::stable_sort_loop(first, mid, buf, comp);
+  ft::stable_sort_loop(mid, last, buf, comp);
+  if (!comp(*mid, *(mid - 1))) {
+    return ;
+  }
+  T* buf_end = buf;
+  for (RandomIt it = first; it != mid; ++it, ++buf_end) {
+    *buf_end = FT_MOVE(*it);
+  }
+  ft::merge_from_buffer(buf, buf_end, mid, last, first, comp);
+}
+
+template< class RandomIt, class Compare >
+void stable_sort( RandomIt first, RandomIt last, Compare comp ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  if (last - first <= stable_sort_run) {
+    ft::insertion_sort(first, last, comp);
+    return ;
+  }
+  sort_buffer<Value> buffer(first, (last - first) / 2);
+  ft::stable_sort_loop(first, last, buffer.data(), comp);
+}
+
+template< class RandomIt >
+void stable_sort( RandomIt first, RandomIt last ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  ft::stable_sort(first, last, std::less<Value>());
+}
+
+/*
+ * One counting sort pass on the byte at shift, from [from, to) into
+ * out. offsets holds where each byte value starts in out.
+ */
+template< class Src, class Dst, class Key >
+void radix_scatter( Src from, Src to, Dst out, std::size_t* offsets,
+                    unsigned shift, Key flip )
+{
+  for (; from != to; ++from) {
+    Key key = Key(*from) ^ flip;
+    out[offsets[(key >> shift) & 0xff]++] = *from;
+  }
+}
+
+template< class RandomIt >
+void radix_sort_dispatch( RandomIt first, RandomIt last, false_type ) {
+  ft::sort(first, last);
+}
+
+/*
+ * The keys are the elements seen as unsigned integers of the same
+ * width, with the sign bit flipped for signed types : that maps
+ * the signed order onto the unsigned one.
+ */
+template< class RandomIt >
+void radix_sort_dispatch( RandomIt first, RandomIt last, true_type ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type  Value;
+  typedef typename simd_integer<sizeof(Value), false>::type   Key;
+  static const unsigned digits = sizeof(Value);
+
+  std::size_t len = last - first;
+  if (len < std::size_t(radix_sort_cutoff)) {
+    ft::sort(first, last);
+    return ;
+  }
+  const Key flip = is_signed_integer<Value>::value
+                   ? Key(Key(1) << (digits * 8 - 1)) : Key(0);
+
+  std::size_t counts[digits][256];
+  std::memset(counts, 0, sizeof(counts));
+  for (RandomIt it = first; it != last; ++it) {
+    Key key = Key(*it) ^ flip;
+    for (unsigned d = 0; d < digits; ++d) {
+      ++counts[d][(key >> (d * 8)) & 0xff];
+    }
+  }
+
+  const Key some_key = Key(*first) ^ flip;
+  sort_buffer<Value> buffer(first, len);
+  Value* buf = buffer.data();
+  bool in_buffer = false;
+  for (unsigned d = 0; d < digits; ++d) {
+    unsigned shift = d * 8;
+    if (counts[d][(some_key >> shift) & 0xff] == len) {
+      continue;
+    }
+    std::size_t offsets[256];
+    std::size_t offset = 0;
+    for (unsigned byte = 0; byte < 256; ++byte) {
+      offsets[byte] = offset;
+      offset += counts[d][byte];
+    }
+    if (in_buffer) {
+      ft::radix_scatter(buf, buf + len, first, offsets, shift, flip);
+    } else {
+      ft::radix_scatter(first, last, buf, offsets, shift, flip);
+    }
+    in_buffer = !in_buffer;
+  }
+  if (in_buffer) {
+    for (std::size_t i = 0; i < len; ++i) {
+      first[i] = buf[i];
+    }
+  }
+}
+
+template< class RandomIt >
+void radix_sort( RandomIt first, RandomIt last ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  ft::radix_sort_dispatch(first, last, is_integral<Value>());
+}
+
+/* What parallel_sort runs on when not told : the online cpus. */
+inline unsigned parallel_sort_threads() {
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  return cpus > 0 ? unsigned(cpus) : 1;
+}
+
+template< class RandomIt, class Compare >
+struct sort_task {
+  RandomIt first;
+  RandomIt last;
+  Compare* comp;
+
+  void operator()() {
+    ft::sort(first, last, *comp);
+  }
+};
+
+/* Stable merge of [first, mid) and [mid, last) into out. */
+template< class Src, class Dst, class Compare >
+struct merge_task {
+  Src      first;
+  Src      mid;
+  Src      last;
+  Dst      out;
+  Compare* comp;
+
+  void operator()() {
+    Src right = mid;
+    while (first != mid && right != last) {
+      if ((*comp)(*right, *first)) {
+        *out = FT_MOVE(*right);
+        ++right;
+      } else {
+        *out = FT_MOVE(*first);
+        ++first;
+      }
+      ++out;
+    }
+    for (; first != mid; ++first, ++out) {
+      *out = FT_MOVE(*first);
+    }
+    for (; right != last; ++right, ++out) {
+      *out = FT_MOVE(*right);
+    }
+  }
+};
+
+template< class Task >
+void* run_sort_task( void* task ) {
+  (*static_cast<Task*>(task))();
+  return NULL;
+}
+
+/*
+ * One thread per task, the last task on the calling thread. A task
+ * whose thread cannot be created runs on the calling thread too.
+ */
+template< class Task >
+void run_sort_tasks( Task* tasks, unsigned count ) {
+  pthread_t threads[parallel_sort_max_threads];
+  bool      started[parallel_sort_max_threads];
+  for (unsigned i = 0; i + 1 < count; ++i) {
+    started[i] = pthread_create(&threads[i], NULL, run_sort_task<Task>,
+                                &tasks[i]) == 0;
+    if (!started[i]) {
+      tasks[i]();
+    }
+  }
+  tasks[count - 1]();
+  for (unsigned i = 0; i + 1 < count; ++i) {
+    if (started[i]) {
+      pthread_join(threads[i], NULL);
+    }
+  }
+}
+
+/* Merges the runs of src two by two into dst, runs of width chunks. */
+template< class Src, class Dst, class Distance, class Compare >
+void parallel_merge_round( Src src, Dst dst, const Distance* bounds,
+                           unsigned chunks, unsigned width, Compare* comp )
+{
+  merge_task<Src, Dst, Compare> tasks[parallel_sort_max_threads];
+  unsigned count = 0;
+  for (unsigned i = 0; i < chunks; i += 2 * width) {
+    unsigned mid = i + width < chunks ? i + width : chunks;
+    unsigned end = i + 2 * width < chunks ? i + 2 * width : chunks;
+    tasks[count].first = src + bounds[i];
+    tasks[count].mid = src + bounds[mid];
+    tasks[count].last = src + bounds[end];
+    tasks[count].out = dst + bounds[i];
+    tasks[count].comp = comp;
+    ++count;
+  }
+  ft::run_sort_tasks(tasks, count);
+}
+
+template< class RandomIt, class Compare >
+void parallel_sort( RandomIt first, RandomIt last, Compare comp,
+                    unsigned threads )
+{
+  typedef typename ft::iterator_traits<RandomIt>::difference_type Distance;
+  typedef typename ft::iterator_traits<RandomIt>::value_type      Value;
+
+  Distance len = last - first;
+  if (threads > parallel_sort_max_threads) {
+    threads = parallel_sort_max_threads;
+  }
+  if (Distance(threads) > len / parallel_sort_grain) {
+    threads = unsigned(len / parallel_sort_grain);
+  }
+  if (threads < 2) {
+    ft::sort(first, last, comp);
+    return ;
+  }
+
+  Distance bounds[parallel_sort_max_threads + 1];
+  sort_task<RandomIt, Compare> sorts[parallel_sort_max_threads];
+  for (unsigned i = 0; i <= threads; ++i) {
+    bounds[i] = len / threads * i + (len % threads) * i / threads;
+  }
+  for (unsigned i = 0; i < threads; ++i) {
+    sorts[i].first = first + bounds[i];
+    sorts[i].last = first + bounds[i + 1];
+    sorts[i].comp = &comp;
+  }
+  ft::run_sort_tasks(sorts, threads);
+
+  sort_buffer<Value> buffer(first, len);
+  Value* buf = buffer.data();
+  bool in_buffer = false;
+  for (unsigned width = 1; width < threads; width *= 2) {
+    if (in_buffer) {
+      ft::parallel_merge_round(buf, first, bounds, threads, width, &comp);
+    } else {
+      ft::parallel_merge_round(first, buf, bounds, threads, width, &comp);
+    }
+    in_buffer = !in_buffer;
+  }
+  if (in_buffer) {
+    for (Distance i = 0; i < len; ++i) {
+      first[i] = FT_MOVE(buf[i]);
+    }
+  }
+}
+
+template< class RandomIt, class Compare >
+void parallel_sort( RandomIt first, RandomIt last, Compare comp ) {
+  ft::parallel_sort(first, last, comp, ft::parallel_sort_threads());
+}
+
+template< class RandomIt >
+void parallel_sort( RandomIt first, RandomIt last ) {
+  typedef typename ft::iterator_traits<RandomIt>::value_type Value;
+  ft::parallel_sort(first, last, std::less<Value>(),
+                    ft::parallel_sort_threads());
+}
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_SORT_HPP */
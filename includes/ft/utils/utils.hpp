@@ -2,7 +2,31 @@
 # define FT_CONTAINERS_UTILS_HPP
 #pragma once
 
+#include <iterator> /* std::random_access_iterator_tag */
+#include <cstring> /* std::memcmp */
 #include "ft/utils/iterator_traits.hpp"
+#include "ft/utils/simd.hpp"
+
+/*
+ * C++11 mode.
+ * The library is C++98, but when it is compiled as C++11 or later
+ * (make cxx11) the containers also get move constructors and move
+ * assignment, emplace and friends, all behind FT_CONTAINERS_CXX11.
+ * FT_MOVE lets code shared by both modes move where it can (element
+ * relocation, shifting, swap) and copy otherwise.
+ * FT_MOVE_IF_NOEXCEPT is for reallocation, where a throwing move
+ * would lose the strong guarantee, so copying is preferred then.
+ */
+#if __cplusplus >= 201103L
+# define FT_CONTAINERS_CXX11 1
+# include <utility> /* std::move, std::forward, std::move_if_noexcept */
+# include <type_traits> /* is_convertible, is_nothrow_* */
+# define FT_MOVE(x) std::move(x)
+# define FT_MOVE_IF_NOEXCEPT(x) std::move_if_noexcept(x)
+#else
+# define FT_MOVE(x) (x)
+# define FT_MOVE_IF_NOEXCEPT(x) (x)
+#endif
 
 namespace ft {
 
@@ -87,6 +111,9 @@ struct is_integral<bool> : true_type {};
 template <>
 struct is_integral<char> : true_type {};
 
+template <>
+struct is_integral<signed char> : true_type {};
+
 template <>
 struct is_integral<unsigned char> : true_type {};
 
@@ -108,6 +135,172 @@ struct is_integral<long> : true_type {};
 template <>
 struct is_integral<unsigned long> : true_type {};
 
+template <>
+struct is_integral<long long> : true_type {};
+
+template <>
+struct is_integral<unsigned long long> : true_type {};
+
+template <typename T>
+struct remove_const { typedef T type; };
+
+template <typename T>
+struct remove_const<const T> { typedef T type; };
+
+/*
+ * bool_constant
+ *
+ * Turns a compile time boolean into true_type / false_type, so
+ * traits computed from an expression can be used as dispatch tags
+ * the same way as is_integer.
+ */
+template <bool B>
+struct bool_constant : false_type {};
+
+template <>
+struct bool_constant<true> : true_type {};
+
+/*
+ * is_signed_integer
+ *
+ * For integral T only : whether -1 survives the conversion to T.
+ */
+template < typename T >
+struct is_signed_integer : bool_constant<(T(-1) < T(0))> {};
+
+/*
+ * is_trivial
+ *
+ * See:
+ * https://en.cppreference.com/w/cpp/types/is_trivial
+ *
+ * Trivial types can be left uninitialized and copied with memcpy.
+ * This cannot be written by hand in C++98, but both gcc and clang
+ * expose what the compiler knows through __is_trivial.
+ */
+template <typename T>
+struct is_trivial : bool_constant<__is_trivial(T)> {};
+
+/*
+ * is_trivially_copyable
+ *
+ * See:
+ * https://en.cppreference.com/w/cpp/types/is_trivially_copyable
+ *
+ * Weaker than is_trivial (a default constructor may be user
+ * provided), but enough to copy or relocate objects with memcpy.
+ */
+template <typename T>
+struct is_trivially_copyable : bool_constant<__is_trivially_copyable(T)> {};
+
+/*
+ * is_empty
+ *
+ * See:
+ * https://en.cppreference.com/w/cpp/types/is_empty
+ *
+ * No non-static data members (std::less, std::allocator...). Final
+ * classes are left out, since they cannot be derived from, which is
+ * all this trait is used for (see compressed_pair).
+ */
+template <typename T>
+struct is_empty : bool_constant<__is_empty(T) && !__is_final(T)> {};
+
+/*
+ * is_contiguous_iterator
+ *
+ * True for iterators over elements laid out next to each other in
+ * memory, so [first, last) can be handed to memcpy / memcmp through
+ * ft::to_address(first). Raw pointers here, ft::random_access_iterator
+ * adds itself in its own header.
+ */
+template <typename It>
+struct is_contiguous_iterator : false_type {};
+
+template <typename T>
+struct is_contiguous_iterator<T*> : true_type {};
+
+template <typename T>
+inline T* to_address( T* p ) {
+  return p;
+}
+
+/*
+ * is_bytewise_comparable
+ *
+ * Two contiguous ranges of the same integer type are equal exactly
+ * when their bytes are, and the first differing element is the one
+ * holding the first differing byte. That lets equal and
+ * lexicographical_compare run on memcmp / ft::mismatch_bytes instead
+ * of an element loop. Floating point is left out on purpose :
+ * 0.0 == -0.0 and NaN != NaN do not follow the bytes.
+ */
+template < class It1, class It2 >
+struct is_bytewise_comparable
+  : bool_constant<is_contiguous_iterator<It1>::value
+                  && is_contiguous_iterator<It2>::value
+                  && is_same_type<
+                       typename iterator_traits<It1>::value_type,
+                       typename iterator_traits<It2>::value_type>::value
+                  && is_integral<typename remove_const<
+                       typename iterator_traits<It1>::value_type>::type
+                     >::value>
+{};
+
+/* unsigned char, bool, and char where it is unsigned. */
+template < class It >
+struct is_unsigned_byte
+  : bool_constant<(static_cast<typename remove_const<
+                     typename iterator_traits<It>::value_type>::type>(-1)
+                   > 0)>
+{};
+
+template< class InputIt1, class InputIt2 >
+bool lexicographical_compare_dispatch( InputIt1 first1, InputIt1 last1,
+                                       InputIt2 first2, InputIt2 last2,
+                                       false_type )
+{
+  for (;first1 != last1 && first2 != last2;) {
+    if (*first1 < *first2) {
+      return true;
+    }
+    if (*first2 < *first1) {
+      return false;
+    }
+    ++first2;
+    ++first1;
+  }
+  return (first1 == last1) && (first2 != last2);
+}
+
+/* Finds the first differing byte, then compares its element. */
+template< class It1, class It2 >
+bool lexicographical_compare_dispatch( It1 first1, It1 last1,
+                                       It2 first2, It2 last2,
+                                       true_type )
+{
+  std::size_t size1 = last1 - first1;
+  std::size_t size2 = last2 - first2;
+  std::size_t count = size1 < size2 ? size1 : size2;
+  if (count == 0) {
+    return size1 < size2;
+  }
+  std::size_t width = sizeof(*first1);
+  if (width == 1 && is_unsigned_byte<It1>::value) {
+    // memcmp order is unsigned char order, it says it all
+    int order = std::memcmp(to_address(first1), to_address(first2), count);
+    return order ? order < 0 : size1 < size2;
+  }
+  std::size_t byte = ft::mismatch_bytes(
+    reinterpret_cast<const unsigned char*>(to_address(first1)),
+    reinterpret_cast<const unsigned char*>(to_address(first2)),
+    count * width);
+  if (byte == count * width) {
+    return size1 < size2;
+  }
+  return first1[byte / width] < first2[byte / width];
+}
+
 /* lexicographical_compare
  * https://en.cppreference.com/w/cpp/algorithm/lexicographical_compare
  *
@@ -134,17 +327,9 @@ template< class InputIt1, class InputIt2 >
 bool lexicographical_compare( InputIt1 first1, InputIt1 last1,
                               InputIt2 first2, InputIt2 last2 )
 {
-  for (;first1 != last1 && first2 != last2;) {
-    if (*first1 < *first2) {
-      return true;
-    }
-    if (*first2 < *first1) {
-      return false;
-    }
-    ++first2;
-    ++first1;
-  }
-  return (first1 == last1) && (first2 != last2);
+  typedef is_bytewise_comparable<InputIt1, InputIt2> Bytewise;
+  return lexicographical_compare_dispatch(first1, last1, first2, last2,
+                                          Bytewise());
 }
 
 /* Cpp reference says :
@@ -170,6 +355,32 @@ bool lexicographical_compare( InputIt1 first1, InputIt1 last1,
   return (first1 == last1) && (first2 != last2);
 }
 
+template< class InputIt1, class InputIt2 >
+bool equal_dispatch( InputIt1 first1, InputIt1 last1,
+                     InputIt2 first2, false_type )
+{
+  while (first1 != last1) {
+    if (*first1 != *first2) {
+      return false;
+    }
+    ++first1;
+    ++first2;
+  }
+  return true;
+}
+
+/* libc's memcmp is already vectorized, nothing to win over it. */
+template< class It1, class It2 >
+bool equal_dispatch( It1 first1, It1 last1, It2 first2, true_type )
+{
+  std::size_t count = last1 - first1;
+  // unqualified : to_address of ft iterators is declared later, ADL
+  // finds it at instantiation
+  return count == 0
+         || std::memcmp(to_address(first1), to_address(first2),
+                        count * sizeof(*first1)) == 0;
+}
+
 /*
  * equal
  * 
@@ -213,23 +424,20 @@ template< class InputIt1, class InputIt2 >
 bool equal( InputIt1 first1, InputIt1 last1,
             InputIt2 first2 )
 {
-  while (first1 != last1) {
-    if (*first1 != *first2) {
-      return false;
-    }
-    ++first1;
-    ++first2;
-  }
-  return true;
+  typedef is_bytewise_comparable<InputIt1, InputIt2> Bytewise;
+  return equal_dispatch(first1, last1, first2, Bytewise());
 }
 
 /* distance implementation
  * Abstracion of what normal distance (when speaking about
  * numbers) is.
+ * Random access iterators know it in O(1), anything else has to
+ * walk the range. Dispatch is made on the iterator_category tag,
+ * std tags (iterators from std containers) included.
  */
-template<class It>
+template<class It, class Tag>
 typename ft::iterator_traits<It>::difference_type
-    distance(It first, It last)
+    distance_dispatch(It first, It last, Tag)
 {
     typename ft::iterator_traits<It>::difference_type result = 0;
     while (first != last) {
@@ -239,11 +447,61 @@ typename ft::iterator_traits<It>::difference_type
     return result;
 }
 
+template<class It>
+typename ft::iterator_traits<It>::difference_type
+    distance_dispatch(It first, It last, ft::random_access_iterator_tag)
+{
+    return last - first;
+}
+
+template<class It>
+typename ft::iterator_traits<It>::difference_type
+    distance_dispatch(It first, It last, std::random_access_iterator_tag)
+{
+    return last - first;
+}
+
+template<class It>
+typename ft::iterator_traits<It>::difference_type
+    distance(It first, It last)
+{
+    typedef typename ft::iterator_traits<It>::iterator_category Category;
+    return distance_dispatch(first, last, Category());
+}
+
+/*
+ * True for single pass iterators (input_iterator_tag, ft's or std's,
+ * e.g. std::istream_iterator) : walking the range consumes it, so it
+ * cannot be measured with distance before being read.
+ */
+template< class It >
+struct is_single_pass_iterator
+  : bool_constant<is_same_type<
+                    typename ft::iterator_traits<It>::iterator_category,
+                    ft::input_iterator_tag>::value
+                  || is_same_type<
+                    typename ft::iterator_traits<It>::iterator_category,
+                    std::input_iterator_tag>::value>
+{};
+
 template< typename T>
 void swap( T& x, T& y) {
-  T tmp(x);
-  x = y;
-  y = tmp;
+  T tmp(FT_MOVE(x));
+  x = FT_MOVE(y);
+  y = FT_MOVE(tmp);
+}
+
+/* iter_swap
+ * https://en.cppreference.com/w/cpp/algorithm/iter_swap
+ *
+ * Through a value_type temporary rather than swap( *a, *b ), so it
+ * also works on proxy references (ft::vector<bool>).
+ */
+template< class It1, class It2 >
+void iter_swap( It1 a, It2 b ) {
+  typename ft::iterator_traits<It1>::value_type tmp(FT_MOVE(*a));
+  *a = FT_MOVE(*b);
+  *b = FT_MOVE(tmp);
 }
 
 } /* namespace ft */
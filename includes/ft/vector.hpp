@@ -5,8 +5,10 @@
 #include <memory> /* std::allocator, std::allocator_traits. */
 #include <cstddef> /* std::size_t, std::ptrdiff_t */
 #include <stdexcept>
+#include <cstring> /* memcpy, memmove */
 
 #include "ft/utils/utils.hpp"
+#include "ft/utils/pair.hpp"
 #include "ft/utils/reverse_iterator.hpp"
 #include "ft/utils/random_access_iterator.hpp"
 #include <sys/queue.h>
@@ -101,11 +103,18 @@ class vector {
 
   private:
 
-    allocator_type  _alloc;   // shortcut
+    // set_auto_shrink's flag, and the allocator : an empty one (like
+    // std::allocator) takes no room (see compressed_pair)
+    compressed_pair<bool, allocator_type> _shrink_alloc;
     pointer         _d_start; // where the non-empty data begins
     pointer         _d_end;   // where the empty data begins
     size_type       _capacity;  // allocated objects
 
+    allocator_type& _alloc() { return _shrink_alloc.second(); }
+    const allocator_type& _alloc() const { return _shrink_alloc.second(); }
+    bool& _auto_shrink() { return _shrink_alloc.first(); }
+    bool _auto_shrink() const { return _shrink_alloc.first(); }
+
   /*
     * This function is assumed to never be called when
     * new_capacity = 0 or new_capacity < _capacity.
@@ -148,18 +157,270 @@ class vector {
       init_fill_vector(size);
     } else {
       _capacity = capacity;
-      _d_start = _alloc.allocate(_capacity);
+      _d_start = _alloc().allocate(_capacity);
       _d_end = _d_start;
       while (--size) {
-        _alloc.construct(_d_end, value);
+        _alloc().construct(_d_end, value);
         ++_d_end;
       }
     }
   }
 
+  /*
+   * True when [first, last) of type It can be memcpy'd into this
+   * vector : contiguous memory holding exactly T, T trivially copyable.
+   */
+  template <typename It>
+  struct is_bulk_copyable
+    : bool_constant<ft::is_contiguous_iterator<It>::value
+                    && ft::is_trivially_copyable<T>::value
+                    && ft::is_same_type<
+                         typename ft::iterator_traits<It>::value_type,
+                         T>::value>
+  {};
+
+  typedef typename ft::is_trivially_copyable<T> Relocatable;
+
+  /*
+   * Copy-constructs [first, last) into the raw storage at dest and
+   * returns the end of the copy. If a copy throws, what was already
+   * built is destroyed before rethrowing.
+   */
+  template <typename InputIt>
+  pointer uninitialized_copy( InputIt first, InputIt last,
+                              pointer dest, false_type )
+  {
+    pointer current = dest;
+    try {
+      for (; first != last; ++first, ++current) {
+        _alloc().construct(current, *first);
+      }
+    } catch (...) {
+      while (current != dest) {
+        _alloc().destroy(--current);
+      }
+      throw;
+    }
+    return current;
+  }
+
+  // Same thing, in a single memcpy.
+  template <typename InputIt>
+  pointer uninitialized_copy( InputIt first, InputIt last,
+                              pointer dest, true_type )
+  {
+    size_type count = last - first;
+    if (count) {
+      memcpy(dest, ft::to_address(first), count * sizeof(T));
+    }
+    return dest + count;
+  }
+
+  /*
+   * Relocation flavour of uninitialized_copy, for reallocate : the
+   * source is about to be destroyed, so in C++11 mode its elements
+   * are moved (when moving cannot throw, see FT_MOVE_IF_NOEXCEPT).
+   */
+  pointer uninitialized_move( pointer first, pointer last,
+                              pointer dest, false_type )
+  {
+    pointer current = dest;
+    try {
+      for (; first != last; ++first, ++current) {
+        _alloc().construct(current, FT_MOVE_IF_NOEXCEPT(*first));
+      }
+    } catch (...) {
+      while (current != dest) {
+        _alloc().destroy(--current);
+      }
+      throw;
+    }
+    return current;
+  }
+
+  pointer uninitialized_move( pointer first, pointer last,
+                              pointer dest, true_type )
+  {
+    return uninitialized_copy(first, last, dest, true_type());
+  }
+
+  /*
+   * Moves [first, last) down to dest (dest <= first when the ranges
+   * overlap) and returns the end of the moved range. Elements in
+   * [dest, first) are overwritten, the ones left after the returned
+   * pointer are still alive and up to the caller. Trivially copyable
+   * T is relocated with a single memmove, anything else is assigned
+   * element by element, front to back (move-assigned in C++11 mode).
+   */
+  pointer move_range( pointer dest, pointer first, pointer last ) {
+    if (dest == first) {
+      return last;
+    }
+    return move_range(dest, first, last, Relocatable());
+  }
+
+  pointer move_range( pointer dest, pointer first, pointer last,
+                      true_type )
+  {
+    if (last != first) {
+      memmove(dest, first, (last - first) * sizeof(T));
+    }
+    return dest + (last - first);
+  }
+
+  pointer move_range( pointer dest, pointer first, pointer last,
+                      false_type )
+  {
+    while (first != last) {
+      *dest++ = FT_MOVE(*first++);
+    }
+    return dest;
+  }
+
+  /*
+   * Copy-assigns [first, last), which belongs to another vector, over
+   * the live elements at dest. Returns the end of the copy.
+   */
+  pointer copy_range( pointer dest, const_pointer first,
+                      const_pointer last, true_type )
+  {
+    if (last != first) {
+      memcpy(dest, first, (last - first) * sizeof(T));
+    }
+    return dest + (last - first);
+  }
+
+  pointer copy_range( pointer dest, const_pointer first,
+                      const_pointer last, false_type )
+  {
+    while (first != last) {
+      *dest++ = *first++;
+    }
+    return dest;
+  }
+
+  /* Destroys [new_end, end()) and makes new_end the end. */
+  void destroy_at_end( pointer new_end ) {
+    if (Relocatable::value) {
+      _d_end = new_end;
+      return ;
+    }
+    while (_d_end != new_end) {
+      --_d_end;
+      _alloc().destroy(_d_end);
+    }
+  }
+
+  /*
+   * Moves the contents to a new buffer of exactly new_cap elements
+   * (new_cap >= size()) and releases the old one. Everything is
+   * copied (or moved, see uninitialized_move) before anything is
+   * destroyed, so if a copy throws the vector is left untouched.
+   */
+  void reallocate( size_type new_cap ) {
+    pointer new_start = 0;
+    pointer new_end = 0;
+    if (new_cap) {  // else empty : nothing to move
+      new_start = _alloc().allocate(new_cap);
+      try {
+        new_end = uninitialized_move(_d_start, _d_end, new_start,
+                                     Relocatable());
+      } catch (...) {
+        _alloc().deallocate(new_start, new_cap);
+        throw;
+      }
+    }
+    clear();
+    if (_d_start) {
+      _alloc().deallocate(_d_start, _capacity);
+    }
+    _d_start = new_start;
+    _d_end = new_end;
+    _capacity = new_cap;
+  }
+
+  /*
+   * reallocate(new_cap) that also appends a copy of [first, last).
+   * The copy is made before the old elements are moved out, so the
+   * range may be part of this vector.
+   */
+  template <typename ForwardIt>
+  void reallocate_append( size_type new_cap,
+                          ForwardIt first, ForwardIt last )
+  {
+    pointer new_start = _alloc().allocate(new_cap);
+    pointer middle = new_start + size();
+    pointer new_end = middle;
+    try {
+      new_end = uninitialized_copy(first, last, middle,
+                                   is_bulk_copyable<ForwardIt>());
+      uninitialized_move(_d_start, _d_end, new_start, Relocatable());
+    } catch (...) {
+      while (new_end != middle) {
+        _alloc().destroy(--new_end);
+      }
+      _alloc().deallocate(new_start, new_cap);
+      throw;
+    }
+    clear();
+    if (_d_start) {
+      _alloc().deallocate(_d_start, _capacity);
+    }
+    _d_start = new_start;
+    _d_end = new_end;
+    _capacity = new_cap;
+  }
+
+  template <typename InputIt>
+  void append_dispatch( InputIt first, InputIt last, true_type ) {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  template <typename ForwardIt>
+  void append_dispatch( ForwardIt first, ForwardIt last, false_type ) {
+    size_type new_size = size() + ft::distance(first, last);
+    if (new_size > _capacity) {
+      if (new_size > max_size()) {
+        throw std::length_error("42");
+      }
+      reallocate_append(get_new_capacity(new_size), first, last);
+    } else {
+      typedef is_bulk_copyable<ForwardIt> Bulk;
+      _d_end = uninitialized_copy(first, last, _d_end, Bulk());
+    }
+  }
+
+  /*
+   * Automatic capacity reclamation (only if set_auto_shrink(true)).
+   * Once size() falls below a quarter of the capacity, the capacity
+   * is halved (as many times as needed, in a single reallocation).
+   * push_back grows once it would fill the last free slot
+   * (size() + 1 >= capacity()), and shrinking leaves size() under
+   * half the new capacity, so a push_back / pop_back oscillation
+   * around any size never reallocates twice in a row.
+   * Buffers smaller than auto_shrink_min_capacity are left alone.
+   */
+  void maybe_shrink() {
+    if (!_auto_shrink() || _capacity <= auto_shrink_min_capacity
+        || size() >= _capacity / 4) {
+      return ;
+    }
+    size_type new_cap = _capacity;
+    while (new_cap / 2 >= auto_shrink_min_capacity
+           && size() < new_cap / 4) {
+      new_cap /= 2;
+    }
+    if (new_cap != _capacity) {
+      reallocate(new_cap);
+    }
+  }
+
   /* 
    * Creates a memory hole inside the vector. Used for 
-   * insertion.
+   * insertion. The hole is raw storage, the caller constructs
+   * into it.
    */
   void create_mem_hole_at( size_type pos, size_type hole_size ) {
     
@@ -173,16 +434,27 @@ class vector {
       size_type new_capacity = get_new_capacity(new_size);
       reserve(new_capacity);
     }
-    /* shift end contents hole_size positions positions,
-     * starting from the end to pos
-     */
-    for (size_type i = new_size - 1; i >= pos + hole_size; i--) {
-      _alloc.construct(_d_start + i, _d_start[i - hole_size]);
-      _alloc.destroy(_d_start + i - hole_size);
-    }
+    shift_up(pos, hole_size, Relocatable());
     _d_end += hole_size; // resize
   }
 
+  /* shift end contents hole_size positions positions,
+   * starting from the end to pos
+   */
+  void shift_up( size_type pos, size_type hole_size, false_type ) {
+    for (size_type i = size() + hole_size - 1; i >= pos + hole_size; i--) {
+      _alloc().construct(_d_start + i, FT_MOVE(_d_start[i - hole_size]));
+      _alloc().destroy(_d_start + i - hole_size);
+    }
+  }
+
+  void shift_up( size_type pos, size_type hole_size, true_type ) {
+    if (pos < size()) {
+      memmove(_d_start + pos + hole_size, _d_start + pos,
+              (size() - pos) * sizeof(T));
+    }
+  }
+
   // Must See assign(InputIt first, InputIt last) comment
   template <typename InputIt>
   void assign_dispatch(InputIt first, InputIt last, false_type) {
@@ -209,7 +481,7 @@ class vector {
     difference_type value_pos = pos.base() - _d_start;
     create_mem_hole_at(value_pos, ft::distance(first, last));
     for (size_type i = value_pos; first != last; first++) {
-      _alloc.construct(_d_start + i, *first);
+      _alloc().construct(_d_start + i, *first);
       i++;
     }
     return _d_start + value_pos;
@@ -226,10 +498,10 @@ class vector {
   void constructor_dispatch(InputIt first, InputIt last, false_type) {
     _capacity = (size_type)ft::distance(first, last);
     if (_capacity) {
-      _d_start = _alloc.allocate(_capacity);
+      _d_start = _alloc().allocate(_capacity);
       _d_end = _d_start;
       while (first != last) {
-        _alloc.construct(_d_end, *first);
+        _alloc().construct(_d_end, *first);
         ++_d_end;
         ++first;  
       }
@@ -241,13 +513,30 @@ class vector {
     init_fill_vector((size_type)first, last);
   }
 
+  /*
+   * Adds count default-initialized elements at the end. For trivial
+   * types that means nothing is written at all, the caller is about
+   * to overwrite the storage anyway. Capacity must already be there.
+   */
+  void default_init_at_end( size_type count, true_type ) {
+    _d_end += count;
+  }
+
+  void default_init_at_end( size_type count, false_type ) {
+    const T value = T();
+    while (count--) {
+      _alloc().construct(_d_end, value);
+      ++_d_end;
+    }
+  }
+
   void init_fill_vector(size_type count, const T& value = T()) {
     _capacity = count;
     if (_capacity) {
-      _d_start = _alloc.allocate(_capacity);
+      _d_start = _alloc().allocate(_capacity);
       _d_end = _d_start;
       while (count--) {
-        _alloc.construct(_d_end, value);
+        _alloc().construct(_d_end, value);
         ++_d_end;
       }
     }
@@ -255,12 +544,24 @@ class vector {
 
   public:
 
+  /* Capacity under which the automatic shrink policy does nothing. */
+  static const size_type auto_shrink_min_capacity = 16;
+
   /* Default constructor. Constructs an empty container
     * with a default-constructed allocator.
     */
   vector ()
   :
-    _alloc(allocator_type()),
+    _shrink_alloc(false, allocator_type()),
+    _d_start(0),
+    _d_end(0),
+    _capacity(0)
+  {}
+
+  /* Constructs an empty container with the given allocator. */
+  explicit vector( const Allocator& alloc )
+  :
+    _shrink_alloc(false, alloc),
     _d_start(0),
     _d_end(0),
     _capacity(0)
@@ -272,9 +573,11 @@ class vector {
   explicit vector( size_type count, const T& value = T(),
                   const Allocator& alloc = Allocator() )
   {
-    _alloc = alloc;
+    _alloc() = alloc;
     _d_start = 0;
     _d_end = 0;
+    _capacity = 0;
+    _auto_shrink() = false;
     init_fill_vector(count, value);
   }
 
@@ -289,31 +592,37 @@ class vector {
   vector( InputIt first, InputIt last,
         const Allocator& alloc = Allocator())
   :
-    _alloc(alloc),
+    _shrink_alloc(false, alloc),
     _d_start(0),
-    _d_end(0)
+    _d_end(0),
+    _capacity(0)
   {
     typedef typename ft::is_integer<InputIt> Integer;
     constructor_dispatch(first, last, Integer());
   }
 
+  /*
+   * The copy is right-sized : it allocates other.size() elements,
+   * not other.capacity(), like std::vector does.
+   */
   vector( const vector& other )
   :
-    _alloc(other._alloc),
+    _shrink_alloc(other._shrink_alloc),
     _d_start(0),
     _d_end(0),
-    _capacity(other._capacity)
+    _capacity(0)
   {
-    if (_capacity) {
-      _d_start = _alloc.allocate(_capacity);
-      _d_end = _d_start;
-      _capacity = other._d_end - other._d_start;
-      size_type current = 0;
-      while (_d_end != _d_start + _capacity) {
-        _alloc.construct(_d_end, other[current]);
-        ++_d_end;
-        ++current;
+    size_type count = other.size();
+    if (count) {
+      _d_start = _alloc().allocate(count);
+      try {
+        _d_end = uninitialized_copy(other._d_start, other._d_end,
+                                    _d_start, Relocatable());
+      } catch (...) {
+        _alloc().deallocate(_d_start, count);
+        throw;
       }
+      _capacity = count;
     }
   }
 
@@ -329,29 +638,91 @@ class vector {
   */
   ~vector() {
     clear();
-    _alloc.deallocate(_d_start, _capacity);
+    if (_d_start) {
+      _alloc().deallocate(_d_start, _capacity);
+    }
   }
 
+  /*
+   * If other fits in the current buffer, the elements already here
+   * are reused through copy-assignment, then the rest is constructed
+   * (or the leftovers destroyed). Otherwise a right-sized buffer is
+   * filled before the old one is released, so if a copy throws *this
+   * is left untouched (strong guarantee).
+   * Trivially copyable T goes through memmove / memcpy in all cases.
+   * The auto shrink flag is copied too, as by the copy constructor,
+   * and applied : a big buffer assigned a small vector with the flag
+   * on is shrunk like after an erase.
+   */
   vector& operator=( const vector& other ) {
-    if (this != &other) {
-      /* destroy all elements constructed and deallocate */
+    if (this == &other) {
+      return *this;
+    }
+    size_type count = other.size();
+    if (count > _capacity) {
+      pointer new_start = _alloc().allocate(count);
+      pointer new_end;
+      try {
+        new_end = uninitialized_copy(other._d_start, other._d_end,
+                                     new_start, Relocatable());
+      } catch (...) {
+        _alloc().deallocate(new_start, count);
+        throw;
+      }
       clear();
-      if (other.capacity() > _capacity) {
-        _alloc.deallocate(_d_start, _capacity);
-        _capacity = other.capacity();
-        /* allocate and construct all new elements */
-        _d_start = _alloc.allocate(_capacity);
+      if (_d_start) {
+        _alloc().deallocate(_d_start, _capacity);
       }
-      _d_end = _d_start;
-      size_type current = 0;
-      while (_d_end != _d_start + other.size()) {
-        _alloc.construct(_d_end, other[current]);
-        ++_d_end;
-        ++current;
+      _d_start = new_start;
+      _d_end = new_end;
+      _capacity = count;
+    } else if (count <= size()) {
+      destroy_at_end(copy_range(_d_start, other._d_start, other._d_end,
+                                Relocatable()));
+    } else {
+      pointer reused_end = other._d_start + size();
+      copy_range(_d_start, other._d_start, reused_end, Relocatable());
+      _d_end = uninitialized_copy(reused_end, other._d_end,
+                                  _d_end, Relocatable());
+    }
+    _auto_shrink() = other._auto_shrink();
+    maybe_shrink();
+    return *this;
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  /*
+   * Steals other's buffer, other is left empty (and without one).
+   */
+  vector( vector&& other ) noexcept
+  :
+    _shrink_alloc(std::move(other._shrink_alloc)),
+    _d_start(other._d_start),
+    _d_end(other._d_end),
+    _capacity(other._capacity)
+  {
+    other._d_start = 0;
+    other._d_end = 0;
+    other._capacity = 0;
+  }
+
+  vector& operator=( vector&& other ) noexcept {
+    if (this != &other) {
+      clear();
+      if (_d_start) {
+        _alloc().deallocate(_d_start, _capacity);
       }
+      _shrink_alloc = std::move(other._shrink_alloc);
+      _d_start = other._d_start;
+      _d_end = other._d_end;
+      _capacity = other._capacity;
+      other._d_start = 0;
+      other._d_end = 0;
+      other._capacity = 0;
     }
     return *this;
   }
+#endif
 
   /* Replaces the contents of the container. 
    * Replaces the contents with count copies of value value.
@@ -381,7 +752,7 @@ class vector {
   }
 
   allocator_type get_allocator() const {
-    return _alloc;
+    return _alloc();
   }
 
   /* ------------------------------------------
@@ -516,7 +887,7 @@ class vector {
     * able to hold due to system or library implementation limitations
     */
   size_type max_size() const {
-    return _alloc.max_size();
+    return _alloc().max_size();
   }
 
   /*
@@ -532,26 +903,39 @@ class vector {
     if (new_cap > max_size()) {
       throw std::length_error("42");
     }
-    if (new_cap < _capacity) {
+    if (new_cap <= _capacity) {
       return ;
     }
-    // save current content on aux
-    vector aux(*this);
-    // free then assign and allocate new capacity
-    clear();
-    _alloc.deallocate(_d_start, _capacity);
-    _capacity = new_cap;
-    _d_start = _alloc.allocate(_capacity);
-    _d_end = _d_start;
-    // copy contents back
-    size_type current = 0;
-    while (_d_end != _d_start + aux.size()) {
-      _alloc.construct(_d_end, aux[current]);
-      ++_d_end;
-      ++current;
+    reallocate(new_cap);
+  }
+
+  /*
+   * Non binding request (std) made binding here : capacity() becomes
+   * size(). An empty vector releases its buffer entirely.
+   * See :
+   * https://en.cppreference.com/w/cpp/container/vector/shrink_to_fit
+   */
+  void shrink_to_fit() {
+    if (_capacity > size()) {
+      reallocate(size());
     }
   }
 
+  /*
+   * Turns the automatic shrink policy (see maybe_shrink) on or off.
+   * When on, pop_back, erase and resize give memory back once the
+   * vector is mostly empty. clear() never does (clearing to refill is
+   * the common case), call shrink_to_fit() for that.
+   */
+  void set_auto_shrink( bool enable ) {
+    _auto_shrink() = enable;
+    maybe_shrink();
+  }
+
+  bool auto_shrink() const {
+    return _auto_shrink();
+  }
+
   /*
     * Returns the number of elements that the container has
     * currently allocated space for.
@@ -565,9 +949,13 @@ class vector {
     * After this call, size() returns zero.
     */
   void clear() {
+    if (Relocatable::value) { // trivially copyable => trivial destructor
+      _d_end = _d_start;
+      return ;
+    }
     while (_d_end != _d_start) {
       --_d_end;
-      _alloc.destroy(_d_end);
+      _alloc().destroy(_d_end);
     }
   }
 
@@ -578,7 +966,7 @@ class vector {
   iterator insert( const_iterator pos, const T& value ) {
     difference_type value_pos = pos.base() - _d_start;
     create_mem_hole_at(value_pos, 1);
-    _alloc.construct(_d_start + value_pos, value);
+    _alloc().construct(_d_start + value_pos, value);
     return _d_start + value_pos; 
   }
 
@@ -589,7 +977,7 @@ class vector {
     difference_type value_pos = pos.base() - _d_start;
     create_mem_hole_at(value_pos, count);
     for ( ; count > 0; count--) {
-      _alloc.construct(_d_start + value_pos + count - 1, value);
+      _alloc().construct(_d_start + value_pos + count - 1, value);
     }
     return _d_start + value_pos;
   }
@@ -608,42 +996,97 @@ class vector {
    * Experimentally, capacity does never change with an erase call.
    */
   iterator erase( iterator pos ) {
-    difference_type value_pos = pos.base() - _d_start;
-    size_type current_size = size();
-
-    // erase element at position 
-    _alloc.destroy(_d_start + value_pos);
-    // shift all elements after pos
-    for (size_type i = value_pos; i < current_size - 1; i++) {
-      _alloc.construct(_d_start + i, _d_start[i + 1]);
-      _alloc.destroy(_d_start + i + 1);
-    }
-    --_d_end; // resize
-    return _d_start + value_pos;
+    return erase(pos, pos + 1);
   }
 
   /*
     * Removes elements in range [first, last).
+    * The tail is moved down over the hole (see move_range) and the
+    * now unused last elements are destroyed.
     */
   iterator erase( iterator first, iterator last ) {
     difference_type start = first.base() - _d_start;
-    size_type erase_size = ft::distance(first, last);
+    // protect from first == last
+    if (first != last) {
+      destroy_at_end(move_range(first.base(), last.base(), _d_end));
+      maybe_shrink();
+    }
+    return _d_start + start;
+  }
 
-    // erase all elements from [first, last)
-    for (size_type i = start; first != last; first++) {
-      _alloc.destroy(_d_start + i);
-      ++i;
+  /*
+    * Removes every element for which pred returns true, in a single
+    * pass : pred is called once per element, in order, and each
+    * survivor is moved at most once (runs of survivors at a time,
+    * see move_range). Returns the number of elements removed.
+    * See ft::erase_if / ft::erase for the std (C++20) spelling.
+    */
+  template< class UnaryPredicate >
+  size_type remove_if( UnaryPredicate pred ) {
+    pointer write = _d_start;
+    while (write != _d_end && !pred(*write)) {
+      ++write;
     }
-    // protect from first == last
-    if (erase_size != 0) {
-      // shift all elements after pos erase_size positions
-      for (size_type i = start; i < size() - erase_size; i++) {
-        _alloc.construct(_d_start + i, _d_start[i + erase_size]);
-        _alloc.destroy(_d_start + i + erase_size);
+    if (write == _d_end) {
+      return 0;
+    }
+    pointer read = write + 1;
+    while (read != _d_end) {
+      if (pred(*read)) {
+        ++read;
+        continue;
+      }
+      pointer run = read++;
+      while (read != _d_end && !pred(*read)) {
+        ++read;
+      }
+      write = move_range(write, run, read);
+      if (read != _d_end) {
+        ++read;   // ends the run : already tested, removed
       }
     }
-    _d_end -= erase_size;
-    return _d_start + start;
+    size_type removed = _d_end - write;
+    destroy_at_end(write);
+    maybe_shrink();
+    return removed;
+  }
+
+  /*
+    * Bulk erase by position : removes the elements at the indices in
+    * [first, last), which must be sorted in ascending order (repeated
+    * indices are fine). Survivors between two indices are moved as a
+    * single run, so the whole call is O(size()) no matter how many
+    * indices there are, where a loop of erase(iterator) is
+    * O(size() * count). The range is checked before anything is
+    * touched. Returns the number of elements removed.
+    */
+  template< class ForwardIt >
+  size_type remove_indices( ForwardIt first, ForwardIt last ) {
+    if (first == last) {
+      return 0;
+    }
+    for (ForwardIt it = first, prev = first; it != last; prev = it++) {
+      if (!(size_type(*it) < size())) {
+        throw std::out_of_range("ft::vector::remove_indices");
+      }
+      if (*it < *prev) {
+        throw std::invalid_argument("ft::vector::remove_indices: unsorted");
+      }
+    }
+    size_type prev = *first;
+    pointer write = _d_start + prev;
+    for (++first; first != last; ++first) {
+      size_type index = *first;
+      if (index != prev) {
+        write = move_range(write, _d_start + prev + 1, _d_start + index);
+        prev = index;
+      }
+    }
+    write = move_range(write, _d_start + prev + 1, _d_end);
+    size_type removed = _d_end - write;
+    destroy_at_end(write);
+    maybe_shrink();
+    return removed;
   }
   
   /* 
@@ -656,18 +1099,65 @@ class vector {
       size_type new_capacity = get_new_capacity(size() + 1);
       reserve(new_capacity);
     }
-    _alloc.construct(_d_end, value);
+    _alloc().construct(_d_end, value);
     ++_d_end;
   }
   
+#ifdef FT_CONTAINERS_CXX11
+  void push_back( T&& value ) {
+    emplace_back(std::move(value));
+  }
+
+  /*
+    * Constructs the new last element in place from args. When the
+    * vector has to grow, the element is built before the buffer
+    * moves, so args may refer to elements of this vector.
+    */
+  template< class... Args >
+  reference emplace_back( Args&&... args ) {
+    typedef std::allocator_traits<Allocator> alloc_traits;
+    if (size() + 1 >= _capacity) {
+      T value(std::forward<Args>(args)...);
+      reserve(get_new_capacity(size() + 1));
+      alloc_traits::construct(_alloc(), _d_end, std::move(value));
+    } else {
+      alloc_traits::construct(_alloc(), _d_end, std::forward<Args>(args)...);
+    }
+    ++_d_end;
+    return back();
+  }
+
+  iterator insert( const_iterator pos, T&& value ) {
+    return emplace(pos, std::move(value));
+  }
+
+  /*
+    * Inserts an element built from args before pos. The tail is moved
+    * (not copied) one slot up to make room.
+    */
+  template< class... Args >
+  iterator emplace( const_iterator pos, Args&&... args ) {
+    difference_type value_pos = pos.base() - _d_start;
+    if (pos.base() == _d_end) {
+      emplace_back(std::forward<Args>(args)...);
+    } else {
+      T value(std::forward<Args>(args)...);
+      create_mem_hole_at(value_pos, 1);
+      _alloc().construct(_d_start + value_pos, std::move(value));
+    }
+    return _d_start + value_pos;
+  }
+#endif
+
   /* 
     * Destroys the last element from the vector.
-    * Never changes capacity.
+    * Never changes capacity, unless auto shrink is on.
     */
   void pop_back() {
     if (size()) {
       --_d_end;
-      _alloc.destroy(_d_end);
+      _alloc().destroy(_d_end);
+      maybe_shrink();
     }
   }
 
@@ -680,21 +1170,82 @@ class vector {
       return ;
     } else if (count < size()) {
       for (size_type i = count; i < size(); i++) {
-        _alloc.destroy(_d_start + i);
+        _alloc().destroy(_d_start + i);
       }
       _d_end -= size() - count;
+      maybe_shrink();
     } else {
       if (count > _capacity) {
         size_type new_capacity = get_new_capacity(count);
         reserve(new_capacity);
       }
       for (size_type i = size(); i < count; i++) {
-        _alloc.construct(_d_start + i, value);
+        _alloc().construct(_d_start + i, value);
       }
       _d_end += count - size();
     }
   }
 
+  /*
+    * resize() without the value-initialization : growing a vector of
+    * trivial T (int, char, POD structs ...) only moves the end
+    * pointer, the new elements hold whatever the memory held. Meant
+    * for buffers that are filled right after (read(), decoders...),
+    * so each byte is touched once instead of twice.
+    * For non trivial T this is the same as resize(count).
+    */
+  void resize_default_init( size_type count ) {
+    if (count <= size()) {
+      destroy_at_end(_d_start + count);
+      maybe_shrink();
+      return ;
+    }
+    if (count > _capacity) {
+      reserve(get_new_capacity(count));
+    }
+    typedef typename ft::is_trivial<T> Trivial;
+    default_init_at_end(count - size(), Trivial());
+  }
+
+  /*
+    * Grows the vector by count elements (amortized, like push_back)
+    * and returns a pointer to the first of them, so they can be
+    * written in place :
+    *
+    *    ssize_t n = read(fd, vec.append_uninitialized(4096), 4096);
+    *    vec.resize_default_init(old_size + n);
+    *
+    * For trivial T the new elements are uninitialized, for any other
+    * T they are value-initialized, so the pointer is always safe to
+    * assign through.
+    */
+  pointer append_uninitialized( size_type count ) {
+    size_type old_size = size();
+    resize_default_init(old_size + count);
+    return _d_start + old_size;
+  }
+
+  /*
+    * Appends a copy of [first, last) at the end. Unlike a push_back
+    * loop, capacity is checked (and grown, amortized) once for the
+    * whole batch, and unlike insert(end(), ...) nothing is shifted.
+    * Contiguous ranges of trivially copyable T are copied with a
+    * single memcpy. The range may be part of this vector
+    * (v.append(v.begin(), v.end()) doubles it). Single pass ranges
+    * (std::istream_iterator...) cannot be measured first, they are a
+    * push_back loop.
+    */
+  template< class InputIt >
+  void append( InputIt first, InputIt last ) {
+    typedef is_single_pass_iterator<InputIt> SinglePass;
+    append_dispatch(first, last, SinglePass());
+  }
+
+  /* Appends the count elements starting at src. */
+  void append( const_pointer src, size_type count ) {
+    append(src, src + count);
+  }
+
   /*
     * Literally swap everything with some other vector.
     * Without swapping memory addresses of each vector, i.e.
@@ -702,7 +1253,7 @@ class vector {
     */
   void swap( vector& other ) {
     if (this != &other) {
-      ft::swap(_alloc, other._alloc);
+      ft::swap(_shrink_alloc, other._shrink_alloc);
       ft::swap(_d_start, other._d_start);
       ft::swap(_d_end, other._d_end);
       ft::swap(_capacity, other._capacity);
@@ -764,6 +1315,47 @@ void swap( ft::vector<T,Alloc>& x,
   x.swap(y);
 }
 
+/* Predicate for ft::erase : element == value. */
+template< class T >
+struct equal_to_value {
+
+  const T& value;
+
+  equal_to_value( const T& v )
+  :
+    value(v)
+  {}
+
+  template< class V >
+  bool operator()( const V& x ) const {
+    return x == value;
+  }
+
+};
+
+/*
+ * Erases all elements for which pred is true / that compare equal to
+ * value, in one compacting pass. Returns the number of erased
+ * elements. See :
+ * https://en.cppreference.com/w/cpp/container/vector/erase2
+ */
+template< class T, class Alloc, class UnaryPredicate >
+typename ft::vector<T,Alloc>::size_type
+erase_if( ft::vector<T,Alloc>& c, UnaryPredicate pred )
+{
+  return c.remove_if(pred);
+}
+
+template< class T, class Alloc, class U >
+typename ft::vector<T,Alloc>::size_type
+erase( ft::vector<T,Alloc>& c, const U& value )
+{
+  return c.remove_if(ft::equal_to_value<U>(value));
+}
+
 } /* namespace ft */
 
+/* Packed ft::vector<bool, Allocator> specialization. */
+#include "ft/vector_bool.hpp"
+
 #endif /* FT_CONTAINERS_VECTOR_HPP */
\ No newline at end of file
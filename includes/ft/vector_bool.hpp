@@ -0,0 +1,687 @@
+#ifndef FT_CONTAINERS_VECTOR_BOOL_HPP
+# define FT_CONTAINERS_VECTOR_BOOL_HPP
+#pragma once
+
+#include <memory> /* std::allocator */
+#include <cstddef> /* std::size_t, std::ptrdiff_t */
+#include <cstring> /* memset, memcpy, memcmp */
+#include <stdexcept>
+
+#include "ft/utils/utils.hpp"
+#include "ft/utils/bit_iterator.hpp"
+#include "ft/vector.hpp"
+#include "ft/utils/reverse_iterator.hpp"
+
+/*
+ * Packed specialization of ft::vector for bool. See :
+ * https://en.cppreference.com/w/cpp/container/vector_bool
+ *
+ * Bits are stored bits_per_word (64) per bit_word. Words are plain
+ * integers so there is nothing to construct nor destroy, only
+ * allocate, memcpy and deallocate.
+ *
+ * Invariant : every bit at a position >= size() inside the allocated
+ * words is 0. Keeping the tail clean is what lets count(), the
+ * find_* family, comparisons and the bulk &=, |=, ^= work one whole
+ * word at a time without masking the last one.
+ *
+ * On top of the std interface this adds the usual bitmap helpers
+ * (boost::dynamic_bitset naming) :
+ *  - count() : number of set bits, one popcount per word.
+ *  - find_first() / find_next(pos) : position of the next set bit
+ *    or npos, one ctz per non zero word.
+ *  - operator&=, |=, ^= and flip() : word wise bulk operations.
+ */
+
+namespace ft {
+
+template < class Allocator >
+class vector<bool, Allocator> {
+
+  public:
+  typedef bool                                         value_type;
+  typedef Allocator                                    allocator_type;
+  typedef std::size_t                                  size_type;
+  typedef std::ptrdiff_t                               difference_type;
+  typedef ft::bit_reference                            reference;
+  typedef bool                                         const_reference;
+  typedef ft::bit_reference*                           pointer;
+  typedef const bool*                                  const_pointer;
+
+  typedef ft::bit_iterator                             iterator;
+  typedef ft::bit_const_iterator                       const_iterator;
+  typedef ft::reverse_iterator<iterator>               reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator>         const_reverse_iterator;
+
+  static const size_type npos = static_cast<size_type>(-1);
+
+  private:
+
+  typedef typename Allocator::
+          template rebind<bit_word>::other             word_allocator;
+
+  word_allocator  _alloc;
+  bit_word*       _words;     // packed storage
+  size_type       _size;      // bits in use
+  size_type       _n_words;   // allocated words
+
+  static size_type words_for( size_type n_bits ) {
+    return (n_bits + bits_per_word - 1) / bits_per_word;
+  }
+
+  size_type used_words() const {
+    return words_for(_size);
+  }
+
+  /* Mask of the valid bits of the last used word (all ones if full). */
+  bit_word tail_mask() const {
+    size_type rest = _size % bits_per_word;
+    return rest ? (bit_word(1) << rest) - 1 : ~bit_word(0);
+  }
+
+  /* Restores the invariant after shrinking size() */
+  void clear_tail() {
+    size_type used = used_words();
+    if (used) {
+      _words[used - 1] &= tail_mask();
+    }
+    if (_n_words > used) {
+      memset(_words + used, 0, (_n_words - used) * sizeof(bit_word));
+    }
+  }
+
+  void reallocate( size_type new_n_words ) {
+    bit_word* new_words = _alloc.allocate(new_n_words);
+    size_type used = used_words();
+    if (used) {
+      memcpy(new_words, _words, used * sizeof(bit_word));
+    }
+    memset(new_words + used, 0, (new_n_words - used) * sizeof(bit_word));
+    if (_words) {
+      _alloc.deallocate(_words, _n_words);
+    }
+    _words = new_words;
+    _n_words = new_n_words;
+  }
+
+  /* Amortized growth, same doubling policy as the generic vector. */
+  void grow_for( size_type n_bits ) {
+    if (n_bits <= capacity()) {
+      return ;
+    }
+    size_type needed = words_for(n_bits);
+    size_type doubled = _n_words * 2;
+    reallocate(doubled > needed ? doubled : needed);
+  }
+
+  void init_fill_vector( size_type count, bool value ) {
+    if (count) {
+      reallocate(words_for(count));
+      _size = count;
+      if (value) {
+        memset(_words, 0xff, used_words() * sizeof(bit_word));
+        clear_tail();
+      }
+    }
+  }
+
+  template <typename InputIt>
+  void constructor_dispatch( InputIt first, InputIt last, false_type ) {
+    size_type count = ft::distance(first, last);
+    if (count) {
+      reallocate(words_for(count));
+    }
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  template <typename InputIt>
+  void constructor_dispatch( InputIt first, InputIt last, true_type ) {
+    init_fill_vector((size_type)first, last);
+  }
+
+  template <typename InputIt>
+  void assign_dispatch( InputIt first, InputIt last, false_type ) {
+    clear();
+    reserve(ft::distance(first, last));
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  template <typename InputIt>
+  void assign_dispatch( InputIt first, InputIt last, true_type ) {
+    assign((size_type)first, last);
+  }
+
+  template <typename InputIt>
+  iterator insert_dispatch( const_iterator pos,
+                            InputIt first, InputIt last, false_type )
+  {
+    difference_type value_pos = pos - begin();
+    size_type count = ft::distance(first, last);
+    create_bit_hole_at(value_pos, count);
+    for (iterator it = begin() + value_pos; first != last; ++first, ++it) {
+      *it = *first;
+    }
+    return begin() + value_pos;
+  }
+
+  template <typename InputIt>
+  iterator insert_dispatch( const_iterator pos,
+                            InputIt first, InputIt last, true_type )
+  {
+    return insert(pos, (size_type)first, last);
+  }
+
+  /* Sets bits [from, to) to value, whole words at a time. */
+  void fill_range( size_type from, size_type to, bool value ) {
+    while (from < to && from % bits_per_word) {
+      (*this)[from++] = value;
+    }
+    size_type full_words = (to - from) / bits_per_word;
+    if (full_words) {
+      memset(_words + from / bits_per_word, value ? 0xff : 0,
+             full_words * sizeof(bit_word));
+      from += full_words * bits_per_word;
+    }
+    while (from < to) {
+      (*this)[from++] = value;
+    }
+  }
+
+  /* Shifts [pos, size()) count bits to the right. */
+  void create_bit_hole_at( size_type pos, size_type count ) {
+    if (count == 0) {
+      return ;
+    }
+    grow_for(_size + count);
+    size_type old_size = _size;
+    _size += count;
+    iterator dst = end();
+    iterator src = begin() + old_size;
+    iterator stop = begin() + pos;
+    while (src != stop) {
+      *--dst = bool(*--src);
+    }
+  }
+
+  public:
+
+  vector()
+  :
+    _alloc(),
+    _words(0),
+    _size(0),
+    _n_words(0)
+  {}
+
+  explicit vector( size_type count, const bool& value = bool(),
+                   const Allocator& alloc = Allocator() )
+  :
+    _alloc(alloc),
+    _words(0),
+    _size(0),
+    _n_words(0)
+  {
+    init_fill_vector(count, value);
+  }
+
+  template< class InputIt >
+  vector( InputIt first, InputIt last,
+          const Allocator& alloc = Allocator() )
+  :
+    _alloc(alloc),
+    _words(0),
+    _size(0),
+    _n_words(0)
+  {
+    typedef typename ft::is_integer<InputIt> Integer;
+    constructor_dispatch(first, last, Integer());
+  }
+
+  vector( const vector& other )
+  :
+    _alloc(other._alloc),
+    _words(0),
+    _size(0),
+    _n_words(0)
+  {
+    if (other._size) {
+      reallocate(other.used_words());
+      memcpy(_words, other._words, other.used_words() * sizeof(bit_word));
+      _size = other._size;
+    }
+  }
+
+  ~vector() {
+    if (_words) {
+      _alloc.deallocate(_words, _n_words);
+    }
+  }
+
+  vector& operator=( const vector& other ) {
+    if (this != &other) {
+      if (other.used_words() > _n_words) {
+        _size = 0;
+        reallocate(other.used_words());
+      }
+      if (other.used_words()) {
+        memcpy(_words, other._words, other.used_words() * sizeof(bit_word));
+      }
+      _size = other._size;
+      clear_tail();
+    }
+    return *this;
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  vector( vector&& other ) noexcept
+  :
+    _alloc(std::move(other._alloc)),
+    _words(other._words),
+    _size(other._size),
+    _n_words(other._n_words)
+  {
+    other._words = 0;
+    other._size = 0;
+    other._n_words = 0;
+  }
+
+  vector& operator=( vector&& other ) noexcept {
+    if (this != &other) {
+      if (_words) {
+        _alloc.deallocate(_words, _n_words);
+      }
+      _alloc = std::move(other._alloc);
+      _words = other._words;
+      _size = other._size;
+      _n_words = other._n_words;
+      other._words = 0;
+      other._size = 0;
+      other._n_words = 0;
+    }
+    return *this;
+  }
+#endif
+
+  void assign( size_type count, const bool& value ) {
+    clear();
+    grow_for(count);
+    _size = count;
+    if (value && count) {
+      memset(_words, 0xff, used_words() * sizeof(bit_word));
+      clear_tail();
+    }
+  }
+
+  template< class InputIt >
+  void assign( InputIt first, InputIt last ) {
+    typedef typename ft::is_integer<InputIt> Integer;
+    assign_dispatch(first, last, Integer());
+  }
+
+  allocator_type get_allocator() const {
+    return allocator_type(_alloc);
+  }
+
+  /* ------------------------------------------
+   * Element access
+   */
+
+  reference at( size_type pos ) {
+    if (!(pos < size())) {
+      throw std::out_of_range("ft::vector<bool>::at( size_type )");
+    }
+    return (*this)[pos];
+  }
+
+  const_reference at( size_type pos ) const {
+    if (!(pos < size())) {
+      throw std::out_of_range("ft::vector<bool>::at( size_type ) const");
+    }
+    return (*this)[pos];
+  }
+
+  reference operator[]( size_type pos ) {
+    return reference(_words + pos / bits_per_word, pos % bits_per_word);
+  }
+
+  const_reference operator[]( size_type pos ) const {
+    return (_words[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+  }
+
+  reference front() {
+    return (*this)[0];
+  }
+
+  const_reference front() const {
+    return (*this)[0];
+  }
+
+  reference back() {
+    return (*this)[_size - 1];
+  }
+
+  const_reference back() const {
+    return (*this)[_size - 1];
+  }
+
+  /* Raw packed words, (size() + 63) / 64 of them are meaningful. */
+  bit_word* data() {
+    return _words;
+  }
+
+  const bit_word* data() const {
+    return _words;
+  }
+
+  /* ------------------------------------------
+   * Iterators
+   */
+
+  iterator begin() {
+    return iterator(_words, 0);
+  }
+
+  const_iterator begin() const {
+    return const_iterator(_words, 0);
+  }
+
+  iterator end() {
+    return begin() + _size;
+  }
+
+  const_iterator end() const {
+    return begin() + _size;
+  }
+
+  reverse_iterator rbegin() {
+    return reverse_iterator(end());
+  }
+
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  /* ------------------------------------------
+   * Capacity
+   */
+
+  bool empty() const {
+    return _size == 0;
+  }
+
+  size_type size() const {
+    return _size;
+  }
+
+  size_type max_size() const {
+    size_type words = _alloc.max_size();
+    if (words > npos / bits_per_word) {
+      return npos;
+    }
+    return words * bits_per_word;
+  }
+
+  void reserve( size_type new_cap ) {
+    if (new_cap > max_size()) {
+      throw std::length_error("ft::vector<bool>::reserve( size_type )");
+    }
+    if (new_cap > capacity()) {
+      reallocate(words_for(new_cap));
+    }
+  }
+
+  size_type capacity() const {
+    return _n_words * bits_per_word;
+  }
+
+  /* ------------------------------------------
+   * Modifiers
+   */
+
+  void clear() {
+    if (used_words()) {
+      memset(_words, 0, used_words() * sizeof(bit_word));
+    }
+    _size = 0;
+  }
+
+  iterator insert( const_iterator pos, const bool& value ) {
+    difference_type value_pos = pos - begin();
+    if (size_type(value_pos) == _size) {
+      push_back(value);
+    } else {
+      create_bit_hole_at(value_pos, 1);
+      (*this)[value_pos] = value;
+    }
+    return begin() + value_pos;
+  }
+
+  iterator insert( const_iterator pos, size_type count, const bool& value ) {
+    difference_type value_pos = pos - begin();
+    create_bit_hole_at(value_pos, count);
+    fill_range(value_pos, value_pos + count, value);
+    return begin() + value_pos;
+  }
+
+  template< class InputIt >
+  iterator insert( const_iterator pos, InputIt first, InputIt last ) {
+    typedef typename ft::is_integer<InputIt> Integer;
+    return insert_dispatch(pos, first, last, Integer());
+  }
+
+  iterator erase( iterator pos ) {
+    return erase(pos, pos + 1);
+  }
+
+  iterator erase( iterator first, iterator last ) {
+    difference_type start = first - begin();
+    iterator stop = end();
+    while (last != stop) {
+      *first++ = bool(*last++);
+    }
+    _size -= last - first;
+    clear_tail();
+    return begin() + start;
+  }
+
+  void push_back( const bool& value ) {
+    if (_size == capacity()) {
+      grow_for(_size + 1);
+    }
+    if (value) {
+      _words[_size / bits_per_word] |= bit_word(1) << (_size % bits_per_word);
+    }
+    ++_size;
+  }
+
+#ifdef FT_CONTAINERS_CXX11
+  /* A bit has no constructor to forward to, this is push_back. */
+  template< class... Args >
+  reference emplace_back( Args&&... args ) {
+    push_back(bool(std::forward<Args>(args)...));
+    return back();
+  }
+#endif
+
+  void pop_back() {
+    if (_size) {
+      --_size;
+      _words[_size / bits_per_word] &= ~(bit_word(1) << (_size % bits_per_word));
+    }
+  }
+
+  void resize( size_type count, bool value = false ) {
+    if (count < _size) {
+      _size = count;
+      clear_tail();
+    } else if (count > _size) {
+      grow_for(count);
+      size_type old_size = _size;
+      _size = count;
+      // the tail is already 0, only true needs writing.
+      if (value) {
+        fill_range(old_size, count, true);
+      }
+    }
+  }
+
+  void swap( vector& other ) {
+    if (this != &other) {
+      ft::swap(_alloc, other._alloc);
+      ft::swap(_words, other._words);
+      ft::swap(_size, other._size);
+      ft::swap(_n_words, other._n_words);
+    }
+  }
+
+  static void swap( reference x, reference y ) {
+    ft::swap(x, y);
+  }
+
+  /* ------------------------------------------
+   * Bitmap operations
+   */
+
+  /* Flips every bit. */
+  void flip() {
+    size_type used = used_words();
+    for (size_type i = 0; i < used; i++) {
+      _words[i] = ~_words[i];
+    }
+    clear_tail();
+  }
+
+  /* Number of bits set to true. */
+  size_type count() const {
+    size_type used = used_words();
+    size_type total = 0;
+    for (size_type i = 0; i < used; i++) {
+      total += __builtin_popcountll(_words[i]);
+    }
+    return total;
+  }
+
+  /* Position of the first set bit, or npos. */
+  size_type find_first() const {
+    return find_from(0);
+  }
+
+  /* Position of the first set bit strictly after pos, or npos. */
+  size_type find_next( size_type pos ) const {
+    if (pos == npos || pos + 1 >= _size) {
+      return npos;
+    }
+    return find_from(pos + 1);
+  }
+
+  /*
+   * Word wise bulk operations. Both vectors must hold the same
+   * number of bits, as in boost::dynamic_bitset.
+   */
+  vector& operator&=( const vector& other ) {
+    check_same_size(other, "ft::vector<bool>::operator&=");
+    size_type used = used_words();
+    for (size_type i = 0; i < used; i++) {
+      _words[i] &= other._words[i];
+    }
+    return *this;
+  }
+
+  vector& operator|=( const vector& other ) {
+    check_same_size(other, "ft::vector<bool>::operator|=");
+    size_type used = used_words();
+    for (size_type i = 0; i < used; i++) {
+      _words[i] |= other._words[i];
+    }
+    return *this;
+  }
+
+  vector& operator^=( const vector& other ) {
+    check_same_size(other, "ft::vector<bool>::operator^=");
+    size_type used = used_words();
+    for (size_type i = 0; i < used; i++) {
+      _words[i] ^= other._words[i];
+    }
+    return *this;
+  }
+
+  private:
+
+  size_type find_from( size_type pos ) const {
+    size_type i = pos / bits_per_word;
+    size_type used = used_words();
+    if (i >= used) {
+      return npos;
+    }
+    // drop the bits before pos in the first word.
+    bit_word w = _words[i] & (~bit_word(0) << (pos % bits_per_word));
+    while (!w) {
+      if (++i == used) {
+        return npos;
+      }
+      w = _words[i];
+    }
+    return i * bits_per_word + __builtin_ctzll(w);
+  }
+
+  void check_same_size( const vector& other, const char* what ) const {
+    if (_size != other._size) {
+      throw std::invalid_argument(what);
+    }
+  }
+
+}; /* class vector<bool> */
+
+template< class Alloc >
+const typename vector<bool, Alloc>::size_type vector<bool, Alloc>::npos;
+
+/* Tails are always zeroed, so the words can be compared directly. */
+template< class Alloc >
+bool operator==( const ft::vector<bool,Alloc>& x,
+                 const ft::vector<bool,Alloc>& y )
+{
+  size_t n_words = (x.size() + bits_per_word - 1) / bits_per_word;
+  return x.size() == y.size()
+         && (n_words == 0
+             || memcmp(x.data(), y.data(), n_words * sizeof(bit_word)) == 0);
+}
+
+template< class Alloc >
+ft::vector<bool,Alloc> operator&( const ft::vector<bool,Alloc>& x,
+                                  const ft::vector<bool,Alloc>& y )
+{
+  ft::vector<bool,Alloc> result(x);
+  return result &= y;
+}
+
+template< class Alloc >
+ft::vector<bool,Alloc> operator|( const ft::vector<bool,Alloc>& x,
+                                  const ft::vector<bool,Alloc>& y )
+{
+  ft::vector<bool,Alloc> result(x);
+  return result |= y;
+}
+
+template< class Alloc >
+ft::vector<bool,Alloc> operator^( const ft::vector<bool,Alloc>& x,
+                                  const ft::vector<bool,Alloc>& y )
+{
+  ft::vector<bool,Alloc> result(x);
+  return result ^= y;
+}
+
+} /* namespace ft */
+
+#endif /* FT_CONTAINERS_VECTOR_BOOL_HPP */
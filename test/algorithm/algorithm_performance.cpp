@@ -0,0 +1,258 @@
+#include "ft/algorithm.hpp"
+#include "ft/vector.hpp"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <string>
+#include <functional>
+#include <stdint.h>
+#include "../bench/bench.hpp"
+#include "../bench/generators.hpp"
+#include "../test.hpp"
+#include "../colors.hpp"
+#include <iostream>
+
+#define SCAN_SIZE (1 << 20)
+#define SCAN_REPEAT 4
+
+namespace {
+enum scan { FIND, COUNT, FILL, COPY, MIN_ELEMENT, MAX_ELEMENT, ACCUMULATE };
+}
+
+/* The algorithms under test, as one name for ft's and std's. */
+struct ft_algorithms {
+  template < typename It, typename T >
+  static It find( It first, It last, const T& v ) {
+    return ft::find(first, last, v);
+  }
+  template < typename It, typename T >
+  static long count( It first, It last, const T& v ) {
+    return ft::count(first, last, v);
+  }
+  template < typename It, typename T >
+  static void fill( It first, It last, const T& v ) {
+    ft::fill(first, last, v);
+  }
+  template < typename It, typename Out >
+  static void copy( It first, It last, Out out ) {
+    ft::copy(first, last, out);
+  }
+  template < typename It >
+  static It min_element( It first, It last ) {
+    return ft::min_element(first, last);
+  }
+  template < typename It >
+  static It max_element( It first, It last ) {
+    return ft::max_element(first, last);
+  }
+  template < typename It, typename T >
+  static T accumulate( It first, It last, T init ) {
+    return ft::accumulate(first, last, init);
+  }
+};
+
+struct std_algorithms {
+  template < typename It, typename T >
+  static It find( It first, It last, const T& v ) {
+    return std::find(first, last, v);
+  }
+  template < typename It, typename T >
+  static long count( It first, It last, const T& v ) {
+    return std::count(first, last, v);
+  }
+  template < typename It, typename T >
+  static void fill( It first, It last, const T& v ) {
+    std::fill(first, last, v);
+  }
+  template < typename It, typename Out >
+  static void copy( It first, It last, Out out ) {
+    std::copy(first, last, out);
+  }
+  template < typename It >
+  static It min_element( It first, It last ) {
+    return std::min_element(first, last);
+  }
+  template < typename It >
+  static It max_element( It first, It last ) {
+    return std::max_element(first, last);
+  }
+  template < typename It, typename T >
+  static T accumulate( It first, It last, T init ) {
+    return std::accumulate(first, last, init);
+  }
+};
+
+/*
+ * SCAN_REPEAT passes of Op over state.arg() elements, ft's algorithms
+ * on ft::vector against std's on std::vector. find and count look for
+ * a value that is not there, so every pass is a full scan.
+ */
+template < typename Algorithms, typename Vector, int Op >
+static void scan_case( bench::state& state ) {
+
+  typedef typename Vector::value_type T;
+  Vector vec;
+  for (long i = 0; i < state.arg(); i++) {
+    vec.push_back(T(i % 1000));
+  }
+  Vector dest(state.arg());
+  long sink = 0;
+  state.start();
+  for (int r = 0; r < SCAN_REPEAT; r++) {
+    switch (Op) {
+      case FIND:
+        sink += Algorithms::find(vec.begin(), vec.end(), T(5000))
+                - vec.begin();
+        break;
+      case COUNT:
+        sink += Algorithms::count(vec.begin(), vec.end(), T(7));
+        break;
+      case FILL:
+        Algorithms::fill(dest.begin(), dest.end(), T(r));
+        break;
+      case COPY:
+        Algorithms::copy(vec.begin(), vec.end(), dest.begin());
+        break;
+      case MIN_ELEMENT:
+        sink += *Algorithms::min_element(vec.begin(), vec.end());
+        break;
+      case MAX_ELEMENT:
+        sink += *Algorithms::max_element(vec.begin(), vec.end());
+        break;
+      default:
+        sink += Algorithms::accumulate(vec.begin(), vec.end(), T(0));
+    }
+    bench::clobber_memory();
+  }
+  state.stop(SCAN_REPEAT * state.arg());
+  bench::do_not_optimize(sink);
+}
+
+template < typename T, int Op >
+static void scan_row( const std::string& type, const char* name ) {
+  bench::row("vector<" + type + "> " + name,
+             scan_case< ft_algorithms, ft::vector<T>, Op >,
+             scan_case< std_algorithms, std::vector<T>, Op >, SCAN_SIZE);
+}
+
+template < typename T >
+static void scan_rows( const std::string& type ) {
+  scan_row< T, FIND >(type, "find");
+  scan_row< T, COUNT >(type, "count");
+  scan_row< T, FILL >(type, "fill");
+  scan_row< T, COPY >(type, "copy");
+  scan_row< T, MIN_ELEMENT >(type, "min_element");
+  scan_row< T, MAX_ELEMENT >(type, "max_element");
+  scan_row< T, ACCUMULATE >(type, "accumulate");
+}
+
+#define SORT_SIZE (1 << 19)
+
+namespace {
+enum distribution { RANDOM, SORTED, REVERSE, FEW_UNIQUE };
+}
+
+static const char* distribution_names[] = {
+  "random", "sorted", "reverse", "few unique"
+};
+
+/*
+ * The same input for every call with the same kind and size : random
+ * and few unique are uniform draws (see --seed) over 2^31 and 16.
+ */
+static std::vector<int> distributed( int kind, long size ) {
+  if (kind == RANDOM || kind == FEW_UNIQUE) {
+    std::vector<unsigned long> keys = bench::draw(
+        bench::UNIFORM, size, kind == RANDOM ? 1UL << 31 : 16);
+    return std::vector<int>(keys.begin(), keys.end());
+  }
+  std::vector<int> values;
+  for (long i = 0; i < size; i++) {
+    values.push_back(int(kind == SORTED ? i : size - i));
+  }
+  return values;
+}
+
+/* The sorts under test, each as a type to instantiate the cases with. */
+#define SORT_ALGORITHM(name, call) \
+  struct name { \
+    template < typename It > \
+    static void sort( It first, It last ) { call(first, last); } \
+  };
+
+SORT_ALGORITHM(std_sort, std::sort)
+SORT_ALGORITHM(std_stable_sort, std::stable_sort)
+SORT_ALGORITHM(ft_sort, ft::sort)
+SORT_ALGORITHM(ft_stable_sort, ft::stable_sort)
+SORT_ALGORITHM(ft_radix_sort, ft::radix_sort)
+SORT_ALGORITHM(ft_parallel_sort, ft::parallel_sort)
+
+#undef SORT_ALGORITHM
+
+/*
+ * Sort::sort on a fresh copy of state.arg() values of kind Kind,
+ * checked sorted once the clock stopped.
+ */
+template < typename Container, typename Sort, int Kind >
+static void sort_case( bench::state& state ) {
+
+  std::vector<int> input = distributed(Kind, state.arg());
+  Container c(input.begin(), input.end());
+  state.start();
+  Sort::sort(c.begin(), c.end());
+  state.stop(state.arg());
+  for (size_t i = 1; i < c.size(); i++) {
+    if (c[i] < c[i - 1]) {
+      std::cout << RED_BOLD << "not sorted" << UNSET << std::endl;
+      break;
+    }
+  }
+}
+
+/* FtSort against StdSort on every distribution. */
+template < typename FtSort, typename StdSort >
+static void sort_rows( const std::string& name ) {
+  bench::row(name + " " + distribution_names[RANDOM],
+             sort_case< ft::vector<int>, FtSort, RANDOM >,
+             sort_case< std::vector<int>, StdSort, RANDOM >, SORT_SIZE);
+  bench::row(name + " " + distribution_names[SORTED],
+             sort_case< ft::vector<int>, FtSort, SORTED >,
+             sort_case< std::vector<int>, StdSort, SORTED >, SORT_SIZE);
+  bench::row(name + " " + distribution_names[REVERSE],
+             sort_case< ft::vector<int>, FtSort, REVERSE >,
+             sort_case< std::vector<int>, StdSort, REVERSE >, SORT_SIZE);
+  bench::row(name + " " + distribution_names[FEW_UNIQUE],
+             sort_case< ft::vector<int>, FtSort, FEW_UNIQUE >,
+             sort_case< std::vector<int>, StdSort, FEW_UNIQUE >, SORT_SIZE);
+}
+
+void algorithm_performance() {
+
+  std::cout << BLUE_BOLD
+            << "////////// [ ALGORITHM PERFORMANCE ] ////////// "
+            << UNSET << std::endl;
+
+  bench::header();
+  scan_rows<int>("int");
+  scan_rows<uint64_t>("uint64_t");
+
+  const std::string caption =
+      bench::with_arg("sort", SORT_SIZE)
+      + bench::with_arg(" ints,", ft::parallel_sort_threads()) + " cpus";
+  bench::header("ft::sort", "std::sort");
+  bench::caption(caption);
+  sort_rows< ft_sort, std_sort >("sort");
+  bench::header("ft::stable_sort", "std::stable_sort");
+  bench::caption(caption);
+  sort_rows< ft_stable_sort, std_stable_sort >("stable_sort");
+  bench::header("ft::radix_sort", "std::sort");
+  bench::caption(caption);
+  sort_rows< ft_radix_sort, std_sort >("radix_sort");
+  bench::header("ft::parallel_sort", "std::sort");
+  bench::caption(caption);
+  sort_rows< ft_parallel_sort, std_sort >("parallel_sort");
+
+  std::cout << BLUE_BOLD
+            << "/////////////////////////////////////////////////"
+            << UNSET << std::endl;
+}
@@ -0,0 +1,484 @@
+#include "ft/algorithm.hpp"
+#include "ft/vector.hpp"
+#include "ft/deque.hpp"
+#include "ft/utils/utils.hpp"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+#include <list>
+#include <string>
+#include <cstdlib>
+#include "../test_utils.hpp"
+
+static void find_count_test();
+static void fill_copy_test();
+static void min_max_test();
+static void accumulate_test();
+static void generic_test();
+static void sort_test();
+static void stable_sort_test();
+static void radix_sort_test();
+static void parallel_sort_test();
+
+void algorithm_test() {
+  find_count_test();
+  fill_copy_test();
+  min_max_test();
+  accumulate_test();
+  generic_test();
+  sort_test();
+  stable_sort_test();
+  radix_sort_test();
+  parallel_sort_test();
+}
+
+/*
+ * Random ranges of size 0 to 300 (every kernel tail length, several
+ * 32 byte steps), values in [-8, 8) so searches hit and miss.
+ */
+template <typename T>
+static std::vector<T> random_values( size_t size ) {
+  std::vector<T> values;
+  for (size_t i = 0; i < size; i++) {
+    values.push_back(T(rand() % 16 - 8));
+  }
+  return values;
+}
+
+template <typename T>
+static bool find_count_round( unsigned seed ) {
+
+  srand(seed);
+  for (int round = 0; round < 200; round++) {
+    std::vector<T> ref = random_values<T>(rand() % 300);
+    ft::vector<T> vec(ref.begin(), ref.end());
+    // std::vector<bool> has no array to point into
+    T* raw = new T[ref.size() + 1];
+    std::copy(ref.begin(), ref.end(), raw);
+    bool ok = true;
+    for (int value = -9; value < 9; value++) {
+      size_t expected = std::find(ref.begin(), ref.end(), value) - ref.begin();
+      ok = ok
+        && size_t(ft::find(vec.begin(), vec.end(), value) - vec.begin())
+           == expected
+        && size_t(ft::find(raw, raw + ref.size(), value) - raw) == expected
+        && ft::count(vec.begin(), vec.end(), value)
+           == std::count(ref.begin(), ref.end(), value);
+    }
+    delete[] raw;
+    if (!ok) {
+      return false;
+    }
+    // out of the element type's range : 300 is no char, -1 no unsigned
+    if (ft::count(vec.begin(), vec.end(), 300L)
+          != std::count(ref.begin(), ref.end(), 300L)
+        || ft::find(vec.begin(), vec.end(), -1L) - vec.begin()
+          != std::find(ref.begin(), ref.end(), -1L) - ref.begin())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void find_count_test() {
+
+  if (!find_count_round<char>(1) || !find_count_round<signed char>(2)
+      || !find_count_round<unsigned char>(3) || !find_count_round<short>(4)
+      || !find_count_round<unsigned short>(5) || !find_count_round<int>(6)
+      || !find_count_round<unsigned>(7) || !find_count_round<long>(8)
+      || !find_count_round<unsigned long>(9)
+      || !find_count_round<long long>(10) || !find_count_round<bool>(11))
+  {
+    return ALGORITHM_TEST_ERROR(KO_FIND);
+  }
+  return ALGORITHM_TEST_OK(FIND_TAG);
+}
+
+template <typename T>
+static bool fill_copy_round( unsigned seed ) {
+
+  srand(seed);
+  for (int round = 0; round < 200; round++) {
+    std::vector<T> ref = random_values<T>(rand() % 300);
+    ft::vector<T> vec(ref.begin(), ref.end());
+    size_t from = ref.empty() ? 0 : rand() % ref.size();
+    size_t to = from + (ref.size() == from ? 0 : rand() % (ref.size() - from));
+    T value = T(rand());
+    std::fill(ref.begin() + from, ref.begin() + to, value);
+    ft::fill(vec.begin() + from, vec.begin() + to, value);
+    if (!std::equal(ref.begin(), ref.end(), vec.begin())) {
+      return false;
+    }
+    ft::vector<T> dest(ref.size() + 3);
+    std::fill(dest.begin(), dest.end(), T(1));
+    typename ft::vector<T>::iterator end
+      = ft::copy(vec.begin(), vec.end(), dest.begin() + 1);
+    if (end != dest.begin() + 1 + ref.size()
+        || !std::equal(ref.begin(), ref.end(), dest.begin() + 1)
+        || dest.front() != T(1) || dest.back() != T(1))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void fill_copy_test() {
+
+  if (!fill_copy_round<char>(1) || !fill_copy_round<short>(2)
+      || !fill_copy_round<int>(3) || !fill_copy_round<unsigned long>(4))
+  {
+    return ALGORITHM_TEST_ERROR(KO_FILL);
+  }
+  // non trivial : element by element
+  std::string words[] = { "a", "bb", "ccc" };
+  ft::vector<std::string> copies(3);
+  ft::copy(words, words + 3, copies.begin());
+  ft::fill(words, words + 2, std::string("z"));
+  if (copies[1] != "bb" || words[1] != "z" || words[2] != "ccc") {
+    return ALGORITHM_TEST_ERROR(KO_COPY);
+  }
+  return ALGORITHM_TEST_OK(FILL_TAG);
+}
+
+template <typename T>
+static bool min_max_round( unsigned seed ) {
+
+  srand(seed);
+  for (int round = 0; round < 300; round++) {
+    std::vector<T> ref = random_values<T>(rand() % 300);
+    if (!ref.empty() && rand() % 2) {   // a unique extremum anywhere
+      ref[rand() % ref.size()] = T(rand() % 2 ? 100 : -100);
+    }
+    ft::vector<T> vec(ref.begin(), ref.end());
+    if (ft::min_element(vec.begin(), vec.end()) - vec.begin()
+          != std::min_element(ref.begin(), ref.end()) - ref.begin()
+        || ft::max_element(vec.begin(), vec.end()) - vec.begin()
+          != std::max_element(ref.begin(), ref.end()) - ref.begin())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void min_max_test() {
+
+  if (!min_max_round<char>(1) || !min_max_round<signed char>(2)
+      || !min_max_round<unsigned char>(3) || !min_max_round<short>(4)
+      || !min_max_round<unsigned short>(5) || !min_max_round<int>(6)
+      || !min_max_round<unsigned>(7) || !min_max_round<long>(8)
+      || !min_max_round<unsigned long>(9) || !min_max_round<bool>(10))
+  {
+    return ALGORITHM_TEST_ERROR(KO_MIN_MAX);
+  }
+  ft::vector<int> empty;
+  if (ft::min_element(empty.begin(), empty.end()) != empty.end()) {
+    return ALGORITHM_TEST_ERROR(KO_MIN_MAX);
+  }
+  return ALGORITHM_TEST_OK(MIN_MAX_TAG);
+}
+
+template <typename T>
+static bool accumulate_round( unsigned seed ) {
+
+  srand(seed);
+  for (int round = 0; round < 200; round++) {
+    std::vector<T> ref = random_values<T>(rand() % 300);
+    ft::vector<T> vec(ref.begin(), ref.end());
+    T init = T(rand() % 100);
+    if (ft::accumulate(vec.begin(), vec.end(), init)
+          != std::accumulate(ref.begin(), ref.end(), init)
+        || ft::accumulate(vec.begin(), vec.end(), 0.5)     // loop
+          != std::accumulate(ref.begin(), ref.end(), 0.5))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void accumulate_test() {
+
+  if (!accumulate_round<char>(1) || !accumulate_round<unsigned char>(2)
+      || !accumulate_round<short>(3) || !accumulate_round<int>(4)
+      || !accumulate_round<unsigned>(5) || !accumulate_round<long>(6))
+  {
+    return ALGORITHM_TEST_ERROR(KO_ACCUMULATE);
+  }
+  ft::vector<bool> bits(10, true);
+  std::vector<bool> std_bits(10, true);
+  if (ft::accumulate(bits.begin(), bits.end(), false)
+      != std::accumulate(std_bits.begin(), std_bits.end(), false))
+  {
+    return ALGORITHM_TEST_ERROR(KO_ACCUMULATE);
+  }
+  return ALGORITHM_TEST_OK(ACCUMULATE_TAG);
+}
+
+/* Iterators and types the fast paths do not take. */
+static void generic_test() {
+
+  std::list<int> list;
+  for (int i = 0; i < 100; i++) {
+    list.push_back(i % 10);
+  }
+  std::list<int>::iterator it = ft::find(list.begin(), list.end(), 7);
+  if (it == list.end() || *it != 7
+      || ft::count(list.begin(), list.end(), 3) != 10
+      || *ft::max_element(list.begin(), list.end()) != 9
+      || ft::accumulate(list.begin(), list.end(), 0) != 450)
+  {
+    return ALGORITHM_TEST_ERROR(KO_FIND);
+  }
+  // 0.0 == -0.0 : found, though the bits differ
+  double values[] = { 1.5, -0.0, 2.5, -0.0 };
+  if (ft::find(values, values + 4, 0.0) != values + 1
+      || ft::count(values, values + 4, 0.0) != 2
+      || ft::min_element(values, values + 4) != values + 1)
+  {
+    return ALGORITHM_TEST_ERROR(KO_FIND);
+  }
+  ft::vector<std::string> words;
+  words.push_back("b");
+  words.push_back("c");
+  words.push_back("a");
+  if (ft::min_element(words.begin(), words.end()) != words.begin() + 2
+      || ft::accumulate(words.begin(), words.end(), std::string())
+         != "bca")
+  {
+    return ALGORITHM_TEST_ERROR(KO_MIN_MAX);
+  }
+  // only types the fixed width kernel type may alias take the kernels
+  if (!ft::is_simd_range<int*>::value
+      || !ft::is_simd_range<ft::vector<long>::iterator>::value
+      || !ft::is_simd_range<const char*>::value
+      || ft::is_simd_range<long long*>::value
+      || ft::is_simd_range<wchar_t*>::value
+      || ft::is_simd_range<double*>::value)
+  {
+    return ALGORITHM_TEST_ERROR(KO_FIND);
+  }
+  return ALGORITHM_TEST_OK(RANGE_TAG);
+}
+
+/*
+ * The inputs sorts trip on : random, already sorted, reversed, few
+ * distinct keys, organ pipe (up then down).
+ */
+namespace {
+enum distribution { RANDOM, SORTED, REVERSE, FEW_UNIQUE, ORGAN_PIPE };
+}
+
+static std::vector<int> distributed( size_t size, int kind ) {
+  std::vector<int> values;
+  for (size_t i = 0; i < size; i++) {
+    switch (kind) {
+      case RANDOM:     values.push_back(rand()); break;
+      case SORTED:     values.push_back(int(i)); break;
+      case REVERSE:    values.push_back(int(size - i)); break;
+      case FEW_UNIQUE: values.push_back(rand() % 4); break;
+      default:         values.push_back(int(i < size / 2 ? i : size - i));
+    }
+  }
+  return values;
+}
+
+template < typename Container, typename Compare >
+static bool sorts_like_std( const std::vector<int>& values, Compare comp ) {
+  std::vector<int> ref(values);
+  Container c(values.begin(), values.end());
+  std::sort(ref.begin(), ref.end(), comp);
+  ft::sort(c.begin(), c.end(), comp);
+  return std::equal(ref.begin(), ref.end(), c.begin());
+}
+
+static void sort_test() {
+
+  srand(12);
+  for (int round = 0; round < 100; round++) {
+    // every size up to 64 once, then past the insertion sort cutoff
+    size_t size = round < 64 ? round : rand() % 5000;
+    for (int kind = RANDOM; kind <= ORGAN_PIPE; kind++) {
+      std::vector<int> values = distributed(size, kind);
+      if (!sorts_like_std< ft::vector<int> >(values, std::less<int>())
+          || !sorts_like_std< ft::vector<int> >(values, std::greater<int>())
+          || !sorts_like_std< ft::deque<int> >(values, std::less<int>()))
+      {
+        return ALGORITHM_TEST_ERROR(KO_SORT);
+      }
+    }
+  }
+  // all equal : the partition must not go quadratic nor out of range
+  ft::vector<int> same(100000, 7);
+  ft::sort(same.begin(), same.end());
+  ft::vector<std::string> words;
+  std::vector<std::string> ref;
+  for (int i = 0; i < 500; i++) {
+    words.push_back(std::string(rand() % 5, char('a' + rand() % 26)));
+    ref.push_back(words.back());
+  }
+  ft::sort(words.begin(), words.end());
+  std::sort(ref.begin(), ref.end());
+  int raw[] = { 3, 1, 2 };
+  ft::sort(raw, raw + 3);
+  if (same.front() != 7 || same.back() != 7
+      || !std::equal(ref.begin(), ref.end(), words.begin())
+      || raw[0] != 1 || raw[2] != 3)
+  {
+    return ALGORITHM_TEST_ERROR(KO_SORT);
+  }
+  return ALGORITHM_TEST_OK(SORT_TAG);
+}
+
+/* Sorted on key only : order tells equal keys apart. */
+struct keyed {
+  int key;
+  int order;
+};
+
+static bool operator==( const keyed& x, const keyed& y ) {
+  return x.key == y.key && x.order == y.order;
+}
+
+static bool key_less( const keyed& x, const keyed& y ) {
+  return x.key < y.key;
+}
+
+static void stable_sort_test() {
+
+  srand(13);
+  for (int round = 0; round < 100; round++) {
+    size_t size = round < 64 ? round : rand() % 5000;
+    for (int kind = RANDOM; kind <= ORGAN_PIPE; kind++) {
+      std::vector<int> keys = distributed(size, kind);
+      std::vector<keyed> ref;
+      for (size_t i = 0; i < size; i++) {
+        keyed k = { keys[i] % 50, int(i) };
+        ref.push_back(k);
+      }
+      ft::vector<keyed> vec(ref.begin(), ref.end());
+      ft::deque<keyed> deq(ref.begin(), ref.end());
+      std::stable_sort(ref.begin(), ref.end(), key_less);
+      ft::stable_sort(vec.begin(), vec.end(), key_less);
+      ft::stable_sort(deq.begin(), deq.end(), key_less);
+      if (!std::equal(ref.begin(), ref.end(), vec.begin())
+          || !std::equal(ref.begin(), ref.end(), deq.begin()))
+      {
+        return ALGORITHM_TEST_ERROR(KO_STABLE_SORT);
+      }
+    }
+  }
+  ft::vector<std::string> words;
+  std::vector<std::string> ref;
+  for (int i = 0; i < 500; i++) {
+    words.push_back(std::string(rand() % 5, char('a' + rand() % 26)));
+    ref.push_back(words.back());
+  }
+  ft::stable_sort(words.begin(), words.end());
+  std::stable_sort(ref.begin(), ref.end());
+  if (!std::equal(ref.begin(), ref.end(), words.begin())) {
+    return ALGORITHM_TEST_ERROR(KO_STABLE_SORT);
+  }
+  return ALGORITHM_TEST_OK(STABLE_SORT_TAG);
+}
+
+/* Every bit random, so negative values and every byte show up. */
+template <typename T>
+static T random_bits() {
+  unsigned long long bits = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    bits = bits << 8 | (rand() & 0xff);
+  }
+  return T(bits);
+}
+
+template <typename T>
+static bool radix_round( unsigned seed ) {
+
+  srand(seed);
+  for (int round = 0; round < 40; round++) {
+    size_t size = rand() % 3000;
+    std::vector<T> ref;
+    for (size_t i = 0; i < size; i++) {
+      // half the rounds small keys : high bytes all the same, skipped
+      ref.push_back(round % 2 ? random_bits<T>() : T(rand() % 100 - 50));
+    }
+    ft::vector<T> vec(ref.begin(), ref.end());
+    std::sort(ref.begin(), ref.end());
+    ft::radix_sort(vec.begin(), vec.end());
+    if (!std::equal(ref.begin(), ref.end(), vec.begin())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void radix_sort_test() {
+
+  if (!radix_round<char>(1) || !radix_round<signed char>(2)
+      || !radix_round<unsigned char>(3) || !radix_round<short>(4)
+      || !radix_round<unsigned short>(5) || !radix_round<int>(6)
+      || !radix_round<unsigned>(7) || !radix_round<long>(8)
+      || !radix_round<unsigned long>(9) || !radix_round<long long>(10)
+      || !radix_round<bool>(11))
+  {
+    return ALGORITHM_TEST_ERROR(KO_RADIX_SORT);
+  }
+  // not integral : ft::sort
+  ft::deque<double> values;
+  for (int i = 0; i < 1000; i++) {
+    values.push_back((rand() % 2000 - 1000) / 8.0);
+  }
+  ft::radix_sort(values.begin(), values.end());
+  for (size_t i = 1; i < values.size(); i++) {
+    if (values[i] < values[i - 1]) {
+      return ALGORITHM_TEST_ERROR(KO_RADIX_SORT);
+    }
+  }
+  return ALGORITHM_TEST_OK(RADIX_SORT_TAG);
+}
+
+/*
+ * Thread counts are forced : whatever the cpus, the chunks and the
+ * merge rounds (odd counts leave a run alone) run.
+ */
+static void parallel_sort_test() {
+
+  srand(14);
+  const unsigned threads[] = { 2, 3, 4, 5, 8 };
+  for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+    for (int kind = RANDOM; kind <= ORGAN_PIPE; kind++) {
+      std::vector<int> ref = distributed(140000 + rand() % 1000, kind);
+      ft::vector<int> vec(ref.begin(), ref.end());
+      ft::deque<int> deq(ref.begin(), ref.end());
+      std::sort(ref.begin(), ref.end());
+      ft::parallel_sort(vec.begin(), vec.end(), std::less<int>(),
+                        threads[t]);
+      ft::parallel_sort(deq.begin(), deq.end(), std::less<int>(),
+                        threads[t]);
+      if (!std::equal(ref.begin(), ref.end(), vec.begin())
+          || !std::equal(ref.begin(), ref.end(), deq.begin()))
+      {
+        return ALGORITHM_TEST_ERROR(KO_PARALLEL_SORT);
+      }
+    }
+  }
+  ft::vector<std::string> words;
+  std::vector<std::string> ref;
+  for (int i = 0; i < 40000; i++) {
+    words.push_back(std::string(1 + rand() % 4, char('a' + rand() % 26)));
+    ref.push_back(words.back());
+  }
+  ft::parallel_sort(words.begin(), words.end(), std::greater<std::string>(),
+                    2);
+  std::sort(ref.begin(), ref.end(), std::greater<std::string>());
+  ft::vector<int> small(100, 1);
+  ft::parallel_sort(small.begin(), small.end());
+  if (!std::equal(ref.begin(), ref.end(), words.begin())) {
+    return ALGORITHM_TEST_ERROR(KO_PARALLEL_SORT);
+  }
+  return ALGORITHM_TEST_OK(PARALLEL_SORT_TAG);
+}
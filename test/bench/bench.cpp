@@ -0,0 +1,375 @@
+#include "bench.hpp"
+#include "generators.hpp"
+#include <time.h>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/* Set by the Makefile's build profiles (make release, ...). */
+#ifndef FT_BENCH_PROFILE
+# define FT_BENCH_PROFILE "default"
+#endif
+
+namespace bench {
+
+namespace {
+
+struct record {
+  std::string name;
+  std::string impl;
+  long        arg;
+  stats       result;
+};
+
+std::vector<record> records;
+
+std::string row_filter;
+bool        isolated_runs = false;
+bool        listing = false;
+
+// The last header() and caption(), until a row prints them.
+bool        header_pending = false;
+const char* header_titles[2];
+std::string pending_caption;
+
+int env_int( const char* name, int fallback ) {
+  const char* value = std::getenv(name);
+  if (!value || !*value) {
+    return fallback;
+  }
+  int n = std::atoi(value);
+  return n > 0 ? n : fallback;
+}
+
+/* Nearest rank : the smallest sample with at least p of them below. */
+double percentile( const std::vector<double>& sorted, double p ) {
+  size_t rank = size_t(p * sorted.size() + 0.999999);
+  if (rank == 0) {
+    rank = 1;
+  }
+  return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+std::string json_string( const std::string& s ) {
+  std::string out = "\"";
+  for (size_t i = 0; i < s.size(); i++) {
+    if (s[i] == '"' || s[i] == '\\') {
+      out += '\\';
+    }
+    out += s[i];
+  }
+  return out + "\"";
+}
+
+void print_stats( const stats& s ) {
+  std::cout << std::setw(9) << s.min << std::setw(9) << s.median
+            << std::setw(9) << s.max;
+}
+
+bool counted( const stats& s ) {
+  for (int c = 0; c < COUNTERS; c++) {
+    if (s.counts[c] >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool allocated( const stats& s ) {
+  return s.allocations > 0 || s.peak_bytes > 0;
+}
+
+/* "  ft    heap 1.00 allocs/op  48.00 B/op  peak 48000 B" */
+void print_heap( const char* impl, const stats& s ) {
+  std::cout << "  " << std::left << std::setw(5) << impl << std::right
+            << " heap " << s.allocations << " allocs/op  "
+            << s.bytes_allocated << " B/op  peak " << std::setprecision(0)
+            << s.peak_bytes << " B" << std::setprecision(2) << std::endl;
+}
+
+/* "  ft   cycles 812.3  instructions 1540.0  ...  IPC 1.90" */
+void print_counts( const char* impl, const stats& s ) {
+  std::cout << "  " << std::left << std::setw(5) << impl << std::right;
+  for (int c = 0; c < COUNTERS; c++) {
+    std::cout << " " << counter_name(c) << " ";
+    if (s.counts[c] < 0) {
+      std::cout << "-";
+    } else {
+      std::cout << s.counts[c];
+    }
+  }
+  if (s.counts[CYCLES] > 0 && s.counts[INSTRUCTIONS] >= 0) {
+    std::cout << "  IPC " << s.counts[INSTRUCTIONS] / s.counts[CYCLES];
+  }
+  std::cout << std::endl;
+}
+
+/* Warm-up calls then samples, in this process. */
+stats measure( case_fn fn, long arg ) {
+  for (int i = 0; i < warmup(); i++) {
+    state s(arg);
+    fn(s);
+  }
+  std::vector<double> per_op;
+  std::vector<double> counts[COUNTERS];
+  std::vector<double> allocations;
+  std::vector<double> bytes_allocated;
+  std::vector<double> peak_bytes;
+  long ops = 0;
+  for (int i = samples(); i > 0; i--) {
+    state s(arg);
+    fn(s);
+    ops = s.ops() > 0 ? s.ops() : 1;
+    per_op.push_back(double(s.elapsed_ns()) / ops);
+    allocations.push_back(double(s.heap().allocations) / ops);
+    bytes_allocated.push_back(double(s.heap().bytes_allocated) / ops);
+    peak_bytes.push_back(double(s.heap().peak_bytes));
+    for (int c = 0; c < COUNTERS; c++) {
+      if (s.count(c) >= 0) {
+        counts[c].push_back(s.count(c) / ops);
+      }
+    }
+  }
+  std::sort(per_op.begin(), per_op.end());
+
+  stats result;
+  result.min = per_op.front();
+  result.median = percentile(per_op, 0.5);
+  result.max = per_op.back();
+  result.ops = ops;
+  for (int c = 0; c < COUNTERS; c++) {
+    std::sort(counts[c].begin(), counts[c].end());
+    result.counts[c] = counts[c].empty() ? -1 : percentile(counts[c], 0.5);
+  }
+  std::sort(allocations.begin(), allocations.end());
+  std::sort(bytes_allocated.begin(), bytes_allocated.end());
+  std::sort(peak_bytes.begin(), peak_bytes.end());
+  result.allocations = percentile(allocations, 0.5);
+  result.bytes_allocated = percentile(bytes_allocated, 0.5);
+  result.peak_bytes = percentile(peak_bytes, 0.5);
+  return result;
+}
+
+
+/*
+ * measure() in a child process forked for it, which sends the stats
+ * back through a pipe. A child that dies takes the whole run down :
+ * a benchmark that crashes is a bug to look at, not a row to skip.
+ */
+stats measure_in_child( const std::string& name, const char* impl,
+                        case_fn fn, long arg )
+{
+  stats result;
+  int fds[2];
+  counters_prepare();
+  std::cout.flush();
+  std::cerr.flush();
+  if (pipe(fds) != 0) {
+    std::perror("bench: pipe");
+    std::exit(2);
+  }
+  pid_t pid = fork();
+  if (pid < 0) {
+    std::perror("bench: fork");
+    std::exit(2);
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    counters_after_fork();
+    result = measure(fn, arg);
+    ssize_t written = write(fds[1], &result, sizeof(result));
+    _exit(written == ssize_t(sizeof(result)) ? 0 : 1);
+  }
+  close(fds[1]);
+  ssize_t got = read(fds[0], &result, sizeof(result));
+  close(fds[0]);
+  int status;
+  waitpid(pid, &status, 0);
+  if (got != ssize_t(sizeof(result)) || !WIFEXITED(status)
+      || WEXITSTATUS(status) != 0)
+  {
+    std::cerr << "bench: " << name << " (" << impl << ") failed";
+    if (WIFSIGNALED(status)) {
+      std::cerr << ", signal " << WTERMSIG(status);
+    }
+    std::cerr << std::endl;
+    std::exit(2);
+  }
+  return result;
+}
+
+void print_header() {
+  if (!pending_caption.empty()) {
+    std::cout << pending_caption << std::endl;
+    pending_caption.clear();
+  }
+  std::cout << "ns/op, " << samples() << " samples, seed " << seed()
+            << ", " << profile() << " build" << std::endl;
+  std::cout << std::left << std::setw(30) << "" << std::right
+            << std::setw(27) << header_titles[0] << " |"
+            << std::setw(27) << header_titles[1] << " |" << std::endl;
+  std::cout << std::left << std::setw(30) << "case" << std::right
+            << "      min   median      max |"
+            << "      min   median      max |  speedup" << std::endl;
+  header_pending = false;
+}
+
+} /* namespace */
+
+uint64_t now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return uint64_t(ts.tv_sec) * 1000000000ULL + uint64_t(ts.tv_nsec);
+}
+
+const char* profile() {
+  return FT_BENCH_PROFILE;
+}
+
+int samples() {
+  return env_int("FT_BENCH_SAMPLES", 11);
+}
+
+int warmup() {
+  return env_int("FT_BENCH_WARMUP", 2);
+}
+
+long max_size() {
+  return env_int("FT_BENCH_MAX_SIZE", 1000);
+}
+
+stats run( const std::string& name, const char* impl, case_fn fn,
+           long arg )
+{
+  stats result = isolated_runs ? measure_in_child(name, impl, fn, arg)
+                               : measure(fn, arg);
+  record r;
+  r.name = name;
+  r.impl = impl;
+  r.arg = arg;
+  r.result = result;
+  records.push_back(r);
+  return result;
+}
+
+void header( const char* ft_title, const char* ref_title ) {
+  header_titles[0] = ft_title;
+  header_titles[1] = ref_title;
+  header_pending = true;
+  pending_caption.clear();
+}
+
+void caption( const std::string& line ) {
+  pending_caption = line;
+}
+
+bool selected( const std::string& name ) {
+  if (name.find(row_filter) == std::string::npos) {
+    return false;
+  }
+  if (listing) {
+    std::cout << "  " << name << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void row( const std::string& name, case_fn ft_fn, case_fn ref_fn,
+          long arg )
+{
+  if (!selected(name)) {
+    return ;
+  }
+  if (header_pending) {
+    print_header();
+  }
+  stats ft = run(name, "ft", ft_fn, arg);
+  stats ref = run(name, "std", ref_fn, arg);
+
+  std::ios::fmtflags flags = std::cout.flags();
+  std::streamsize precision = std::cout.precision();
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << std::left << std::setw(30) << name << std::right;
+  print_stats(ft);
+  std::cout << " |";
+  print_stats(ref);
+  std::cout << " |" << std::setw(8) << (ft.median > 0 ? ref.median / ft.median
+                                                       : 0.0)
+            << "x" << std::endl;
+  std::cout << std::setprecision(2);
+  if (counted(ft) || counted(ref)) {
+    print_counts("ft", ft);
+    print_counts("std", ref);
+  }
+  if (allocated(ft) || allocated(ref)) {
+    print_heap("ft", ft);
+    print_heap("std", ref);
+  }
+  std::cout.flags(flags);
+  std::cout.precision(precision);
+}
+
+std::string with_arg( const std::string& name, long arg ) {
+  std::ostringstream out;
+  out << name << " " << arg;
+  return out.str();
+}
+
+void set_filter( const std::string& filter ) {
+  row_filter = filter;
+}
+
+void set_isolated( bool isolated ) {
+  isolated_runs = isolated;
+}
+
+void set_listing( bool list ) {
+  listing = list;
+}
+
+void write_json() {
+  const char* path = std::getenv("FT_BENCH_JSON");
+  if (!path || !*path) {
+    return ;
+  }
+  FILE* out = std::fopen(path, "w");
+  if (!out) {
+    std::perror(path);
+    return ;
+  }
+  std::fprintf(out, "{\n  \"unit\": \"ns/op\",\n  \"profile\": %s,\n"
+                    "  \"samples\": %d,\n  \"seed\": %llu,\n"
+                    "  \"benchmarks\": [", json_string(profile()).c_str(),
+               samples(), (unsigned long long)seed());
+  for (size_t i = 0; i < records.size(); i++) {
+    const record& r = records[i];
+    std::fprintf(out, "%s\n    { \"name\": %s, \"impl\": %s, \"arg\": %ld,"
+                      " \"ops\": %ld, \"min\": %.3f, \"median\": %.3f,"
+                      " \"max\": %.3f",
+                 i ? "," : "", json_string(r.name).c_str(),
+                 json_string(r.impl).c_str(), r.arg, r.result.ops,
+                 r.result.min, r.result.median, r.result.max);
+    for (int c = 0; c < COUNTERS; c++) {
+      if (r.result.counts[c] >= 0) {
+        std::fprintf(out, ", \"%s\": %.3f", counter_name(c),
+                     r.result.counts[c]);
+      }
+    }
+    if (allocated(r.result)) {
+      std::fprintf(out, ", \"allocations\": %.3f, \"bytes_allocated\": %.3f,"
+                        " \"peak_bytes\": %.0f", r.result.allocations,
+                   r.result.bytes_allocated, r.result.peak_bytes);
+    }
+    std::fprintf(out, " }");
+  }
+  std::fprintf(out, "\n  ]\n}\n");
+  std::fclose(out);
+}
+
+} /* namespace bench */
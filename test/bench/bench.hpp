@@ -0,0 +1,235 @@
+#ifndef CONTAINERS_BENCH_HPP
+# define CONTAINERS_BENCH_HPP
+# pragma once
+
+#include <stdint.h>
+#include <string>
+#include "ft/counting_allocator.hpp"
+
+/*
+ * Micro-benchmark harness.
+ *
+ * A case is a function that builds what it needs, then times one
+ * sample of work between state.start() and state.stop(ops), ops being
+ * the number of operations done in between :
+ *
+ *    static void ft_find( bench::state& state ) {
+ *      ft::map<int, int> m = ...;             // not timed
+ *      state.start();
+ *      for (long i = 0; i < state.arg(); i++) {
+ *        bench::do_not_optimize(m.find(i));
+ *      }
+ *      state.stop(state.arg());
+ *    }
+ *
+ * Benchmarks live in containers_bench (test/bench/main.cpp), which
+ * can pick rows by name and pin to a CPU. There, every run() happens
+ * in a child process forked for it : each implementation starts from
+ * the same heap, not from what the row before left in malloc's free
+ * lists.
+ *
+ * The harness calls the case bench::warmup() times (discarded), then
+ * bench::samples() times, each one a fresh call, and reports the min,
+ * median and max time per operation of those samples. The min is the
+ * least disturbed run, the median the typical one, the max the worst.
+ * A dozen samples make no tail percentile, so none is claimed. A
+ * sample should last at least a millisecond or so, the clock being
+ * good to ~20ns.
+ *
+ * Time is CLOCK_MONOTONIC through clock_gettime, in nanoseconds. The
+ * headers and the JSON say which build profile ran (make release,
+ * lto, pgo, debug) : timings of the plain make build are -O0.
+ *
+ *    FT_BENCH_SAMPLES=n    samples per case (default 11)
+ *    FT_BENCH_WARMUP=n     warm-up calls per case (default 2)
+ *    FT_BENCH_MAX_SIZE=n   largest size for the benchmarks that go
+ *                          through several (default 1000)
+ *    FT_BENCH_JSON=path    every result also goes to path, as JSON,
+ *                          when bench::write_json() runs
+ *    FT_BENCH_PERF=1       hardware counters too (make bench PERF=1)
+ *
+ * With FT_BENCH_PERF, every sample also counts cycles, instructions,
+ * L1d and last level cache misses and branch misses between start()
+ * and stop(), through perf_event_open(2), user space only. Each row
+ * then gets a line of counts per operation for ft and std (medians
+ * over the samples). Counters the kernel or the CPU do not give
+ * (perf_event_paranoid, no PMU in a VM, not Linux) print as "-" and
+ * are explained once on stderr. With none at all, rows print as
+ * without FT_BENCH_PERF.
+ */
+
+/*
+ * Cases whose containers use ft::counting_allocator (default
+ * constructed, so counting into ft::default_allocation_stats()) also
+ * get their allocations between start() and stop() : allocations and
+ * bytes per operation, and the peak of live bytes over the sample.
+ * Rows print them on one more line when there were any.
+ */
+
+namespace bench {
+
+uint64_t now_ns();
+
+enum counter {
+  CYCLES,
+  INSTRUCTIONS,
+  L1D_MISSES,
+  LLC_MISSES,
+  BRANCH_MISSES,
+  COUNTERS
+};
+
+/* Whether FT_BENCH_PERF asked for counters, even if none opened. */
+bool counters_enabled();
+
+/* Zeroes and starts the counters that opened. */
+void counters_start();
+
+/* Stops them, counts[c] is what counter c saw, or -1 if it did not open. */
+void counters_stop( double* counts );
+
+/* Opens them now, so that what cannot be counted is said once, here. */
+void counters_prepare();
+
+/*
+ * In a child process : what the parent opened counts the parent, the
+ * child opens its own group, quietly.
+ */
+void counters_after_fork();
+
+const char* counter_name( int c );
+
+/*
+ * value is computed and kept, whatever the optimizer thinks of it.
+ * See :
+ * https://github.com/google/benchmark/blob/main/docs/user_guide.md
+ */
+template < typename T >
+inline void do_not_optimize( const T& value ) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/* Memory writes before this point are done, reads after it redone. */
+inline void clobber_memory() {
+  asm volatile("" : : : "memory");
+}
+
+class state {
+
+  long     _arg;
+  uint64_t _start;
+  uint64_t _elapsed;
+  long     _ops;
+  double   _counts[COUNTERS];
+  ft::allocation_stats _heap;  // deltas once stopped
+
+  public:
+
+  explicit state( long arg ) : _arg(arg), _start(0), _elapsed(0), _ops(0) {
+    for (int c = 0; c < COUNTERS; c++) {
+      _counts[c] = -1;
+    }
+  }
+
+  /* The size (or any parameter) the case was registered with. */
+  long arg() const { return _arg; }
+
+  void start() {
+    ft::allocation_stats& heap = ft::default_allocation_stats();
+    heap.peak_bytes = heap.live_bytes;
+    _heap = heap;
+    counters_start();
+    _start = now_ns();
+  }
+
+  void stop( long ops ) {
+    _elapsed = now_ns() - _start;
+    counters_stop(_counts);
+    const ft::allocation_stats& heap = ft::default_allocation_stats();
+    _heap.allocations = heap.allocations - _heap.allocations;
+    _heap.deallocations = heap.deallocations - _heap.deallocations;
+    _heap.bytes_allocated = heap.bytes_allocated - _heap.bytes_allocated;
+    _heap.bytes_deallocated = heap.bytes_deallocated
+                              - _heap.bytes_deallocated;
+    _heap.peak_bytes = heap.peak_bytes - _heap.live_bytes;
+    _heap.live_bytes = heap.live_bytes - _heap.live_bytes;
+    _ops = ops;
+  }
+
+  uint64_t elapsed_ns() const { return _elapsed; }
+  long ops() const { return _ops; }
+  double count( int c ) const { return _counts[c]; }
+  const ft::allocation_stats& heap() const { return _heap; }
+};
+
+typedef void (*case_fn)( state& );
+
+/* Nanoseconds per operation. */
+struct stats {
+  double min;
+  double median;
+  double max;
+  long   ops;  // per sample
+  double counts[COUNTERS];  // per operation, -1 when not counted
+  double allocations;       // per operation
+  double bytes_allocated;   // per operation
+  double peak_bytes;        // per sample, above what was live at start()
+};
+
+/* The build profile : debug, release, lto, pgo, or default (make). */
+const char* profile();
+
+int samples();
+int warmup();
+long max_size();
+
+/*
+ * Measures fn and records the result under name / impl for the
+ * JSON report. Prints nothing.
+ */
+stats run( const std::string& name, const char* impl, case_fn fn,
+           long arg = 0 );
+
+/* Column titles for the rows below. */
+void header( const char* ft_title = "ft", const char* ref_title = "std" );
+
+/*
+ * A line about the rows under the last header() (sizes, threads...),
+ * printed along with it : not at all when they are all filtered out.
+ */
+void caption( const std::string& line );
+
+/*
+ * Runs ft_fn then ref_fn and prints one row : min / median / max of
+ * both, and how many times faster ft's median is. The last header()
+ * is printed before the first row under it that is not filtered out.
+ */
+void row( const std::string& name, case_fn ft_fn, case_fn ref_fn,
+          long arg = 0 );
+
+/*
+ * For a measurement that is not a row : whether row(name, ...) would
+ * measure, that is name passes the filter and is not only listed (it
+ * is then listed here, like a row).
+ */
+bool selected( const std::string& name );
+
+/* name followed by arg : "find hit" 1000 -> "find hit 1000". */
+std::string with_arg( const std::string& name, long arg );
+
+/*
+ * What containers_bench asks of row() : only the rows whose name
+ * contains filter (all when empty), each implementation measured in a
+ * child process of its own when isolated, and with listing the row
+ * names printed instead of measured.
+ */
+void set_filter( const std::string& filter );
+void set_isolated( bool isolated );
+void set_listing( bool listing );
+
+/* Writes everything run so far to $FT_BENCH_JSON, if set. */
+void write_json();
+
+} /* namespace bench */
+
+#endif /* CONTAINERS_BENCH_HPP */
@@ -0,0 +1,577 @@
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include "../colors.hpp"
+
+/*
+ * Benchmark regression gate : compares runs of the suite (the
+ * FT_BENCH_JSON files of bench.cpp) with a baseline.
+ *
+ *    containers_bench_check [--tolerance T] BASELINE RUN.json...
+ *    containers_bench_check --write BASELINE RUN.json...
+ *
+ * What is compared is, per row, ft's time over std's, so a baseline
+ * taken on one machine still means something on another : both sides
+ * run on the same CPU, forked from the same process. That is two
+ * ratios, of the samples' medians and of their mins. Over several runs
+ * each gets the median over the runs and its spread (see spread()).
+ *
+ * A row regressed when both ratios went up by more than their band :
+ * T (default 0.25) times the baseline ratio, or three times the larger
+ * spread (baseline's or this time's) when the row is that noisy. One
+ * ratio alone moves between processes on a busy machine (placement,
+ * frequency), a slower ft moves both. A row also regressed when ft
+ * allocates more per operation than in the baseline : that one is
+ * deterministic, no band. So did a baseline row the runs no longer
+ * have : renaming or deleting a row takes a make bench-baseline, not
+ * a quieter gate. Rows the baseline does not have yet are only shown.
+ *
+ * Runs and baseline must come from the same build profile (make
+ * release, ...) : -O0 and -O3 ratios have nothing to do with each
+ * other.
+ *
+ * Exit status 1 when a row regressed or went missing, 2 on a usage or
+ * file error (a row recorded twice in a run is one).
+ * make bench-check runs the suite BENCH_RUNS times and calls this,
+ * make bench-baseline does the same with --write.
+ */
+
+#define CHECK_DEFAULT_TOLERANCE 0.25
+#define CHECK_NOISE_SIGMAS 3.0
+#define CHECK_ALLOCATION_SLACK 0.01
+
+namespace {
+
+typedef std::map<std::string, std::string> object;
+
+/*
+ * Just enough JSON for the files bench.cpp and this tool write : one
+ * object of scalars and a "benchmarks" array of flat objects. Values
+ * are kept as their text, strings unescaped.
+ */
+class reader {
+
+  const std::string& _text;
+  size_t             _at;
+  std::string        _error;
+
+  void skip_space() {
+    while (_at < _text.size() && std::strchr(" \t\r\n", _text[_at])) {
+      _at++;
+    }
+  }
+
+  bool fail( const std::string& what ) {
+    if (_error.empty()) {
+      std::ostringstream out;
+      out << what << " at offset " << _at;
+      _error = out.str();
+    }
+    return false;
+  }
+
+  bool expect( char c ) {
+    skip_space();
+    if (_at >= _text.size() || _text[_at] != c) {
+      return fail(std::string("expected '") + c + "'");
+    }
+    _at++;
+    return true;
+  }
+
+  bool peek( char c ) {
+    skip_space();
+    return _at < _text.size() && _text[_at] == c;
+  }
+
+  bool string( std::string& out ) {
+    if (!expect('"')) {
+      return false;
+    }
+    out.clear();
+    while (_at < _text.size() && _text[_at] != '"') {
+      if (_text[_at] == '\\' && _at + 1 < _text.size()) {
+        _at++;
+      }
+      out += _text[_at++];
+    }
+    return expect('"');
+  }
+
+  bool scalar( std::string& out ) {
+    if (peek('"')) {
+      return string(out);
+    }
+    size_t start = _at;
+    while (_at < _text.size() && !std::strchr(",}] \t\r\n", _text[_at])) {
+      _at++;
+    }
+    if (_at == start) {
+      return fail("expected a value");
+    }
+    out = _text.substr(start, _at - start);
+    return true;
+  }
+
+  bool flat_object( object& out ) {
+    if (!expect('{')) {
+      return false;
+    }
+    while (!peek('}')) {
+      std::string key;
+      if (!string(key) || !expect(':') || !scalar(out[key])) {
+        return false;
+      }
+      if (!peek('}') && !expect(',')) {
+        return false;
+      }
+    }
+    return expect('}');
+  }
+
+  public:
+
+  explicit reader( const std::string& text ) : _text(text), _at(0) {}
+
+  const std::string& error() const { return _error; }
+
+  bool document( object& top, std::vector<object>& benchmarks ) {
+    if (!expect('{')) {
+      return false;
+    }
+    while (!peek('}')) {
+      std::string key;
+      if (!string(key) || !expect(':')) {
+        return false;
+      }
+      if (key == "benchmarks") {
+        if (!expect('[')) {
+          return false;
+        }
+        while (!peek(']')) {
+          benchmarks.push_back(object());
+          if (!flat_object(benchmarks.back())) {
+            return false;
+          }
+          if (!peek(']') && !expect(',')) {
+            return false;
+          }
+        }
+        if (!expect(']')) {
+          return false;
+        }
+      } else if (!scalar(top[key])) {
+        return false;
+      }
+      if (!peek('}') && !expect(',')) {
+        return false;
+      }
+    }
+    return expect('}');
+  }
+};
+
+bool load( const std::string& path, object& top,
+           std::vector<object>& benchmarks )
+{
+  std::ifstream in(path.c_str());
+  if (!in) {
+    std::cerr << "bench-check: " << path << ": " << std::strerror(errno)
+              << std::endl;
+    return false;
+  }
+  std::ostringstream text;
+  text << in.rdbuf();
+  std::string content = text.str();
+  reader r(content);
+  if (!r.document(top, benchmarks)) {
+    std::cerr << "bench-check: " << path << ": " << r.error() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+double number( const object& o, const char* key, double fallback = 0 ) {
+  object::const_iterator it = o.find(key);
+  return it == o.end() ? fallback : std::atof(it->second.c_str());
+}
+
+std::string text( const object& o, const char* key ) {
+  object::const_iterator it = o.find(key);
+  return it == o.end() ? "" : it->second;
+}
+
+/* Files from before the build profiles did not say. */
+std::string profile( const object& top ) {
+  std::string name = text(top, "profile");
+  return name.empty() ? "unrecorded" : name;
+}
+
+/* A row : its name and arg. */
+typedef std::pair<std::string, long> row_key;
+
+/*
+ * ft over std, from the samples' medians and from their mins : the
+ * typical run and the least disturbed one.
+ */
+struct row_summary {
+  double ratio;         // of the medians, median over the runs
+  double spread;        // of ratio over the runs
+  double min_ratio;     // of the mins, median over the runs
+  double min_spread;
+  double allocations;   // ft's, per operation
+};
+
+typedef std::map<row_key, row_summary> summary;
+
+double median( std::vector<double> values ) {
+  std::sort(values.begin(), values.end());
+  size_t n = values.size();
+  return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+/*
+ * Standard deviation around center (the median). Not a median absolute
+ * deviation : each side of a row runs in a process of its own, and some
+ * rows land fast in one process and slow in the next. Over three runs
+ * a MAD calls the odd one out noise-free, and the band ends up
+ * narrower than the row's own swing.
+ */
+double spread( const std::vector<double>& values, double center ) {
+  if (values.size() < 2) {
+    return 0;
+  }
+  double squares = 0;
+  for (size_t i = 0; i < values.size(); i++) {
+    squares += (values[i] - center) * (values[i] - center);
+  }
+  return std::sqrt(squares / (values.size() - 1));
+}
+
+/* One implementation's numbers for a row, in one run. */
+struct timing {
+  double median;
+  double min;
+  double allocations;
+};
+
+struct run_rows {
+  std::vector<double> ratios;
+  std::vector<double> min_ratios;
+  std::vector<double> allocations;
+};
+
+/* Reads the runs and folds them into one summary. */
+bool summarize( const std::vector<std::string>& paths, summary& out,
+                object& first_top )
+{
+  std::map<row_key, run_rows> rows;
+  for (size_t i = 0; i < paths.size(); i++) {
+    object top;
+    std::vector<object> benchmarks;
+    if (!load(paths[i], top, benchmarks)) {
+      return false;
+    }
+    if (i == 0) {
+      first_top = top;
+    }
+    std::map<row_key, timing> ft;
+    std::map<row_key, timing> ref;
+    for (size_t b = 0; b < benchmarks.size(); b++) {
+      const object& o = benchmarks[b];
+      timing t;
+      t.median = number(o, "median");
+      t.min = number(o, "min");
+      t.allocations = number(o, "allocations");
+      row_key key(text(o, "name"), long(number(o, "arg")));
+      std::map<row_key, timing>& side = text(o, "impl") == "ft" ? ft : ref;
+      if (!side.insert(std::make_pair(key, t)).second) {
+        std::cerr << "bench-check: " << paths[i] << ": " << key.first
+                  << " (" << key.second << ") recorded twice" << std::endl;
+        return false;
+      }
+    }
+    for (std::map<row_key, timing>::const_iterator it = ft.begin();
+         it != ft.end(); ++it)
+    {
+      std::map<row_key, timing>::const_iterator r = ref.find(it->first);
+      if (r == ref.end() || r->second.median <= 0 || r->second.min <= 0) {
+        continue ;
+      }
+      run_rows& row = rows[it->first];
+      row.ratios.push_back(it->second.median / r->second.median);
+      row.min_ratios.push_back(it->second.min / r->second.min);
+      row.allocations.push_back(it->second.allocations);
+    }
+  }
+  for (std::map<row_key, run_rows>::const_iterator it = rows.begin();
+       it != rows.end(); ++it)
+  {
+    row_summary s;
+    s.ratio = median(it->second.ratios);
+    s.spread = spread(it->second.ratios, s.ratio);
+    s.min_ratio = median(it->second.min_ratios);
+    s.min_spread = spread(it->second.min_ratios, s.min_ratio);
+    s.allocations = median(it->second.allocations);
+    out[it->first] = s;
+  }
+  return true;
+}
+
+std::string json_string( const std::string& s ) {
+  std::string out = "\"";
+  for (size_t i = 0; i < s.size(); i++) {
+    if (s[i] == '"' || s[i] == '\\') {
+      out += '\\';
+    }
+    out += s[i];
+  }
+  return out + "\"";
+}
+
+bool write_baseline( const std::string& path, const summary& rows,
+                     const object& top, size_t runs )
+{
+  FILE* out = std::fopen(path.c_str(), "w");
+  if (!out) {
+    std::perror(path.c_str());
+    return false;
+  }
+  std::fprintf(out, "{\n  \"unit\": \"ft/std time ratio\",\n"
+                    "  \"profile\": %s,\n  \"runs\": %lu,\n"
+                    "  \"samples\": %s,\n  \"seed\": %s,\n"
+                    "  \"benchmarks\": [",
+               json_string(text(top, "profile")).c_str(), (unsigned long)runs,
+               text(top, "samples").c_str(), text(top, "seed").c_str());
+  for (summary::const_iterator it = rows.begin(); it != rows.end(); ++it) {
+    const row_summary& r = it->second;
+    std::fprintf(out, "%s\n    { \"name\": %s, \"arg\": %ld, \"ratio\": %.4f,"
+                      " \"spread\": %.4f, \"min_ratio\": %.4f,"
+                      " \"min_spread\": %.4f, \"allocations\": %.3f }",
+                 it == rows.begin() ? "" : ",",
+                 json_string(it->first.first).c_str(), it->first.second,
+                 r.ratio, r.spread, r.min_ratio, r.min_spread, r.allocations);
+  }
+  std::fprintf(out, "\n  ]\n}\n");
+  return std::fclose(out) == 0;
+}
+
+bool read_baseline( const std::string& path, summary& rows, object& top ) {
+  std::vector<object> benchmarks;
+  if (!load(path, top, benchmarks)) {
+    return false;
+  }
+  for (size_t i = 0; i < benchmarks.size(); i++) {
+    const object& o = benchmarks[i];
+    row_summary s;
+    s.ratio = number(o, "ratio");
+    s.spread = number(o, "spread");
+    s.min_ratio = number(o, "min_ratio");
+    s.min_spread = number(o, "min_spread");
+    s.allocations = number(o, "allocations");
+    rows[row_key(text(o, "name"), long(number(o, "arg")))] = s;
+  }
+  return true;
+}
+
+std::string row_name( const row_key& key ) {
+  std::ostringstream out;
+  out << key.first;
+  if (key.second) {
+    out << " (" << key.second << ")";
+  }
+  return out.str();
+}
+
+void print_ratio( double ratio ) {
+  if (ratio < 0) {
+    std::cout << std::setw(9) << "-";
+  } else {
+    std::cout << std::setw(9) << ratio;
+  }
+}
+
+/* before or after -1 for a row only on one side. */
+void print_line( const char* color, const char* verdict, const row_key& key,
+                 double before, double after, const std::string& note )
+{
+  std::cout << color << std::left << std::setw(10) << verdict
+            << std::setw(40) << row_name(key) << std::right << std::fixed
+            << std::setprecision(3);
+  print_ratio(before);
+  print_ratio(after);
+  if (before > 0 && after >= 0) {
+    std::cout << std::showpos << std::setprecision(1) << std::setw(9)
+              << 100.0 * (after - before) / before << "%" << std::noshowpos;
+  } else {
+    std::cout << std::setw(10) << "";
+  }
+  std::cout << "  " << note << UNSET << std::endl;
+}
+
+/* 0 when nothing regressed or went missing, 1 otherwise. */
+int compare( const summary& baseline, const summary& current,
+             double tolerance )
+{
+  int regressed = 0;
+  int improved = 0;
+  int missing = 0;
+  int added = 0;
+
+  std::cout << std::left << std::setw(10) << "" << std::setw(40)
+            << "ft / std, medians" << std::right << std::setw(9)
+            << "baseline" << std::setw(9) << "now" << std::setw(10)
+            << "change" << "  band" << std::endl;
+
+  for (summary::const_iterator it = baseline.begin(); it != baseline.end();
+       ++it)
+  {
+    summary::const_iterator now = current.find(it->first);
+    if (now == current.end()) {
+      print_line(MAG_BOLD, "MISSING", it->first, it->second.ratio, -1, "");
+      missing++;
+      continue ;
+    }
+    const row_summary& b = it->second;
+    const row_summary& c = now->second;
+    double band = std::max(tolerance * b.ratio,
+                           CHECK_NOISE_SIGMAS * std::max(b.spread, c.spread));
+    double min_band = std::max(tolerance * b.min_ratio,
+                               CHECK_NOISE_SIGMAS * std::max(b.min_spread,
+                                                             c.min_spread));
+    std::ostringstream note;
+    note << std::fixed << std::setprecision(1) << "+-"
+         << (b.ratio > 0 ? 100.0 * band / b.ratio : 0) << "%, min "
+         << std::setprecision(3) << b.min_ratio << " -> " << c.min_ratio;
+
+    if (c.allocations > b.allocations + CHECK_ALLOCATION_SLACK) {
+      std::ostringstream allocations;
+      allocations << std::fixed << std::setprecision(2) << "ft allocs/op "
+                  << b.allocations << " -> " << c.allocations;
+      print_line(RED_BOLD, "REGRESSED", it->first, b.ratio, c.ratio,
+                 allocations.str());
+      regressed++;
+    } else if (c.ratio - b.ratio > band
+               && c.min_ratio - b.min_ratio > min_band)
+    {
+      print_line(RED_BOLD, "REGRESSED", it->first, b.ratio, c.ratio,
+                 note.str());
+      regressed++;
+    } else if (b.ratio - c.ratio > band
+               && b.min_ratio - c.min_ratio > min_band)
+    {
+      print_line(GREEN_BOLD, "improved", it->first, b.ratio, c.ratio,
+                 note.str());
+      improved++;
+    }
+  }
+  for (summary::const_iterator it = current.begin(); it != current.end();
+       ++it)
+  {
+    if (baseline.find(it->first) == baseline.end()) {
+      print_line(BLUE_BOLD, "new", it->first, -1, it->second.ratio, "");
+      added++;
+    }
+  }
+
+  std::cout << baseline.size() << " rows in the baseline : " << regressed
+            << " regressed, " << improved << " improved, " << missing
+            << " missing, " << added << " new" << std::endl;
+  if (regressed || missing) {
+    std::cout << RED_BOLD << "bench-check: FAILED" << UNSET << std::endl;
+    if (missing) {
+      std::cout << "make bench-baseline to drop the rows that went away"
+                << std::endl;
+    }
+  } else if (added) {
+    std::cout << "bench-check: passed, make bench-baseline to pick up the"
+              << " new rows" << std::endl;
+  } else {
+    std::cout << GREEN_BOLD << "bench-check: passed" << UNSET << std::endl;
+  }
+  return regressed || missing ? 1 : 0;
+}
+
+int usage( const char* self ) {
+  std::cerr << "usage: " << self << " [--tolerance T] BASELINE RUN.json..."
+            << std::endl
+            << "       " << self << " --write BASELINE RUN.json..."
+            << std::endl;
+  return 2;
+}
+
+} /* namespace */
+
+int main( int argc, char** argv ) {
+
+  bool write = false;
+  double tolerance = CHECK_DEFAULT_TOLERANCE;
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-'; i++) {
+    if (!std::strcmp(argv[i], "--write")) {
+      write = true;
+    } else if (!std::strcmp(argv[i], "--tolerance") && i + 1 < argc) {
+      tolerance = std::atof(argv[++i]);
+      if (tolerance <= 0) {
+        return usage(argv[0]);
+      }
+    } else {
+      return usage(argv[0]);
+    }
+  }
+  if (argc - i < 2) {
+    return usage(argv[0]);
+  }
+  std::string baseline_path = argv[i++];
+  std::vector<std::string> runs(argv + i, argv + argc);
+
+  summary current;
+  object run_top;
+  if (!summarize(runs, current, run_top)) {
+    return 2;
+  }
+  if (write) {
+    if (!write_baseline(baseline_path, current, run_top, runs.size())) {
+      return 2;
+    }
+    std::cout << "bench-baseline: " << current.size() << " rows from "
+              << runs.size() << " runs written to " << baseline_path
+              << std::endl;
+    return 0;
+  }
+
+  summary baseline;
+  object baseline_top;
+  if (!read_baseline(baseline_path, baseline, baseline_top)) {
+    return 2;
+  }
+  std::cout << "bench-check: " << runs.size() << " runs against "
+            << baseline_path << " (" << text(baseline_top, "runs")
+            << " runs), tolerance " << 100 * tolerance << "%" << std::endl;
+  if (profile(baseline_top) != profile(run_top)) {
+    std::cerr << "bench-check: the baseline is of a " << profile(baseline_top)
+              << " build, these runs of a " << profile(run_top)
+              << " one : make bench-check BENCH_PROFILE="
+              << profile(baseline_top) << ", or make bench-baseline"
+              << std::endl;
+    return 2;
+  }
+  if (text(baseline_top, "seed") != text(run_top, "seed")) {
+    std::cout << MAG_BOLD << "bench-check: the baseline was taken with seed "
+              << text(baseline_top, "seed") << ", these runs with "
+              << text(run_top, "seed") << " : other keys" << UNSET
+              << std::endl;
+  }
+  return compare(baseline, current, tolerance);
+}
@@ -0,0 +1,150 @@
+#include "generators.hpp"
+#include <cmath>
+
+namespace bench {
+
+namespace {
+
+uint64_t current_seed = 42;
+
+const char* const names[DISTRIBUTIONS] = {
+  "sequential", "reverse", "uniform", "zipf", "hotspot", "sliding window"
+};
+
+/* Each distribution gets its own stream of the same seed. */
+rng stream( distribution d ) {
+  return rng(current_seed * 0x2545f4914f6cdd1dULL + uint64_t(d));
+}
+
+/* A bijection of 64 bit integers (splitmix64's finalizer). */
+uint64_t scramble( uint64_t x ) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/*
+ * Gray et al., "Quickly Generating Billion-Record Synthetic
+ * Databases", as in YCSB : a rank in [0, n) with P(r) ~ 1 / (r + 1)^theta.
+ */
+class zipf_ranks {
+
+  double _n;
+  double _theta;
+  double _alpha;
+  double _zetan;
+  double _eta;
+
+  public:
+
+  zipf_ranks( unsigned long n, double theta ) : _n(n), _theta(theta) {
+    _zetan = 0;
+    for (unsigned long i = 1; i <= n; i++) {
+      _zetan += 1.0 / std::pow(double(i), theta);
+    }
+    double zeta2 = 1.0 + 1.0 / std::pow(2.0, theta);
+    _alpha = 1.0 / (1.0 - theta);
+    _eta = (1.0 - std::pow(2.0 / _n, 1.0 - theta)) / (1.0 - zeta2 / _zetan);
+  }
+
+  unsigned long operator()( rng& r ) const {
+    double u = r.unit();
+    double uz = u * _zetan;
+    if (uz < 1.0) {
+      return 0;
+    }
+    if (uz < 1.0 + std::pow(0.5, _theta)) {
+      return 1;
+    }
+    unsigned long rank = (unsigned long)(_n * std::pow(_eta * u - _eta + 1.0,
+                                                       _alpha));
+    return rank < _n ? rank : (unsigned long)(_n) - 1;
+  }
+};
+
+} /* namespace */
+
+uint64_t seed() {
+  return current_seed;
+}
+
+void set_seed( uint64_t seed ) {
+  current_seed = seed;
+}
+
+const char* distribution_name( int d ) {
+  return names[d];
+}
+
+std::vector<unsigned long> draw( distribution d, long count,
+                                 unsigned long universe )
+{
+  std::vector<unsigned long> keys;
+  if (count <= 0 || universe == 0) {
+    return keys;
+  }
+  keys.reserve(count);
+  rng r = stream(d);
+
+  switch (d) {
+    case SEQUENTIAL:
+      for (long i = 0; i < count; i++) {
+        keys.push_back(i % universe);
+      }
+      break ;
+    case REVERSE:
+      for (long i = 0; i < count; i++) {
+        keys.push_back(universe - 1 - i % universe);
+      }
+      break ;
+    case ZIPF: {
+      zipf_ranks ranks(universe, 0.99);
+      for (long i = 0; i < count; i++) {
+        keys.push_back(scramble(ranks(r)) % universe);
+      }
+      break ;
+    }
+    case HOTSPOT: {
+      unsigned long hot = universe / 10 ? universe / 10 : 1;
+      unsigned long offset = r.below(universe);
+      for (long i = 0; i < count; i++) {
+        if (r.below(10) < 9) {
+          keys.push_back((offset + r.below(hot)) % universe);
+        } else {
+          keys.push_back(r.below(universe));
+        }
+      }
+      break ;
+    }
+    case SLIDING_WINDOW: {
+      unsigned long window = universe / 64 ? universe / 64 : 1;
+      double step = double(universe - window) / (count > 1 ? count - 1 : 1);
+      for (long i = 0; i < count; i++) {
+        keys.push_back((unsigned long)(i * step) + r.below(window));
+      }
+      break ;
+    }
+    default:
+      for (long i = 0; i < count; i++) {
+        keys.push_back(r.below(universe));
+      }
+  }
+  return keys;
+}
+
+std::vector<unsigned long> shuffled( long n ) {
+  std::vector<unsigned long> order(n);
+  for (long i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  rng r = stream(DISTRIBUTIONS);
+  for (long i = n - 1; i > 0; i--) {
+    unsigned long j = r.below(i + 1);
+    unsigned long tmp = order[i];
+    order[i] = order[j];
+    order[j] = tmp;
+  }
+  return order;
+}
+
+} /* namespace bench */
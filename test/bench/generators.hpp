@@ -0,0 +1,82 @@
+#ifndef CONTAINERS_GENERATORS_HPP
+# define CONTAINERS_GENERATORS_HPP
+# pragma once
+
+#include <stdint.h>
+#include <vector>
+
+/*
+ * Deterministic key streams for the benchmarks. Everything random here
+ * derives from bench::seed() (--seed on the command line, 42 if not
+ * given), so a run is reproduced by passing the seed it printed.
+ *
+ * A stream is count indices in [0, universe), turned into keys by the
+ * benchmark. The distributions :
+ *
+ *    sequential      0, 1, 2, ... (wrapping past universe)
+ *    reverse         universe - 1, universe - 2, ...
+ *    uniform         every index equally likely
+ *    zipf            rank r drawn with probability ~ 1 / r^0.99 (YCSB's
+ *                    constant), ranks scattered over the universe by a
+ *                    hash so the hot keys are not neighbours
+ *    hotspot         90% of the draws in a contiguous 10% of the
+ *                    universe, at a random offset, the rest uniform
+ *    sliding window  uniform in a window of universe / 64 indices that
+ *                    moves from the bottom of the universe to the top
+ *                    over the stream : recent keys, as with timestamps
+ *
+ * See :
+ * https://github.com/brianfrankcooper/YCSB/blob/master/core/src/main/java/site/ycsb/generator/ZipfianGenerator.java
+ * https://prng.di.unimi.it/splitmix64.c
+ */
+
+namespace bench {
+
+uint64_t seed();
+void set_seed( uint64_t seed );
+
+/* splitmix64 : tiny, fast, and good enough for key streams. */
+class rng {
+
+  uint64_t _state;
+
+  public:
+
+  explicit rng( uint64_t seed ) : _state(seed) {}
+
+  uint64_t next() {
+    uint64_t z = (_state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  /* In [0, n), n > 0. The modulo bias is below 2^-32 for n < 2^32. */
+  uint64_t below( uint64_t n ) { return next() % n; }
+
+  /* In [0, 1). */
+  double unit() { return double(next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+enum distribution {
+  SEQUENTIAL,
+  REVERSE,
+  UNIFORM,
+  ZIPF,
+  HOTSPOT,
+  SLIDING_WINDOW,
+  DISTRIBUTIONS
+};
+
+const char* distribution_name( int d );
+
+/* count indices in [0, universe) following d. */
+std::vector<unsigned long> draw( distribution d, long count,
+                                 unsigned long universe );
+
+/* 0 .. n-1, each once, in a random order. */
+std::vector<unsigned long> shuffled( long n );
+
+} /* namespace bench */
+
+#endif /* CONTAINERS_GENERATORS_HPP */
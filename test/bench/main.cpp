@@ -0,0 +1,181 @@
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#ifdef __linux__
+# include <sched.h>
+#endif
+
+#include "../test.hpp"
+#include "bench.hpp"
+#include "generators.hpp"
+
+/*
+ * containers_bench : the performance tests, apart from the correctness
+ * ones (containers_test).
+ *
+ *    containers_bench [--seed N] [--filter TEXT] [--cpu N] [--list]
+ *                     [--no-fork] [SUITE...]
+ *
+ *    SUITE          only these suites (vector, map, ...), all by default
+ *    --filter TEXT  only the rows whose name contains TEXT
+ *    --cpu N        pinned to CPU N, children included
+ *    --list         the suites and their rows, nothing measured
+ *    --seed N       the seed of every key stream (generators.hpp)
+ *    --no-fork      everything in this one process
+ *
+ * Every measurement runs in a process of its own, forked from this one
+ * : each implementation of each row (see bench::run). None starts from
+ * the heap another one left.
+ */
+
+struct suite {
+  const char* name;
+  void        (*run)();
+};
+
+static const suite suites[] = {
+  { "vector", vector_performance },
+  { "stack", stack_performance },
+  { "queue", queue_performance },
+  { "ring_buffer", ring_buffer_performance },
+  { "concurrent", concurrent_performance },
+  { "map", map_performance },
+  { "set", set_performance },
+  { "algorithm", algorithm_performance }
+};
+
+#define SUITES (sizeof(suites) / sizeof(suites[0]))
+
+struct options {
+  bool        selected[SUITES];
+  bool        any_selected;
+  std::string filter;
+  long        cpu;   // -1 : not pinned
+  bool        list;
+  bool        fork;
+};
+
+static int usage( const char* self ) {
+  std::cerr << "usage: " << self << " [--seed N] [--filter TEXT] [--cpu N]"
+            << " [--list] [--no-fork] [SUITE...]" << std::endl
+            << "suites:";
+  for (size_t i = 0; i < SUITES; i++) {
+    std::cerr << " " << suites[i].name;
+  }
+  std::cerr << std::endl;
+  return 1;
+}
+
+/* "--name value" or "--name=value" at argv[i], advancing i past it. */
+static bool option( int argc, char** argv, int& i, const char* name,
+                    const char*& value )
+{
+  size_t length = std::strlen(name);
+  if (std::strncmp(argv[i], name, length) != 0) {
+    return false;
+  }
+  if (argv[i][length] == '=') {
+    value = argv[i] + length + 1;
+    return true;
+  }
+  if (argv[i][length] == '\0' && i + 1 < argc) {
+    value = argv[++i];
+    return true;
+  }
+  return false;
+}
+
+static bool number( const char* text, unsigned long long& out ) {
+  char* end;
+  out = std::strtoull(text, &end, 10);
+  return *text && !*end;
+}
+
+static bool parse( int argc, char** argv, options& opts ) {
+  for (size_t s = 0; s < SUITES; s++) {
+    opts.selected[s] = false;
+  }
+  opts.any_selected = false;
+  opts.cpu = -1;
+  opts.list = false;
+  opts.fork = true;
+
+  for (int i = 1; i < argc; i++) {
+    const char* value;
+    unsigned long long n;
+    if (option(argc, argv, i, "--seed", value)) {
+      if (!number(value, n)) {
+        return false;
+      }
+      bench::set_seed(n);
+    } else if (option(argc, argv, i, "--filter", value)) {
+      opts.filter = value;
+    } else if (option(argc, argv, i, "--cpu", value)) {
+      if (!number(value, n)) {
+        return false;
+      }
+      opts.cpu = long(n);
+    } else if (!std::strcmp(argv[i], "--list")) {
+      opts.list = true;
+    } else if (!std::strcmp(argv[i], "--no-fork")) {
+      opts.fork = false;
+    } else {
+      size_t s = 0;
+      while (s < SUITES && std::strcmp(argv[i], suites[s].name) != 0) {
+        s++;
+      }
+      if (s == SUITES) {
+        return false;
+      }
+      opts.selected[s] = true;
+      opts.any_selected = true;
+    }
+  }
+  return true;
+}
+
+static bool pin( long cpu ) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  if (cpu >= CPU_SETSIZE || sched_setaffinity(0, sizeof(set), &set) != 0) {
+    std::perror("containers_bench: --cpu");
+    return false;
+  }
+  return true;
+#else
+  (void)cpu;
+  std::cerr << "containers_bench: --cpu needs Linux" << std::endl;
+  return false;
+#endif
+}
+
+int main( int argc, char** argv ) {
+
+  options opts;
+  if (!parse(argc, argv, opts)) {
+    return usage(argv[0]);
+  }
+  if (opts.cpu >= 0 && !pin(opts.cpu)) {
+    return 1;
+  }
+  bench::set_filter(opts.filter);
+  bench::set_isolated(opts.fork);
+  bench::set_listing(opts.list);
+
+  for (size_t i = 0; i < SUITES; i++) {
+    if (opts.any_selected && !opts.selected[i]) {
+      continue ;
+    }
+    if (opts.list) {
+      std::cout << suites[i].name << std::endl;
+    }
+    suites[i].run();
+  }
+
+  bench::write_json();
+  return 0;
+}
@@ -0,0 +1,234 @@
+#include "bench.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+
+#ifdef __linux__
+# include <linux/perf_event.h>
+# include <sys/syscall.h>
+# include <sys/ioctl.h>
+# include <unistd.h>
+#endif
+
+/*
+ * The counters are one perf_event_open group on this thread, so they
+ * start and stop together : the first one that opens leads, the
+ * others join it. A counter the kernel refuses is left out of the
+ * group and reads -1. When the PMU is shared (other groups, the NMI
+ * watchdog), the kernel multiplexes and the counts are scaled by
+ * time enabled / time running.
+ *
+ * See :
+ * https://man7.org/linux/man-pages/man2/perf_event_open.2.html
+ */
+
+namespace bench {
+
+namespace {
+
+const char* const names[COUNTERS] = {
+  "cycles", "instructions", "L1d-misses", "LLC-misses", "branch-misses"
+};
+
+bool requested() {
+  const char* value = std::getenv("FT_BENCH_PERF");
+  return value && *value && std::strcmp(value, "0") != 0;
+}
+
+#ifdef __linux__
+
+struct group {
+  bool opened;
+  int  leader;
+  int  fd[COUNTERS];     // -1 when not counted
+  int  slot[COUNTERS];   // position in the group read
+  int  members;
+};
+
+group counters = { false, -1, { -1, -1, -1, -1, -1 }, { 0 }, 0 };
+
+void describe( int c, perf_event_attr& attr ) {
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  switch (c) {
+    case CYCLES:
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break ;
+    case INSTRUCTIONS:
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break ;
+    case L1D_MISSES:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_L1D
+                    | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                    | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break ;
+    case LLC_MISSES:
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      break ;
+    case BRANCH_MISSES:
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break ;
+  }
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                     | PERF_FORMAT_TOTAL_TIME_RUNNING;
+}
+
+void explain( int error ) {
+  std::cerr << "bench: no hardware counters (" << std::strerror(error);
+  if (error == EACCES || error == EPERM) {
+    FILE* paranoid = std::fopen("/proc/sys/kernel/perf_event_paranoid", "r");
+    int level;
+    if (paranoid && std::fscanf(paranoid, "%d", &level) == 1) {
+      std::cerr << ", kernel.perf_event_paranoid is " << level
+                << ", 2 or less is needed";
+    }
+    if (paranoid) {
+      std::fclose(paranoid);
+    }
+  } else if (error == ENOENT || error == EOPNOTSUPP) {
+    std::cerr << ", no PMU : a VM or container without it";
+  }
+  std::cerr << "), timings only" << std::endl;
+}
+
+/* quiet : the parent process already said what could not be counted. */
+void open_counters( bool quiet ) {
+  counters.opened = true;
+  int first_error = 0;
+  for (int c = 0; c < COUNTERS; c++) {
+    perf_event_attr attr;
+    describe(c, attr);
+    int fd = syscall(SYS_perf_event_open, &attr, 0, -1, counters.leader, 0);
+    if (fd < 0) {
+      if (!first_error) {
+        first_error = errno;
+      }
+      continue ;
+    }
+    if (counters.leader < 0) {
+      counters.leader = fd;
+    }
+    counters.fd[c] = fd;
+    counters.slot[c] = counters.members++;
+  }
+  if (quiet) {
+    return ;
+  } else if (counters.leader < 0) {
+    explain(first_error);
+  } else if (first_error) {
+    std::cerr << "bench: not counted (" << std::strerror(first_error) << ") :";
+    for (int c = 0; c < COUNTERS; c++) {
+      if (counters.fd[c] < 0) {
+        std::cerr << " " << names[c];
+      }
+    }
+    std::cerr << std::endl;
+  }
+}
+
+#endif /* __linux__ */
+
+} /* namespace */
+
+bool counters_enabled() {
+  static const bool enabled = requested();
+  return enabled;
+}
+
+const char* counter_name( int c ) {
+  return names[c];
+}
+
+#ifdef __linux__
+
+void counters_start() {
+  if (!counters_enabled()) {
+    return ;
+  }
+  if (!counters.opened) {
+    open_counters(false);
+  }
+  if (counters.leader >= 0) {
+    ioctl(counters.leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(counters.leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+}
+
+void counters_prepare() {
+  if (counters_enabled() && !counters.opened) {
+    open_counters(false);
+  }
+}
+
+void counters_after_fork() {
+  if (!counters.opened) {
+    return ;
+  }
+  bool counted = counters.leader >= 0;
+  for (int c = 0; c < COUNTERS; c++) {
+    if (counters.fd[c] >= 0) {
+      close(counters.fd[c]);
+    }
+    counters.fd[c] = -1;
+  }
+  counters.leader = -1;
+  counters.members = 0;
+  if (counted) {
+    open_counters(true);
+  }
+}
+
+void counters_stop( double* counts ) {
+  for (int c = 0; c < COUNTERS; c++) {
+    counts[c] = -1;
+  }
+  if (!counters_enabled() || counters.leader < 0) {
+    return ;
+  }
+  ioctl(counters.leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+  // nr, time enabled, time running, then one value per member.
+  uint64_t data[3 + COUNTERS];
+  ssize_t size = read(counters.leader, data, sizeof(data));
+  if (size < ssize_t(3 * sizeof(uint64_t)) || data[2] == 0) {
+    return ;
+  }
+  double scale = double(data[1]) / double(data[2]);
+  for (int c = 0; c < COUNTERS; c++) {
+    if (counters.fd[c] >= 0 && uint64_t(counters.slot[c]) < data[0]) {
+      counts[c] = double(data[3 + counters.slot[c]]) * scale;
+    }
+  }
+}
+
+#else
+
+void counters_start() {
+  static bool told = false;
+  if (counters_enabled() && !told) {
+    std::cerr << "bench: hardware counters need Linux, timings only"
+              << std::endl;
+    told = true;
+  }
+}
+
+void counters_stop( double* counts ) {
+  for (int c = 0; c < COUNTERS; c++) {
+    counts[c] = -1;
+  }
+}
+
+void counters_prepare() {}
+
+void counters_after_fork() {}
+
+#endif /* __linux__ */
+
+} /* namespace bench */
@@ -0,0 +1,346 @@
+#ifndef CONTAINERS_TREE_MATRIX_HPP
+# define CONTAINERS_TREE_MATRIX_HPP
+# pragma once
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "bench.hpp"
+#include "generators.hpp"
+
+/*
+ * Per operation benchmarks for the ordered trees (map and set), ft
+ * against std, one row per operation :
+ *
+ *    insert random / sorted / reverse   into an empty tree
+ *    find hit / find miss / lower_bound on a full tree, random order
+ *    iterate / reverse iterate          one full pass
+ *    copy / clear                       the whole tree
+ *    erase key / erase iterator         down to an empty tree
+ *
+ * For each size in 10^3 .. 10^7, up to bench::max_size(). One
+ * operation is one element, so rows of different sizes read as the
+ * cost of one more level in the tree.
+ *
+ * The tree holds the keys 0, 2, 4, ... 2(n-1) : a miss, and what
+ * lower_bound looks for, is an odd key, so it ends on a leaf.
+ *
+ * tree_distributions() then times insert and find with the keys drawn
+ * from each of generators.hpp's distributions, at bench::max_size().
+ */
+
+namespace bench {
+
+/* A 64 byte key, ordered on its first word. */
+struct key64 {
+  uint64_t word[8];
+};
+
+inline bool operator<( const key64& x, const key64& y ) {
+  return x.word[0] < y.word[0];
+}
+
+inline bool operator==( const key64& x, const key64& y ) {
+  return x.word[0] == y.word[0];
+}
+
+/*
+ * The i-th key of K, in the order of i. Strings are 16 digits long,
+ * past the small string buffer, so every one of them is allocated.
+ */
+template < typename K >
+struct tree_key;
+
+template <>
+struct tree_key<int> {
+  static const char* name() { return "int"; }
+  static int make( unsigned long i ) { return int(i); }
+};
+
+template <>
+struct tree_key<std::string> {
+  static const char* name() { return "string"; }
+  static std::string make( unsigned long i ) {
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "%016lu", i);
+    return buffer;
+  }
+};
+
+template <>
+struct tree_key<key64> {
+  static const char* name() { return "key64"; }
+  static key64 make( unsigned long i ) {
+    key64 k;
+    for (int w = 0; w < 8; w++) {
+      k.word[w] = i + w;
+    }
+    return k;
+  }
+};
+
+/*
+ * How a key becomes something to insert : the key itself for sets
+ * (whose value_type, const Key, cannot go in a vector).
+ */
+template < typename Tree >
+struct tree_entry {
+  typedef typename Tree::key_type type;
+  static type make( const typename Tree::key_type& k ) { return k; }
+};
+
+/* The keys 2 * order[i] + odd. */
+template < typename K >
+std::vector<K> tree_keys( const std::vector<unsigned long>& order,
+                          unsigned long odd )
+{
+  std::vector<K> keys;
+  keys.reserve(order.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    keys.push_back(tree_key<K>::make(2 * order[i] + odd));
+  }
+  return keys;
+}
+
+template < typename Tree >
+void fill_tree( Tree& tree, long n ) {
+  typedef typename Tree::key_type K;
+  for (long i = 0; i < n; i++) {
+    tree.insert(tree_entry<Tree>::make(tree_key<K>::make(2 * i)));
+  }
+}
+
+/* Order is SEQUENTIAL, REVERSE, or UNIFORM for a random permutation. */
+template < typename Tree, distribution Order >
+void tree_insert( state& s ) {
+  typedef typename Tree::key_type K;
+  std::vector<unsigned long> order = Order == UNIFORM ? shuffled(s.arg())
+                                                      : draw(Order, s.arg(),
+                                                             s.arg());
+  std::vector<typename tree_entry<Tree>::type> values;
+  values.reserve(s.arg());
+  for (long i = 0; i < s.arg(); i++) {
+    values.push_back(tree_entry<Tree>::make(tree_key<K>::make(2 * order[i])));
+  }
+  Tree tree;
+  s.start();
+  for (long i = 0; i < s.arg(); i++) {
+    tree.insert(values[i]);
+  }
+  s.stop(s.arg());
+  do_not_optimize(tree.size());
+}
+
+/* Odd is 0 for hits, 1 for misses. */
+template < typename Tree, unsigned long Odd >
+void tree_find( state& s ) {
+  typedef typename Tree::key_type K;
+  Tree tree;
+  fill_tree(tree, s.arg());
+  std::vector<K> keys = tree_keys<K>(shuffled(s.arg()), Odd);
+  long found = 0;
+  s.start();
+  for (long i = 0; i < s.arg(); i++) {
+    found += tree.find(keys[i]) != tree.end();
+  }
+  s.stop(s.arg());
+  do_not_optimize(found);
+}
+
+template < typename Tree >
+void tree_lower_bound( state& s ) {
+  typedef typename Tree::key_type K;
+  Tree tree;
+  fill_tree(tree, s.arg());
+  std::vector<K> keys = tree_keys<K>(shuffled(s.arg()), 1);
+  long found = 0;
+  s.start();
+  for (long i = 0; i < s.arg(); i++) {
+    found += tree.lower_bound(keys[i]) != tree.end();
+  }
+  s.stop(s.arg());
+  do_not_optimize(found);
+}
+
+template < typename Tree >
+void tree_iterate( state& s ) {
+  Tree tree;
+  fill_tree(tree, s.arg());
+  long count = 0;
+  s.start();
+  for (typename Tree::const_iterator it = tree.begin(); it != tree.end();
+       ++it) {
+    count++;
+  }
+  s.stop(s.arg());
+  do_not_optimize(count);
+}
+
+template < typename Tree >
+void tree_reverse_iterate( state& s ) {
+  Tree tree;
+  fill_tree(tree, s.arg());
+  long count = 0;
+  s.start();
+  for (typename Tree::const_reverse_iterator it = tree.rbegin();
+       it != tree.rend(); ++it) {
+    count++;
+  }
+  s.stop(s.arg());
+  do_not_optimize(count);
+}
+
+template < typename Tree >
+void tree_copy( state& s ) {
+  Tree tree;
+  fill_tree(tree, s.arg());
+  s.start();
+  Tree copy(tree);
+  s.stop(s.arg());
+  do_not_optimize(copy.size());
+}
+
+template < typename Tree >
+void tree_clear( state& s ) {
+  Tree tree;
+  fill_tree(tree, s.arg());
+  s.start();
+  tree.clear();
+  s.stop(s.arg());
+  do_not_optimize(tree.size());
+}
+
+template < typename Tree >
+void tree_erase_key( state& s ) {
+  typedef typename Tree::key_type K;
+  Tree tree;
+  fill_tree(tree, s.arg());
+  std::vector<K> keys = tree_keys<K>(shuffled(s.arg()), 0);
+  s.start();
+  for (long i = 0; i < s.arg(); i++) {
+    tree.erase(keys[i]);
+  }
+  s.stop(s.arg());
+  do_not_optimize(tree.size());
+}
+
+/* From the first element on, the way a filter over the tree would. */
+template < typename Tree >
+void tree_erase_iterator( state& s ) {
+  Tree tree;
+  fill_tree(tree, s.arg());
+  s.start();
+  for (typename Tree::iterator it = tree.begin(); it != tree.end(); ) {
+    tree.erase(it++);
+  }
+  s.stop(s.arg());
+  do_not_optimize(tree.size());
+}
+
+/* s.arg() keys drawn from D, into an empty tree (repeats find theirs). */
+template < typename Tree, distribution D >
+void tree_insert_drawn( state& s ) {
+  typedef typename Tree::key_type K;
+  std::vector<unsigned long> drawn = draw(D, s.arg(), s.arg());
+  std::vector<typename tree_entry<Tree>::type> values;
+  values.reserve(s.arg());
+  for (long i = 0; i < s.arg(); i++) {
+    values.push_back(tree_entry<Tree>::make(tree_key<K>::make(2 * drawn[i])));
+  }
+  Tree tree;
+  s.start();
+  for (long i = 0; i < s.arg(); i++) {
+    tree.insert(values[i]);
+  }
+  s.stop(s.arg());
+  do_not_optimize(tree.size());
+}
+
+/* s.arg() lookups drawn from D, in a full tree : all hits. */
+template < typename Tree, distribution D >
+void tree_find_drawn( state& s ) {
+  typedef typename Tree::key_type K;
+  Tree tree;
+  fill_tree(tree, s.arg());
+  std::vector<unsigned long> drawn = draw(D, s.arg(), s.arg());
+  std::vector<K> keys = tree_keys<K>(drawn, 0);
+  long found = 0;
+  s.start();
+  for (long i = 0; i < s.arg(); i++) {
+    found += tree.find(keys[i]) != tree.end();
+  }
+  s.stop(s.arg());
+  do_not_optimize(found);
+}
+
+template < typename FtTree, typename StdTree, distribution D >
+void distribution_rows( const std::string& name, long n ) {
+  const std::string keys = name + distribution_name(D);
+  row(keys + " insert", tree_insert_drawn<FtTree, D>,
+      tree_insert_drawn<StdTree, D>, n);
+  row(keys + " find", tree_find_drawn<FtTree, D>,
+      tree_find_drawn<StdTree, D>, n);
+}
+
+template < typename FtTree, typename StdTree >
+void tree_distributions( const std::string& type ) {
+
+  const std::string name =
+      type + "<" + tree_key<typename FtTree::key_type>::name() + "> ";
+  const long n = max_size();
+
+  header();
+  caption(with_arg(name + "x", n) + ", keys by distribution");
+  distribution_rows<FtTree, StdTree, SEQUENTIAL>(name, n);
+  distribution_rows<FtTree, StdTree, REVERSE>(name, n);
+  distribution_rows<FtTree, StdTree, UNIFORM>(name, n);
+  distribution_rows<FtTree, StdTree, ZIPF>(name, n);
+  distribution_rows<FtTree, StdTree, HOTSPOT>(name, n);
+  distribution_rows<FtTree, StdTree, SLIDING_WINDOW>(name, n);
+}
+
+/*
+ * Every row for FtTree against StdTree, at every size. type is the
+ * container name for the rows, "map" or "set".
+ */
+template < typename FtTree, typename StdTree >
+void tree_matrix( const std::string& type ) {
+
+  static const long sizes[] = { 1000, 10000, 100000, 1000000, 10000000 };
+  const std::string name =
+      type + "<" + tree_key<typename FtTree::key_type>::name() + "> ";
+
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    const long n = sizes[i];
+    if (n > max_size()) {
+      break ;
+    }
+    header();
+    caption(with_arg(name + "x", n));
+    row(name + "insert random", tree_insert<FtTree, UNIFORM>,
+        tree_insert<StdTree, UNIFORM>, n);
+    row(name + "insert sorted", tree_insert<FtTree, SEQUENTIAL>,
+        tree_insert<StdTree, SEQUENTIAL>, n);
+    row(name + "insert reverse", tree_insert<FtTree, REVERSE>,
+        tree_insert<StdTree, REVERSE>, n);
+    row(name + "find hit", tree_find<FtTree, 0>, tree_find<StdTree, 0>, n);
+    row(name + "find miss", tree_find<FtTree, 1>, tree_find<StdTree, 1>, n);
+    row(name + "lower_bound", tree_lower_bound<FtTree>,
+        tree_lower_bound<StdTree>, n);
+    row(name + "iterate", tree_iterate<FtTree>, tree_iterate<StdTree>, n);
+    row(name + "reverse iterate", tree_reverse_iterate<FtTree>,
+        tree_reverse_iterate<StdTree>, n);
+    row(name + "copy", tree_copy<FtTree>, tree_copy<StdTree>, n);
+    row(name + "clear", tree_clear<FtTree>, tree_clear<StdTree>, n);
+    row(name + "erase key", tree_erase_key<FtTree>,
+        tree_erase_key<StdTree>, n);
+    row(name + "erase iterator", tree_erase_iterator<FtTree>,
+        tree_erase_iterator<StdTree>, n);
+  }
+}
+
+} /* namespace bench */
+
+#endif /* CONTAINERS_TREE_MATRIX_HPP */
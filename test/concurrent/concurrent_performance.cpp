@@ -0,0 +1,187 @@
+#include "ft/concurrent_stack.hpp"
+#include "ft/mpmc_queue.hpp"
+#include "ft/stack.hpp"
+#include "ft/queue.hpp"
+#include "ft/utils/atomic.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <cstdlib>
+#include <string>
+#include "../bench/bench.hpp"
+#include "../test.hpp"
+#include "../colors.hpp"
+#include <iostream>
+
+#define CHANNEL_CAPACITY 1024
+#define CHANNEL_ITEMS 400000
+#define MAX_THREADS 8
+
+/*
+ * The single threaded containers behind one mutex, what the lock-free
+ * ones replace. Same push / pop(out) interface, same capacity bound.
+ */
+template < typename Container >
+class locked {
+
+  pthread_mutex_t _mutex;
+  Container       _c;
+  size_t          _capacity;
+
+  public:
+
+  explicit locked( size_t capacity ) : _capacity(capacity) {
+    pthread_mutex_init(&_mutex, NULL);
+  }
+
+  ~locked() {
+    pthread_mutex_destroy(&_mutex);
+  }
+
+  bool push( int value ) {
+    pthread_mutex_lock(&_mutex);
+    bool room = _c.size() < _capacity;
+    if (room) {
+      _c.push(value);
+    }
+    pthread_mutex_unlock(&_mutex);
+    return room;
+  }
+
+  bool pop( int& out ) {
+    pthread_mutex_lock(&_mutex);
+    bool some = !_c.empty();
+    if (some) {
+      out = next(_c);
+      _c.pop();
+    }
+    pthread_mutex_unlock(&_mutex);
+    return some;
+  }
+
+  private:
+
+  static int next( const ft::stack<int>& s ) { return s.top(); }
+  static int next( const ft::queue<int>& q ) { return q.front(); }
+};
+
+template < typename Channel >
+struct shared {
+  Channel          channel;
+  int              items_per_producer;
+  ft::atomic<long> remaining;
+  ft::atomic<int>  ready;   // threads wait for each other to start
+  int              threads;
+
+  explicit shared( long items )
+  : channel(CHANNEL_CAPACITY), remaining(items), ready(0) {}
+};
+
+template < typename Channel >
+static void start_together( shared<Channel>* s ) {
+  s->ready.fetch_add(1);
+  while (s->ready.load() < s->threads) {
+    sched_yield();
+  }
+}
+
+template < typename Channel >
+static void* producer( void* arg ) {
+  shared<Channel>* s = static_cast<shared<Channel>*>(arg);
+  start_together(s);
+  for (int i = 0; i < s->items_per_producer; ) {
+    if (s->channel.push(i)) {
+      ++i;
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+template < typename Channel >
+static void* consumer( void* arg ) {
+  shared<Channel>* s = static_cast<shared<Channel>*>(arg);
+  start_together(s);
+  int value;
+  long sum = 0;
+  while (s->remaining.load(ft::memory_order_relaxed) > 0) {
+    if (s->channel.pop(value)) {
+      sum += value;
+      s->remaining.fetch_sub(1, ft::memory_order_relaxed);
+    } else {
+      sched_yield();
+    }
+  }
+  bench::do_not_optimize(sum);
+  return NULL;
+}
+
+/*
+ * Moves state.arg() items through the channel with Producers producer
+ * and Consumers consumer threads, a push and a pop per item. The clock
+ * covers the threads' creation and join, as a caller would see it.
+ */
+template < typename Channel, int Producers, int Consumers >
+static void channel( bench::state& state ) {
+
+  int items = int(state.arg() / Producers);
+  shared<Channel> s(long(items) * Producers);
+  s.items_per_producer = items;
+  s.threads = Producers + Consumers;
+
+  pthread_t threads[MAX_THREADS];
+  state.start();
+  for (int i = 0; i < s.threads; i++) {
+    if (pthread_create(&threads[i], NULL, i < Consumers ? consumer<Channel>
+                                                        : producer<Channel>,
+                       &s))
+    {
+      std::cerr << "pthread_create failed" << std::endl;
+      std::abort();
+    }
+  }
+  for (int i = 0; i < s.threads; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  state.stop(2L * items * Producers);
+}
+
+/* One row per producers / consumers mix, for a lock-free Channel. */
+template < typename Channel, typename Locked >
+static void channel_rows( const char* name ) {
+
+  std::string prefix(name);
+  bench::row(prefix + " 1 prod / 1 cons", channel< Channel, 1, 1 >,
+             channel< Locked, 1, 1 >, CHANNEL_ITEMS);
+  bench::row(prefix + " 2 prod / 2 cons", channel< Channel, 2, 2 >,
+             channel< Locked, 2, 2 >, CHANNEL_ITEMS);
+  bench::row(prefix + " 4 prod / 4 cons", channel< Channel, 4, 4 >,
+             channel< Locked, 4, 4 >, CHANNEL_ITEMS);
+  bench::row(prefix + " 1 prod / 4 cons", channel< Channel, 1, 4 >,
+             channel< Locked, 1, 4 >, CHANNEL_ITEMS);
+  bench::row(prefix + " 4 prod / 1 cons", channel< Channel, 4, 1 >,
+             channel< Locked, 4, 1 >, CHANNEL_ITEMS);
+}
+
+void concurrent_performance() {
+
+  std::cout << BLUE_BOLD
+            << "////////// [ CONCURRENT PERFORMANCE ] ////////// "
+            << UNSET << std::endl;
+
+  const std::string caption =
+      bench::with_arg("items", CHANNEL_ITEMS)
+      + bench::with_arg(", capacity", CHANNEL_CAPACITY);
+  bench::header("ft::concurrent_stack", "locked ft::stack");
+  bench::caption(caption);
+  channel_rows< ft::concurrent_stack<int>, locked< ft::stack<int> > >(
+      "concurrent_stack");
+  bench::header("ft::mpmc_queue", "locked ft::queue");
+  bench::caption(caption);
+  channel_rows< ft::mpmc_queue<int>, locked< ft::queue<int> > >(
+      "mpmc_queue");
+
+  std::cout << BLUE_BOLD
+            << "/////////////////////////////////////////////////"
+            << UNSET << std::endl;
+}
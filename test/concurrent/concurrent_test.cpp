@@ -0,0 +1,218 @@
+#include "ft/concurrent_stack.hpp"
+#include "ft/mpmc_queue.hpp"
+#include "ft/vector.hpp"
+#include "ft/utils/atomic.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <deque>
+#include <string>
+#include <cstdlib>
+#include "../test_utils.hpp"
+
+static void concurrent_stack_lifo_test();
+static void mpmc_queue_fifo_test();
+static void concurrent_stack_threads_test();
+static void mpmc_queue_threads_test();
+
+void concurrent_test() {
+  concurrent_stack_lifo_test();
+  mpmc_queue_fifo_test();
+  concurrent_stack_threads_test();
+  mpmc_queue_threads_test();
+}
+
+/* Single threaded : order, capacity, leftovers destroyed. */
+static void concurrent_stack_lifo_test() {
+
+  ft::concurrent_stack<std::string> stack(3);
+  std::string out;
+
+  if (!stack.empty() || stack.pop(out) || stack.capacity() != 3) {
+    return CONCURRENT_STACK_TEST_ERROR(KO_CONSTRUCTOR);
+  }
+  if (!stack.push("a") || !stack.push("b") || !stack.push("c")
+      || stack.push("d"))
+  {
+    return CONCURRENT_STACK_TEST_ERROR(KO_INSERT);
+  }
+  if (!stack.pop(out) || out != "c" || !stack.push("d")) {
+    return CONCURRENT_STACK_TEST_ERROR(KO_ERASE);
+  }
+  const char* expected[] = { "d", "b", "a" };
+  for (int i = 0; i < 3; i++) {
+    if (!stack.pop(out) || out != expected[i]) {
+      return CONCURRENT_STACK_TEST_ERROR(KO_ERASE);
+    }
+  }
+  if (!stack.empty() || stack.pop(out)) {
+    return CONCURRENT_STACK_TEST_ERROR(KO_ERASE);
+  }
+  stack.push(std::string(100, 'x'));  // freed by the destructor
+#ifdef FT_CONTAINERS_CXX11
+  std::string moved(100, 'y');
+  stack.push(std::move(moved));
+  if (!moved.empty() || !stack.pop(out) || out != std::string(100, 'y')) {
+    return CONCURRENT_STACK_TEST_ERROR(KO_MOVE);
+  }
+#endif
+  ft::concurrent_stack<int> none(0);
+  int value = 0;
+  if (none.push(1) || none.pop(value)) {
+    return CONCURRENT_STACK_TEST_ERROR(KO_CONSTRUCTOR);
+  }
+  return CONCURRENT_STACK_TEST_OK(INSERT_TAG);
+}
+
+/* Single threaded : random push / pop against std::deque. */
+static void mpmc_queue_fifo_test() {
+
+  ft::mpmc_queue<std::string> q(50);
+  std::deque<std::string> ref;
+  std::string out;
+
+  if (q.capacity() != 64 || ft::mpmc_queue<int>(0).capacity() != 2
+      || q.pop(out) || q.size_approx() != 0)
+  {
+    return MPMC_QUEUE_TEST_ERROR(KO_CONSTRUCTOR);
+  }
+  srand(23);
+  for (int i = 0; i < 100000; i++) {
+    if (rand() % 2) {
+      std::string value(i % 17, 'a' + i % 26);
+      bool pushed = q.push(value);
+      if (pushed != (ref.size() < 64)) {
+        return MPMC_QUEUE_TEST_ERROR(KO_INSERT);
+      }
+      if (pushed) {
+        ref.push_back(value);
+      }
+    } else {
+      bool popped = q.pop(out);
+      if (popped != !ref.empty() || (popped && out != ref.front())) {
+        return MPMC_QUEUE_TEST_ERROR(KO_ERASE);
+      }
+      if (popped) {
+        ref.pop_front();
+      }
+    }
+    if (q.size_approx() != ref.size()) {
+      return MPMC_QUEUE_TEST_ERROR(KO_INSERT);
+    }
+  }
+  return MPMC_QUEUE_TEST_OK(INSERT_TAG);
+}
+
+#define THREAD_COUNT 4
+#define THREAD_ITEMS 50000
+
+/*
+ * Producer i pushes [i * THREAD_ITEMS, (i + 1) * THREAD_ITEMS), the
+ * consumers pop until all of it is gone. Full / empty just yield.
+ */
+template < typename Channel >
+struct worker {
+  Channel*          channel;
+  int               first;
+  ft::atomic<long>* remaining;
+  ft::vector<int>   popped;
+};
+
+template < typename Channel >
+static void* produce( void* arg ) {
+  worker<Channel>* w = static_cast<worker<Channel>*>(arg);
+  for (int i = w->first; i < w->first + THREAD_ITEMS; ) {
+    if (w->channel->push(i)) {
+      ++i;
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+template < typename Channel >
+static void* consume( void* arg ) {
+  worker<Channel>* w = static_cast<worker<Channel>*>(arg);
+  int value;
+  while (w->remaining->load(ft::memory_order_relaxed) > 0) {
+    if (w->channel->pop(value)) {
+      w->popped.push_back(value);
+      w->remaining->fetch_sub(1, ft::memory_order_relaxed);
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+/*
+ * THREAD_COUNT producers against THREAD_COUNT consumers : every value
+ * must come out exactly once. With fifo, each consumer must also see
+ * the values of any one producer in increasing order.
+ */
+template < typename Channel >
+static bool run_threads( Channel& channel, bool fifo ) {
+
+  const int total = THREAD_COUNT * THREAD_ITEMS;
+  ft::atomic<long> remaining(total);
+  worker<Channel> producers[THREAD_COUNT];
+  worker<Channel> consumers[THREAD_COUNT];
+  pthread_t threads[2 * THREAD_COUNT];
+
+  for (int i = 0; i < THREAD_COUNT; i++) {
+    producers[i].channel = &channel;
+    producers[i].first = i * THREAD_ITEMS;
+    consumers[i].channel = &channel;
+    consumers[i].remaining = &remaining;
+    if (pthread_create(&threads[i], NULL, consume<Channel>, &consumers[i])
+        || pthread_create(&threads[THREAD_COUNT + i], NULL,
+                          produce<Channel>, &producers[i]))
+    {
+      return false;
+    }
+  }
+  for (int i = 0; i < 2 * THREAD_COUNT; i++) {
+    pthread_join(threads[i], NULL);
+  }
+
+  ft::vector<int> seen(total, 0);
+  for (int c = 0; c < THREAD_COUNT; c++) {
+    ft::vector<int> last(THREAD_COUNT, -1);
+    const ft::vector<int>& popped = consumers[c].popped;
+    for (size_t i = 0; i < popped.size(); i++) {
+      int value = popped[i];
+      if (value < 0 || value >= total || seen[value]++) {
+        return false;
+      }
+      if (fifo && value <= last[value / THREAD_ITEMS]) {
+        return false;
+      }
+      last[value / THREAD_ITEMS] = value;
+    }
+  }
+  for (int i = 0; i < total; i++) {
+    if (seen[i] != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void concurrent_stack_threads_test() {
+
+  // small pool : producers keep running into "full", consumers "empty"
+  ft::concurrent_stack<int> stack(64);
+  if (!run_threads(stack, false) || !stack.empty()) {
+    return CONCURRENT_STACK_TEST_ERROR(KO_THREADS);
+  }
+  return CONCURRENT_STACK_TEST_OK(THREADS_TAG);
+}
+
+static void mpmc_queue_threads_test() {
+
+  ft::mpmc_queue<int> q(64);
+  if (!run_threads(q, true) || q.size_approx() != 0) {
+    return MPMC_QUEUE_TEST_ERROR(KO_THREADS);
+  }
+  return MPMC_QUEUE_TEST_OK(THREADS_TAG);
+}
@@ -0,0 +1,304 @@
+#include "ft/deque.hpp"
+#include "ft/stack.hpp"
+#include "ft/utils/utils.hpp"
+#include <deque>
+#include <stack>
+#include <string>
+#include <cstdlib>
+#include "../test_utils.hpp"
+
+static void push_pop_test();
+static void stable_references_test();
+static void iterators_test();
+static void insert_erase_test();
+static void assignment_operator_test();
+static void stack_adaptor_test();
+static void shrink_test();
+
+void deque_test() {
+  push_pop_test();
+  stable_references_test();
+  iterators_test();
+  insert_erase_test();
+  assignment_operator_test();
+  stack_adaptor_test();
+  shrink_test();
+}
+
+template <typename T>
+inline bool Deque_Equality_Check(const std::deque<T>& u,
+                                 const ft::deque<T>& v)
+{
+  if (u.size() != v.size()) {
+    return ft::show_diff(u.size(), v.size());
+  }
+  if (!ft::equal(u.begin(), u.end(), v.begin())) {
+    return ft::equal_diff(u.begin(), u.end(), v.begin());
+  }
+  for (size_t i = 0; i < u.size(); i++) {
+    if (u[i] != v[i]) {
+      return ft::show_diff(u[i], v[i]);
+    }
+  }
+  return true;
+}
+
+/*
+ * Random mix of push / pop at both ends, crossing block boundaries
+ * and emptying the deque now and then.
+ */
+static void push_pop_test() {
+
+  ft::deque<int> ft_d;
+  std::deque<int> std_d;
+
+  srand(42);
+  for (int i = 0; i < 200000; i++) {
+    int op = rand() % 10;
+    if (op < 3) {
+      ft_d.push_back(i);
+      std_d.push_back(i);
+    } else if (op < 6) {
+      ft_d.push_front(i);
+      std_d.push_front(i);
+    } else if (op < 8 && !std_d.empty()) {
+      ft_d.pop_back();
+      std_d.pop_back();
+    } else if (!std_d.empty()) {
+      ft_d.pop_front();
+      std_d.pop_front();
+    }
+    if (!std_d.empty()
+        && (ft_d.front() != std_d.front() || ft_d.back() != std_d.back()))
+    {
+      return DEQUE_TEST_ERROR(KO_INSERT);
+    }
+  }
+  if (!Deque_Equality_Check(std_d, ft_d)) {
+    return DEQUE_TEST_ERROR(KO_INSERT);
+  }
+  while (!std_d.empty()) {
+    ft_d.pop_front();
+    std_d.pop_front();
+  }
+  if (!ft_d.empty() || ft_d.begin() != ft_d.end()) {
+    return DEQUE_TEST_ERROR(KO_ERASE);
+  }
+  ft_d.push_back(1);
+  ft_d.push_front(0);
+  if (ft_d.size() != 2 || ft_d[0] != 0 || ft_d.at(1) != 1) {
+    return DEQUE_TEST_ERROR(KO_INSERT);
+  }
+  try {
+    ft_d.at(2);
+    return DEQUE_TEST_ERROR(KO_INSERT);
+  } catch (std::out_of_range&) {}
+
+  return DEQUE_TEST_OK(INSERT_TAG);
+}
+
+/* Growth never moves elements : pointers taken early stay valid. */
+static void stable_references_test() {
+
+  ft::deque<std::string> d;
+  d.push_back("first");
+  std::string* first = &d.front();
+  for (int i = 0; i < 50000; i++) {
+    d.push_back("back");
+    d.push_front("front");
+  }
+  std::string* middle = &d[d.size() / 2];
+  for (int i = 0; i < 50000; i++) {
+    d.push_front("front");
+  }
+  if (first != middle || *first != "first" || d.size() != 150001) {
+    return DEQUE_TEST_ERROR(KO_RESERVE);
+  }
+  return DEQUE_TEST_OK(RESERVE_TAG);
+}
+
+static void iterators_test() {
+
+  ft::deque<int> ft_d;
+  std::deque<int> std_d;
+  for (int i = 0; i < 5000; i++) {
+    ft_d.push_front(i);
+    std_d.push_front(i);
+  }
+
+  ft::deque<int>::iterator it = ft_d.begin();
+  ft::deque<int>::const_iterator cit = it;
+  if (cit != ft_d.begin() || ft_d.end() - ft_d.begin() != 5000
+      || ft::distance(ft_d.begin(), ft_d.end()) != 5000
+      || *(it + 1234) != std_d[1234] || it[4999] != std_d[4999]
+      || *(ft_d.end() - 1) != std_d.back() || !(it < ft_d.end()))
+  {
+    return DEQUE_TEST_ERROR(KO_ITERATORS);
+  }
+  it += 3000;
+  it -= 1000;
+  if (*it != std_d[2000] || *(1 + it) != std_d[2001]) {
+    return DEQUE_TEST_ERROR(KO_ITERATORS);
+  }
+  *it = -1;
+  std_d[2000] = -1;
+
+  std::deque<int>::reverse_iterator std_rit = std_d.rbegin();
+  for (ft::deque<int>::const_reverse_iterator rit = ft_d.rbegin();
+       rit != ft_d.rend(); ++rit, ++std_rit)
+  {
+    if (*rit != *std_rit) {
+      return DEQUE_TEST_ERROR(KO_ITERATORS);
+    }
+  }
+
+  ft::deque<int> from_range(std_d.begin(), std_d.end());
+  ft::deque<int> filled(10, 7);
+  if (!Deque_Equality_Check(std_d, from_range) || filled.size() != 10
+      || filled.back() != 7)
+  {
+    return DEQUE_TEST_ERROR(KO_CONSTRUCTOR);
+  }
+  return DEQUE_TEST_OK(ITERATOR_TAG);
+}
+
+static void insert_erase_test() {
+
+  ft::deque<int> ft_d;
+  std::deque<int> std_d;
+  for (int i = 0; i < 3000; i++) {
+    ft_d.push_back(i);
+    std_d.push_back(i);
+  }
+
+  srand(7);
+  for (int i = 0; i < 500; i++) {
+    size_t pos = rand() % (std_d.size() + 1);
+    switch (rand() % 4) {
+      case 0:
+        ft_d.insert(ft_d.begin() + pos, -i);
+        std_d.insert(std_d.begin() + pos, -i);
+        break;
+      case 1:
+        ft_d.insert(ft_d.begin() + pos, 3, i);
+        std_d.insert(std_d.begin() + pos, 3, i);
+        break;
+      case 2:
+        if (pos < std_d.size()) {
+          ft_d.erase(ft_d.begin() + pos);
+          std_d.erase(std_d.begin() + pos);
+        }
+        break;
+      default: {
+        size_t last = pos + rand() % 20;
+        if (last > std_d.size()) {
+          last = std_d.size();
+        }
+        ft_d.erase(ft_d.begin() + pos, ft_d.begin() + last);
+        std_d.erase(std_d.begin() + pos, std_d.begin() + last);
+      }
+    }
+  }
+  if (!Deque_Equality_Check(std_d, ft_d)) {
+    return DEQUE_TEST_ERROR(KO_ERASE);
+  }
+
+  int matrix[5] = { 1, 2, 3, 4, 5 };
+  ft_d.insert(ft_d.begin() + 10, matrix, matrix + 5);
+  std_d.insert(std_d.begin() + 10, matrix, matrix + 5);
+  ft_d.resize(100);
+  std_d.resize(100);
+  ft_d.resize(200, 9);
+  std_d.resize(200, 9);
+  if (!Deque_Equality_Check(std_d, ft_d)) {
+    return DEQUE_TEST_ERROR(KO_INSERT);
+  }
+  return DEQUE_TEST_OK(ERASE_TAG);
+}
+
+static void assignment_operator_test() {
+
+  ft::deque<std::string> a(100, "a");
+  ft::deque<std::string> b;
+  for (int i = 0; i < 3000; i++) {
+    b.push_front("b");
+  }
+  ft::deque<std::string> c(a);
+  c = b;
+  if (c != b || c.size() != 3000 || !(a < b) || a == b) {
+    return DEQUE_TEST_ERROR(KO_ASSIGNMENT);
+  }
+  c = a;
+  if (c != a || c.size() != 100) {
+    return DEQUE_TEST_ERROR(KO_ASSIGNMENT);
+  }
+  c.swap(b);
+  if (c.size() != 3000 || b != a) {
+    return DEQUE_TEST_ERROR(KO_ASSIGNMENT);
+  }
+  c.assign(5, "x");
+  if (c.size() != 5 || c.front() != "x") {
+    return DEQUE_TEST_ERROR(KO_ASSIGN);
+  }
+#ifdef FT_CONTAINERS_CXX11
+  c.emplace_front(3, 'y');
+  c.emplace_back("z");
+  ft::deque<std::string> moved(std::move(c));
+  if (!c.empty() || moved.size() != 7 || moved.front() != "yyy"
+      || moved.back() != "z")
+  {
+    return DEQUE_TEST_ERROR(KO_MOVE);
+  }
+#endif
+  return DEQUE_TEST_OK(ASSIGNMENT_TAG);
+}
+
+static void stack_adaptor_test() {
+
+  ft::stack<int, ft::deque<int> > ft_s;
+  std::stack<int> std_s;
+
+  for (int i = 0; i < 100000; i++) {
+    ft_s.push(i);
+    std_s.push(i);
+    if (i % 3 == 0) {
+      ft_s.pop();
+      std_s.pop();
+    }
+  }
+  while (!std_s.empty()) {
+    if (ft_s.top() != std_s.top() || ft_s.size() != std_s.size()) {
+      return DEQUE_TEST_ERROR(KO_FROG);
+    }
+    ft_s.pop();
+    std_s.pop();
+  }
+  if (!ft_s.empty()) {
+    return DEQUE_TEST_ERROR(KO_FROG);
+  }
+  return DEQUE_TEST_OK(STACK_TAG);
+}
+
+static void shrink_test() {
+
+  ft::deque<int> d;
+  for (int i = 0; i < 100000; i++) {
+    d.push_back(i);
+  }
+  for (int i = 0; i < 99000; i++) {
+    d.pop_front();
+  }
+  d.shrink_to_fit();
+  if (d.size() != 1000 || d.front() != 99000 || d.back() != 99999) {
+    return DEQUE_TEST_ERROR(KO_SHRINK);
+  }
+  d.push_front(-1);
+  d.push_back(-2);
+  d.clear();
+  d.shrink_to_fit();
+  d.push_front(1);
+  if (d.size() != 1 || d.front() != 1) {
+    return DEQUE_TEST_ERROR(KO_SHRINK);
+  }
+  return DEQUE_TEST_OK(SHRINK_TAG);
+}
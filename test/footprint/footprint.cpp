@@ -0,0 +1,224 @@
+#include "ft/map.hpp"
+#include "ft/set.hpp"
+#include "ft/vector.hpp"
+#include "ft/counting_allocator.hpp"
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../colors.hpp"
+
+/*
+ * Memory footprint : bytes per element of ft::map, ft::set and
+ * ft::vector against their std equivalents, at several sizes.
+ *
+ *    heap    what the containers asked their allocator for, counted by
+ *            ft::counting_allocator : nodes, the map / set sentinel,
+ *            vector capacity past size()
+ *    rss     resident set growth while the container was filled, so
+ *            malloc's own overhead (chunk headers, rounding) too.
+ *            Linux only (/proc/self/statm), and page granular : only
+ *            meaningful at the larger sizes.
+ *
+ * Every measurement runs in a forked child, on a heap nothing else
+ * touched before. The "empty" row is a default constructed container
+ * (heap in bytes, not per element) and the sizeof line the object
+ * itself.
+ *
+ *    containers_footprint [max_ratio]
+ *
+ * exits 1 when ft's heap bytes per element go over max_ratio (default
+ * 1.05) times std's at any size : run by make footprint, it catches a
+ * node layout that grew.
+ */
+
+#define FOOTPRINT_DEFAULT_MAX_RATIO 1.05
+
+struct footprint {
+  size_t heap_bytes;
+  size_t allocations;
+  long   rss_bytes;   // -1 when unknown
+};
+
+static long resident_bytes() {
+  FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (!statm) {
+    return -1;
+  }
+  long size;
+  long resident;
+  int read = std::fscanf(statm, "%ld %ld", &size, &resident);
+  std::fclose(statm);
+  if (read != 2) {
+    return -1;
+  }
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+template < typename Map >
+static void fill_map( Map& m, long n ) {
+  for (long i = 0; i < n; i++) {
+    m.insert(typename Map::value_type(int(i), int(i)));
+  }
+}
+
+template < typename Set >
+static void fill_set( Set& s, long n ) {
+  for (long i = 0; i < n; i++) {
+    s.insert(int(i));
+  }
+}
+
+template < typename Vector >
+static void fill_vector( Vector& v, long n ) {
+  for (long i = 0; i < n; i++) {
+    v.push_back(int(i));
+  }
+}
+
+/*
+ * Container is built and filled with n elements in a child process,
+ * which sends back what it measured.
+ */
+template < typename Container >
+static footprint measure( void (*fill)( Container&, long ), long n ) {
+
+  footprint result = { 0, 0, -1 };
+  int fds[2];
+  if (pipe(fds) != 0) {
+    std::perror("pipe");
+    std::exit(2);
+  }
+  pid_t pid = fork();
+  if (pid < 0) {
+    std::perror("fork");
+    std::exit(2);
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    const ft::allocation_stats& heap = ft::default_allocation_stats();
+    long rss = resident_bytes();
+    Container* c = new Container();
+    fill(*c, n);
+    footprint f;
+    f.heap_bytes = heap.live_bytes;
+    f.allocations = heap.live_allocations();
+    long after = resident_bytes();
+    f.rss_bytes = (rss < 0 || after < 0) ? -1 : after - rss;
+    ssize_t written = write(fds[1], &f, sizeof(f));
+    _exit(written == ssize_t(sizeof(f)) ? 0 : 1);
+  }
+  close(fds[1]);
+  ssize_t got = read(fds[0], &result, sizeof(result));
+  close(fds[0]);
+  int status;
+  waitpid(pid, &status, 0);
+  if (got != ssize_t(sizeof(result)) || !WIFEXITED(status)
+      || WEXITSTATUS(status) != 0)
+  {
+    std::cerr << "footprint: measuring child failed" << std::endl;
+    std::exit(2);
+  }
+  return result;
+}
+
+static void print_per_element( double value ) {
+  if (value < 0) {
+    std::cout << std::setw(10) << "-";
+  } else {
+    std::cout << std::setw(10) << value;
+  }
+}
+
+/*
+ * One table for FtContainer against StdContainer. Returns false if
+ * ft's heap per element went over max_ratio times std's.
+ */
+template < typename FtContainer, typename StdContainer >
+static bool compare( const char* name, void (*ft_fill)( FtContainer&, long ),
+                     void (*std_fill)( StdContainer&, long ),
+                     double max_ratio )
+{
+  static const long sizes[] = { 10000, 100000, 1000000 };
+  bool ok = true;
+
+  std::cout << BLUE_BOLD << name << UNSET << "  sizeof ft "
+            << sizeof(FtContainer) << " std " << sizeof(StdContainer)
+            << std::endl;
+  std::cout << std::setw(10) << "n" << std::setw(10) << "ft heap"
+            << std::setw(10) << "std heap" << std::setw(10) << "ft rss"
+            << std::setw(10) << "std rss" << std::setw(12) << "ft allocs"
+            << std::setw(12) << "std allocs" << std::endl;
+
+  footprint ft_empty = measure(ft_fill, 0);
+  footprint std_empty = measure(std_fill, 0);
+  std::cout << std::setw(10) << "empty" << std::setw(10)
+            << ft_empty.heap_bytes << std::setw(10) << std_empty.heap_bytes
+            << std::setw(10) << "-" << std::setw(10) << "-"
+            << std::setw(12) << ft_empty.allocations << std::setw(12)
+            << std_empty.allocations << std::endl;
+
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    const long n = sizes[i];
+    footprint ft = measure(ft_fill, n);
+    footprint ref = measure(std_fill, n);
+    double ft_heap = double(ft.heap_bytes) / n;
+    double std_heap = double(ref.heap_bytes) / n;
+
+    std::cout << std::setw(10) << n;
+    print_per_element(ft_heap);
+    print_per_element(std_heap);
+    print_per_element(ft.rss_bytes < 0 ? -1 : double(ft.rss_bytes) / n);
+    print_per_element(ref.rss_bytes < 0 ? -1 : double(ref.rss_bytes) / n);
+    std::cout << std::setw(12) << ft.allocations << std::setw(12)
+              << ref.allocations << std::endl;
+
+    if (ft_heap > std_heap * max_ratio) {
+      std::cout << RED_BOLD << "FOOTPRINT REGRESSION: " << name << " at "
+                << n << " ft uses " << ft_heap << " B/element, over "
+                << max_ratio << " x std's " << std_heap << UNSET
+                << std::endl;
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+int main( int argc, char** argv ) {
+
+  double max_ratio = FOOTPRINT_DEFAULT_MAX_RATIO;
+  if (argc > 1) {
+    max_ratio = std::atof(argv[1]);
+    if (max_ratio <= 0) {
+      std::cerr << "usage: " << argv[0] << " [max_ratio]" << std::endl;
+      return 2;
+    }
+  }
+
+  typedef ft::map<int, int, std::less<int>,
+                  ft::counting_allocator< ft::pair<const int, int> > > ft_map;
+  typedef std::map<int, int, std::less<int>,
+                   ft::counting_allocator< std::pair<const int, int> > >
+          std_map;
+  typedef ft::set<int, std::less<int>, ft::counting_allocator<int> > ft_set;
+  typedef std::set<int, std::less<int>, ft::counting_allocator<int> > std_set;
+  typedef ft::vector< int, ft::counting_allocator<int> > ft_vector;
+  typedef std::vector< int, ft::counting_allocator<int> > std_vector;
+
+  std::cout << std::fixed << std::setprecision(2)
+            << "bytes per element : heap asked of the allocator, rss"
+            << " resident growth" << std::endl;
+
+  bool ok = true;
+  ok &= compare("map<int, int>", fill_map<ft_map>, fill_map<std_map>,
+                max_ratio);
+  ok &= compare("set<int>", fill_set<ft_set>, fill_set<std_set>, max_ratio);
+  ok &= compare("vector<int> (push_back)", fill_vector<ft_vector>,
+                fill_vector<std_vector>, max_ratio);
+  return ok ? 0 : 1;
+}
@@ -8,21 +8,20 @@
 
 std::map<int, std::string> error_map;
 
+/* Correctness only : the performance tests are containers_bench. */
 int main() {
-  
+
   LoadErrorMap();
 
   vector_test();
-  vector_performance();
-
+  deque_test();
   stack_test();
-  stack_performance();
-
+  queue_test();
+  ring_buffer_test();
+  concurrent_test();
   map_test();
-  map_performance();
-
   set_test();
-  set_performance();
-  
+  algorithm_test();
+
   return 0;
-}
\ No newline at end of file
+}
@@ -1,94 +1,87 @@
 #include "ft/map.hpp"
+#include "ft/counting_allocator.hpp"
 #include <map>
-#include <cmath>
-#include <string.h>
-#include "../test_utils.hpp"
+#include <string>
+#include <vector>
+#include "../bench/bench.hpp"
+#include "../bench/tree_matrix.hpp"
+#include "../bench/generators.hpp"
 #include "../test.hpp"
+#include "../colors.hpp"
+#include <iostream>
 
-// Timing sponge test is about right for a performance test
-void map_performance() {
+#define TREE_SPONGE_MAX_SIZE 10000
 
-  std::cout << BLUE_BOLD
-            << "////////////// [ MAP PERFORMANCE ] ////////////// "
-            << UNSET << std::endl;
+/*
+ * Sponge : state.arg() uniform keys go in, then all come out in
+ * reverse insertion order. They go in again, and come out in
+ * insertion order. The keys are drawn before the clock starts, the
+ * same ones for ft and std.
+ */
+template < typename Map >
+static void sponge( bench::state& state ) {
 
-#define TREE_SPONGE_MAX_SIZE 10000
-  int iterations = 100;
-  int save_insertions[TREE_SPONGE_MAX_SIZE] = {0};
+  std::vector<unsigned long> keys =
+      bench::draw(bench::UNIFORM, state.arg(), 1UL << 31);
+  Map m;
+  state.start();
+  for (long i = 0; i < state.arg(); i++) {
+    m.insert(typename Map::value_type(int(keys[i]), "hello"));
+  }
+  for (long i = state.arg() - 1; i >= 0; i--) {
+    m.erase(int(keys[i]));
+  }
+  for (long i = 0; i < state.arg(); i++) {
+    m.insert(typename Map::value_type(int(keys[i]), "hello"));
+  }
+  for (long i = 0; i < state.arg(); i++) {
+    m.erase(int(keys[i]));
+  }
+  state.stop(4 * state.arg());
+  bench::do_not_optimize(m.size());
+}
 
-  ft::map<int, std::string> ft_map;
-  time_t ft_start = current_timestamp();
+namespace bench {
 
-  srand(time(NULL));
+/* A map stores (key, 0). */
+template < typename K, typename V, typename C, typename A >
+struct tree_entry< ft::map<K, V, C, A> > {
+  typedef ft::pair<const K, V> type;
+  static type make( const K& k ) { return type(k, V()); }
+};
 
-  int insertions = 0;
-  bool invert_deletion = false; // alternates between deleting from 0 -> TREE_SPONGE_MAX_SIZE
-                                // and TREE_SPONGE_MAX_SIZE -> 0.
-  for (int i = 0; i < iterations * TREE_SPONGE_MAX_SIZE; i++) {
-    // delete all entries 
-    if (insertions == TREE_SPONGE_MAX_SIZE) {
-      if (!invert_deletion) {
-        for (int k = insertions - 1; k >= 0; k--) {
-          ft_map.erase(save_insertions[k]);
-        }
-        invert_deletion = true;
-      } else {
-        for (int k = 0; k < insertions; k++) {
-          ft_map.erase(save_insertions[k]);
-        }
-        invert_deletion = false;
-      }
-      insertions = 0;
-    }
-    int random_number = rand();
-    ft_map.insert(ft::pair<int, std::string>(random_number, "hello"));
-    save_insertions[insertions++] = random_number;
-  }
+template < typename K, typename V, typename C, typename A >
+struct tree_entry< std::map<K, V, C, A> > {
+  typedef std::pair<const K, V> type;
+  static type make( const K& k ) { return type(k, V()); }
+};
 
-  time_t ft_end = current_timestamp();
-  double ft_time = (double)((ft_end - ft_start)/1000.0);
+} /* namespace bench */
 
-  memset(save_insertions, 0, sizeof(save_insertions));
+void map_performance() {
 
-  // std
-  std::map<int, std::string> std_map;
-  time_t std_start = current_timestamp();
+  std::cout << BLUE_BOLD
+            << "////////////// [ MAP PERFORMANCE ] ////////////// "
+            << UNSET << std::endl;
 
-  insertions = 0;
-  invert_deletion = false;
-  for (int i = 0; i < iterations * TREE_SPONGE_MAX_SIZE; i++) {
-    // delete all entries 
-    if (insertions == TREE_SPONGE_MAX_SIZE) {
-      if (!invert_deletion) {
-        for (int k = insertions - 1; k >= 0; k--) {
-          std_map.erase(save_insertions[k]);
-        }
-        invert_deletion = true;
-      } else {
-        for (int k = 0; k < insertions; k++) {
-          std_map.erase(save_insertions[k]);
-        }
-        invert_deletion = false;
-      }
-      insertions = 0;
-    }
-    int random_number = rand();
-    std_map.insert(std::pair<int, std::string>(random_number, "hello"));
-    save_insertions[insertions++] = random_number;
-  }
+  bench::header();
+  bench::row("map<int, string> sponge",
+             sponge< ft::map<int, std::string> >,
+             sponge< std::map<int, std::string> >, TREE_SPONGE_MAX_SIZE);
 
-  time_t std_end = current_timestamp();
-  double std_time = (double)((std_end - std_start)/1000.0);
+  // int keys count their allocations (see bench.hpp).
+  bench::tree_matrix< ft::map<int, int, std::less<int>, ft::counting_allocator<
+                        ft::pair<const int, int> > >,
+                      std::map<int, int, std::less<int>, ft::counting_allocator<
+                        std::pair<const int, int> > > >("map");
+  bench::tree_distributions< ft::map<int, int>,
+                             std::map<int, int> >("map");
+  bench::tree_matrix< ft::map<std::string, int>,
+                      std::map<std::string, int> >("map");
+  bench::tree_matrix< ft::map<bench::key64, int>,
+                      std::map<bench::key64, int> >("map");
 
-  std::cout << "ft time : " << ft_time << std::endl;
-  std::cout << "std time : " << std_time << std::endl;
-  std::cout << "RESULT : ft " << (fabs(std_time - ft_time)/std_time)*100.0;
-  if (ft_time < std_time) {
-    std::cout << "% faster than stl" << std::endl;
-  } else {
-    std::cout << "% slower than stl" << std::endl;
-  }
   std::cout << BLUE_BOLD
             << "////////////////////////////////////////////////"
-            << std::endl;
-}
\ No newline at end of file
+            << UNSET << std::endl;
+}
@@ -1,4 +1,7 @@
 #include "ft/map.hpp"
+#include "ft/set.hpp"
+#include "ft/vector.hpp"
+#include "ft/counting_allocator.hpp"
 #include <map>
 #include <iostream>
 #include "../test_utils.hpp"
@@ -32,6 +35,11 @@ static void constructors_test();
 static void assignment_operator_test();
 static void reverse_iteration();
 static void range_and_bounds_test();
+static void sizeof_test();
+static void allocation_test();
+#ifdef FT_CONTAINERS_CXX11
+static void move_test();
+#endif
 
 void map_test() {
   insert_no_fix();
@@ -45,6 +53,11 @@ void map_test() {
   reverse_iteration();
   assignment_operator_test();
   range_and_bounds_test();
+  sizeof_test();
+  allocation_test();
+#ifdef FT_CONTAINERS_CXX11
+  move_test();
+#endif
 }
 
 /*
@@ -494,4 +507,230 @@ static void range_and_bounds_test() {
     return MAP_TEST_ERROR(KO_RANGE);
   }
   return MAP_TEST_OK(RANGE_TAG);
-}
\ No newline at end of file
+}
+
+// comparator with state : it must follow the map around.
+struct ordered {
+
+  bool descending;
+
+  explicit ordered( bool d = false ) : descending(d) {}
+
+  bool operator()( int x, int y ) const {
+    return descending ? y < x : x < y;
+  }
+};
+
+/*
+ * std::less and std::allocator take no room (compressed_pair) : a
+ * map or a set is its tree's root, sentinel and count.
+ */
+static void sizeof_test() {
+
+  if (sizeof(ft::map<int, int>) != 3 * sizeof(void*)
+      || sizeof(ft::set<int>) != 3 * sizeof(void*)
+      || sizeof(ft::vector<int>) != 4 * sizeof(void*)
+      || sizeof(ft::compressed_pair<size_t, std::less<int> >)
+         != sizeof(size_t))
+  {
+    return MAP_TEST_ERROR(KO_SIZEOF);
+  }
+
+  ft::map<int, int, ordered> down((ordered(true)));
+  ft::map<int, int, ordered> up;
+  for (int i = 0; i < 10; i++) {
+    down[i] = i;
+    up[i] = i;
+  }
+  ft::map<int, int, ordered> copy(down);
+  if (down.begin()->first != 9 || copy.begin()->first != 9
+      || copy.key_comp()(1, 2)
+      || copy.value_comp()(ft::make_pair(1, 0), ft::make_pair(2, 0)))
+  {
+    return MAP_TEST_ERROR(KO_SIZEOF);
+  }
+  up.swap(copy);
+  up[10] = 10;
+  copy[10] = 10;
+  if (up.begin()->first != 10 || copy.begin()->first != 0
+      || (--copy.end())->first != 10)
+  {
+    return MAP_TEST_ERROR(KO_SIZEOF);
+  }
+  // assigned too, for map and set alike
+  ft::map<int, int, ordered> assigned;
+  assigned[42] = 42;
+  assigned = down;
+  assigned[10] = 10;
+  ft::set<int, ordered> set_down((ordered(true)));
+  ft::set<int, ordered> set_up;
+  set_down.insert(1);
+  set_down.insert(2);
+  set_up = set_down;
+  set_up.insert(3);
+  if (assigned.size() != 11 || assigned.begin()->first != 10
+      || assigned.key_comp()(1, 2) || *set_up.begin() != 3
+      || *(--set_up.end()) != 1)
+  {
+    return MAP_TEST_ERROR(KO_SIZEOF);
+  }
+  return MAP_TEST_OK(SIZEOF_TAG);
+}
+
+/*
+ * Allocation budgets, counted by an ft::counting_allocator the node
+ * allocator is rebound from : the sentinel, then one node per new
+ * key and none for lookups.
+ */
+static void allocation_test() {
+
+  typedef ft::counting_allocator< ft::pair<const int, int> > counting;
+  ft::allocation_stats stats;
+{
+  ft::map<int, int, std::less<int>, counting> m((std::less<int>()),
+                                                counting(stats));
+  if (stats.allocations != 1 || &m.get_allocator().stats() != &stats) {
+    return MAP_TEST_ERROR(KO_ALLOCATION);
+  }
+  for (int i = 0; i < 100; i++) {
+    m[i] = i;
+  }
+  if (stats.allocations != 101) {
+    return MAP_TEST_ERROR(KO_ALLOCATION);
+  }
+  int sum = 0;
+  for (int i = 0; i < 200; i++) {
+    sum += m[i % 100];
+    sum += m.find(i) != m.end();
+    sum += m.count(i);
+    sum += m.lower_bound(i) != m.end();
+  }
+  if (stats.allocations != 101 || sum != 2 * 4950 + 300) {
+    return MAP_TEST_ERROR(KO_ALLOCATION);
+  }
+  m.insert(ft::make_pair(100, 100));
+  m.insert(ft::make_pair(50, 0));
+  if (stats.allocations - stats.deallocations != 102) {
+    return MAP_TEST_ERROR(KO_ALLOCATION);
+  }
+  ft::map<int, int, std::less<int>, counting> copy(m);
+  if (stats.allocations - stats.deallocations != 2 * 102) {
+    return MAP_TEST_ERROR(KO_ALLOCATION);
+  }
+  size_t deallocations = stats.deallocations;
+  for (int i = 0; i < 50; i++) {
+    copy.erase(i);
+  }
+  if (stats.deallocations != deallocations + 50) {
+    return MAP_TEST_ERROR(KO_ALLOCATION);
+  }
+}
+  if (stats.live_allocations() != 0 || stats.live_bytes != 0
+      || stats.peak_bytes < 2 * 102 * sizeof(ft::pair<const int, int>))
+  {
+    return MAP_TEST_ERROR(KO_ALLOCATION);
+  }
+  return MAP_TEST_OK(ALLOCATION_TAG);
+}
+
+#ifdef FT_CONTAINERS_CXX11
+// mapped type that counts its copies.
+struct copy_counter {
+
+  static int copies;
+
+  int value;
+
+  copy_counter( int v = 0 ) : value(v) {}
+  copy_counter( const copy_counter& other ) : value(other.value) { ++copies; }
+  copy_counter( copy_counter&& other ) noexcept : value(other.value) {}
+  copy_counter& operator=( const copy_counter& other ) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  copy_counter& operator=( copy_counter&& other ) noexcept {
+    value = other.value;
+    return *this;
+  }
+};
+
+int copy_counter::copies = 0;
+
+/*
+ * C++11 mode only : emplace / try_emplace / operator[] never copy
+ * the mapped value, erasing never copies the ones left, and moving
+ * a map moves its nodes.
+ */
+static void move_test() {
+
+  ft::map<int, copy_counter> ft_map;
+  copy_counter::copies = 0;
+
+  for (int i = 0; i < 500; i++) {
+    ft_map.emplace(i, copy_counter(i));
+  }
+  ft_map.emplace_hint(ft_map.end(), 500, 500);
+  ft_map[501].value = 501;
+  ft_map.insert(ft::pair<const int, copy_counter>(502, copy_counter(502)));
+  if (ft_map.try_emplace(3, 42).second || ft_map[3].value != 3
+      || !ft_map.try_emplace(503, 503).second)
+  {
+    return MAP_TEST_ERROR(KO_MOVE);
+  }
+  for (int i = 0; i < 500; i += 3) {
+    ft_map.erase(i);
+  }
+  if (copy_counter::copies != 0 || ft_map.size() != 337) {
+    return MAP_TEST_ERROR(KO_MOVE);
+  }
+  ft::map<int, copy_counter>::iterator first = ft_map.begin();
+  ft::map<int, copy_counter> moved(std::move(ft_map));
+  if (moved.begin() != first || !ft_map.empty() || moved.size() != 337
+      || copy_counter::copies != 0)
+  {
+    return MAP_TEST_ERROR(KO_MOVE);
+  }
+  ft_map = std::move(moved);
+  if (ft_map.size() != 337 || !moved.empty() || ft_map[1].value != 1) {
+    return MAP_TEST_ERROR(KO_MOVE);
+  }
+  // a moved-from map is empty and usable, end() included as a hint
+  moved.emplace_hint(moved.end(), 7, 7);
+  moved.insert(moved.begin(), ft::make_pair(8, copy_counter(8)));
+  if (moved.size() != 2 || moved.begin()->first != 7
+      || (--moved.end())->first != 8)
+  {
+    return MAP_TEST_ERROR(KO_MOVE);
+  }
+
+  // moving allocates nothing, so it cannot throw
+  static_assert(std::is_nothrow_move_constructible<
+                  ft::map<int, copy_counter> >::value, "map move");
+  static_assert(std::is_nothrow_move_assignable<
+                  ft::map<int, copy_counter> >::value, "map move");
+  static_assert(std::is_nothrow_move_constructible<
+                  ft::pair<const int, copy_counter> >::value, "pair move");
+  typedef ft::counting_allocator< ft::pair<const int, int> > counting;
+  ft::allocation_stats stats;
+{
+  ft::map<int, int, std::less<int>, counting> m((std::less<int>()),
+                                                counting(stats));
+  m[1] = 1;
+  size_t allocations = stats.allocations;
+  ft::map<int, int, std::less<int>, counting> taken(std::move(m));
+  m = std::move(taken);
+  if (stats.allocations != allocations || m.size() != 1) {
+    return MAP_TEST_ERROR(KO_MOVE);
+  }
+}
+
+  // a null pointer constant is a T1 here, not a U1 to forward
+  ft::pair<int*, int> null_first(0, 1);
+  ft::pair<const char*, std::string> null_key(NULL, "x");
+  if (null_first.first || null_key.first || null_key.second != "x") {
+    return MAP_TEST_ERROR(KO_MOVE);
+  }
+  return MAP_TEST_OK(MOVE_TAG);
+}
+#endif
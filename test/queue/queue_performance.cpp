@@ -0,0 +1,104 @@
+#include "ft/queue.hpp"
+#include "ft/utils/utils.hpp"
+#include <queue>
+#include <vector>
+#include "../bench/bench.hpp"
+#include "../bench/generators.hpp"
+#include "../test.hpp"
+#include "../colors.hpp"
+#include <iostream>
+
+#define QUEUE_BACKLOG 100000
+#define QUEUE_OPERATIONS 2000000
+
+/*
+ * Scheduler-like FIFO : a steady backlog of QUEUE_BACKLOG tasks,
+ * every round pushes one and pops one, with a burst that doubles the
+ * backlog (then drains it) every million operations. state.arg()
+ * rounds, the backlog built before the clock starts.
+ */
+template < typename Queue >
+static void fifo( bench::state& state ) {
+
+  Queue q;
+  for (int i = 0; i < QUEUE_BACKLOG; i++) {
+    q.push(i);
+  }
+  long sum = 0;
+  state.start();
+  for (long i = 0; i < state.arg(); i++) {
+    q.push(int(i));
+    sum += q.front();
+    q.pop();
+    if (i % 1000000 == 0) {
+      for (int k = 0; k < QUEUE_BACKLOG; k++) {
+        q.push(k);
+      }
+      for (int k = 0; k < QUEUE_BACKLOG; k++) {
+        q.pop();
+      }
+    }
+  }
+  state.stop(state.arg());
+  bench::do_not_optimize(sum);
+}
+
+#define PQ_SIZE 1000000
+
+/* count uniform values, the same ones for every call (see --seed). */
+static std::vector<int> random_values( long count ) {
+  std::vector<unsigned long> keys =
+      bench::draw(bench::UNIFORM, count, 1UL << 31);
+  return std::vector<int>(keys.begin(), keys.end());
+}
+
+/* Pushes state.arg() random values, then pops them all. */
+template < typename PriorityQueue >
+static void push_pop( bench::state& state ) {
+
+  std::vector<int> values = random_values(state.arg());
+  PriorityQueue pq;
+  long sum = 0;
+  state.start();
+  for (size_t i = 0; i < values.size(); i++) {
+    pq.push(values[i]);
+  }
+  while (!pq.empty()) {
+    sum += pq.top();
+    pq.pop();
+  }
+  state.stop(2 * state.arg());
+  bench::do_not_optimize(sum);
+}
+
+/* Bulk construction from a range of state.arg() values (make_heap). */
+template < typename PriorityQueue >
+static void from_range( bench::state& state ) {
+
+  std::vector<int> values = random_values(state.arg());
+  state.start();
+  PriorityQueue pq(values.begin(), values.end());
+  state.stop(state.arg());
+  bench::do_not_optimize(pq.top());
+}
+
+void queue_performance() {
+
+  std::cout << BLUE_BOLD
+            << "///////////// [ QUEUE PERFORMANCE ] ///////////// "
+            << UNSET << std::endl;
+
+  bench::header();
+  bench::row("queue<int> fifo rounds", fifo< ft::queue<int> >,
+             fifo< std::queue<int> >, QUEUE_OPERATIONS);
+  bench::row("priority_queue<int> push / pop",
+             push_pop< ft::priority_queue<int> >,
+             push_pop< std::priority_queue<int> >, PQ_SIZE);
+  bench::row("priority_queue<int> from range",
+             from_range< ft::priority_queue<int> >,
+             from_range< std::priority_queue<int> >, PQ_SIZE);
+
+  std::cout << BLUE_BOLD
+            << "/////////////////////////////////////////////////"
+            << UNSET << std::endl;
+}
@@ -0,0 +1,211 @@
+#include "ft/queue.hpp"
+#include "ft/utils/heap.hpp"
+#include "ft/utils/utils.hpp"
+#include <queue>
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <cstdlib>
+#include "../test_utils.hpp"
+
+static void queue_fifo_test();
+static void queue_assignment_test();
+static void heap_algorithms_test();
+static void priority_queue_test();
+static void priority_queue_bulk_test();
+
+void queue_test() {
+  queue_fifo_test();
+  queue_assignment_test();
+  heap_algorithms_test();
+  priority_queue_test();
+  priority_queue_bulk_test();
+}
+
+static void queue_fifo_test() {
+
+  ft::queue<int> ft_q;
+  std::queue<int> std_q;
+
+  srand(11);
+  for (int i = 0; i < 100000; i++) {
+    if (rand() % 3 || std_q.empty()) {
+      ft_q.push(i);
+      std_q.push(i);
+    } else {
+      ft_q.pop();
+      std_q.pop();
+    }
+    if (ft_q.size() != std_q.size() || ft_q.front() != std_q.front()
+        || ft_q.back() != std_q.back())
+    {
+      return QUEUE_TEST_ERROR(KO_INSERT);
+    }
+  }
+  while (!std_q.empty()) {
+    if (ft_q.front() != std_q.front()) {
+      return QUEUE_TEST_ERROR(KO_ERASE);
+    }
+    ft_q.pop();
+    std_q.pop();
+  }
+  if (!ft_q.empty()) {
+    return QUEUE_TEST_ERROR(KO_ERASE);
+  }
+  return QUEUE_TEST_OK(INSERT_TAG);
+}
+
+static void queue_assignment_test() {
+
+  ft::queue<std::string> a;
+  for (int i = 0; i < 1000; i++) {
+    a.push("a");
+  }
+  ft::queue<std::string> b(a);
+  b.push("b");
+  if (b.size() != 1001 || !(a < b) || a == b || b.back() != "b") {
+    return QUEUE_TEST_ERROR(KO_ASSIGNMENT);
+  }
+  a = b;
+  if (a != b) {
+    return QUEUE_TEST_ERROR(KO_ASSIGNMENT);
+  }
+  ft::queue<std::string> c;
+  c.swap(a);
+  if (!a.empty() || c != b) {
+    return QUEUE_TEST_ERROR(KO_ASSIGNMENT);
+  }
+#ifdef FT_CONTAINERS_CXX11
+  c.emplace(3, 'c');
+  ft::queue<std::string> moved(std::move(c));
+  if (!c.empty() || moved.back() != "ccc") {
+    return QUEUE_TEST_ERROR(KO_MOVE);
+  }
+#endif
+  return QUEUE_TEST_OK(ASSIGNMENT_TAG);
+}
+
+/* ft::make_heap / push_heap / pop_heap / sort_heap on their own. */
+static void heap_algorithms_test() {
+
+  std::vector<int> v;
+  srand(5);
+  for (int i = 0; i < 10000; i++) {
+    v.push_back(rand() % 1000);
+  }
+  ft::make_heap(v.begin(), v.end());
+  if (!ft::is_heap(v.begin(), v.end())) {
+    return PRIORITY_QUEUE_TEST_ERROR(KO_HEAP);
+  }
+  for (int i = 0; i < 1000; i++) {
+    v.push_back(rand() % 2000);
+    ft::push_heap(v.begin(), v.end());
+  }
+  for (int i = 0; i < 500; i++) {
+    int top = v.front();
+    ft::pop_heap(v.begin(), v.end());
+    if (v.back() != top) {
+      return PRIORITY_QUEUE_TEST_ERROR(KO_HEAP);
+    }
+    v.pop_back();
+  }
+  if (!ft::is_heap(v.begin(), v.end())) {
+    return PRIORITY_QUEUE_TEST_ERROR(KO_HEAP);
+  }
+  std::vector<int> sorted(v);
+  std::sort(sorted.begin(), sorted.end());
+  ft::sort_heap(v.begin(), v.end());
+  if (v != sorted) {
+    return PRIORITY_QUEUE_TEST_ERROR(KO_HEAP);
+  }
+  // edge sizes
+  for (int n = 0; n < 20; n++) {
+    std::vector<int> small;
+    for (int i = 0; i < n; i++) {
+      small.push_back((i * 7) % 5);
+    }
+    ft::make_heap(small.begin(), small.end(), std::greater<int>());
+    if (!ft::is_heap(small.begin(), small.end(), std::greater<int>())) {
+      return PRIORITY_QUEUE_TEST_ERROR(KO_HEAP);
+    }
+  }
+  return PRIORITY_QUEUE_TEST_OK(HEAP_TAG);
+}
+
+static void priority_queue_test() {
+
+  ft::priority_queue<int> ft_pq;
+  std::priority_queue<int> std_pq;
+  ft::priority_queue<int, ft::vector<int>, std::greater<int> > ft_min;
+  std::priority_queue<int, std::vector<int>, std::greater<int> > std_min;
+
+  srand(9);
+  for (int i = 0; i < 100000; i++) {
+    if (rand() % 3 || std_pq.empty()) {
+      int value = rand() % 5000;
+      ft_pq.push(value);
+      std_pq.push(value);
+      ft_min.push(value);
+      std_min.push(value);
+    } else {
+      ft_pq.pop();
+      std_pq.pop();
+      ft_min.pop();
+      std_min.pop();
+    }
+    if (ft_pq.size() != std_pq.size() || ft_pq.top() != std_pq.top()
+        || ft_min.top() != std_min.top())
+    {
+      return PRIORITY_QUEUE_TEST_ERROR(KO_INSERT);
+    }
+  }
+  while (!std_pq.empty()) {
+    if (ft_pq.top() != std_pq.top()) {
+      return PRIORITY_QUEUE_TEST_ERROR(KO_ERASE);
+    }
+    ft_pq.pop();
+    std_pq.pop();
+  }
+#ifdef FT_CONTAINERS_CXX11
+  ft::priority_queue<std::string> strings;
+  strings.emplace(3, 'a');
+  strings.push(std::string("b"));
+  if (strings.top() != "b") {
+    return PRIORITY_QUEUE_TEST_ERROR(KO_MOVE);
+  }
+#endif
+  return PRIORITY_QUEUE_TEST_OK(INSERT_TAG);
+}
+
+/* Range construction and push_range, both regimes. */
+static void priority_queue_bulk_test() {
+
+  std::vector<int> values;
+  srand(13);
+  for (int i = 0; i < 20000; i++) {
+    values.push_back(rand());
+  }
+  ft::priority_queue<int> ft_pq(values.begin(), values.end());
+  std::priority_queue<int> std_pq(values.begin(), values.end());
+
+  ft_pq.push_range(values.begin(), values.begin() + 100);    // sift up
+  for (int i = 0; i < 100; i++) {
+    std_pq.push(values[i]);
+  }
+  ft::priority_queue<int> grown;
+  grown.push(1);
+  grown.push_range(values.begin(), values.end());            // rebuild
+  grown.pop();
+  for (int i = 0; i < 20100; i++) {
+    if (ft_pq.top() != std_pq.top()) {
+      return PRIORITY_QUEUE_TEST_ERROR(KO_CONSTRUCTOR);
+    }
+    ft_pq.pop();
+    std_pq.pop();
+  }
+  if (!ft_pq.empty() || grown.size() != 20000) {
+    return PRIORITY_QUEUE_TEST_ERROR(KO_CONSTRUCTOR);
+  }
+  return PRIORITY_QUEUE_TEST_OK(RANGE_TAG);
+}
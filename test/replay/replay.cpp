@@ -0,0 +1,474 @@
+#include "trace.hpp"
+#include "../bench/bench.hpp"
+#include "../bench/generators.hpp"
+#include "ft/map.hpp"
+#include "ft/set.hpp"
+#include "ft/vector.hpp"
+#include "ft/stack.hpp"
+#include <map>
+#include <set>
+#include <vector>
+#include <stack>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include "../colors.hpp"
+
+/*
+ * Replays operation traces (see trace.hpp) on the ft:: container and
+ * its std:: equivalent :
+ *
+ *    containers_replay TRACE...
+ *    containers_replay --generate map|set|vector|stack OPS TRACE [--seed N]
+ *
+ * The trace is mapped, not read. Each implementation replays it twice,
+ * on a fresh container each time :
+ *
+ *    - for the throughput, REPLAY_CHUNK records at a time, ft then
+ *      std, the results of each chunk compared before the next one :
+ *      both sides must give the same results, the first difference is
+ *      reported and the exit status is 1
+ *    - with the clock read around every operation, for the latency
+ *      percentiles per operation and the log2 histogram over all of
+ *      them. The cost of reading the clock (smallest difference of two
+ *      back to back reads) is taken off each latency.
+ *
+ * Only the latencies are kept for the whole trace, 4 bytes per record
+ * and implementation : the percentiles need them all.
+ *
+ * --generate writes a synthetic trace (trace.cpp, synthesize()) for
+ * trying the driver out : make replay without TRACE does that for each
+ * container. Exit status 2 is a usage or a file error.
+ */
+
+#define REPLAY_HISTOGRAM_BUCKETS 24
+#define REPLAY_CHUNK (1 << 16)
+
+namespace {
+
+using replay::trace_record;
+
+size_t position( int32_t key, size_t size ) {
+  return size_t(uint32_t(key)) % size;
+}
+
+/* What the trees hold is key to key : the key says it all. */
+int key_of( int value ) {
+  return value;
+}
+
+template < typename Pair >
+int key_of( const Pair& value ) {
+  return value.first;
+}
+
+template < typename Set >
+bool insert_key( Set& s, int key ) {
+  return s.insert(key).second;
+}
+
+template < typename K, typename V, typename C, typename A >
+bool insert_key( ft::map<K, V, C, A>& m, int key ) {
+  return m.insert(typename ft::map<K, V, C, A>::value_type(key, key)).second;
+}
+
+template < typename K, typename V, typename C, typename A >
+bool insert_key( std::map<K, V, C, A>& m, int key ) {
+  return m.insert(typename std::map<K, V, C, A>::value_type(key, key)).second;
+}
+
+/*
+ * One operation on the container, and what it gave back : -1 for
+ * nothing (not found, empty), else a value both implementations must
+ * agree on.
+ */
+template < typename Tree >
+struct tree_ops {
+  static int64_t apply( Tree& t, const trace_record& r ) {
+    switch (r.op) {
+      case replay::INSERT:
+        return insert_key(t, r.key);
+      case replay::FIND: {
+        typename Tree::iterator it = t.find(r.key);
+        return it == t.end() ? -1 : key_of(*it);
+      }
+      case replay::ERASE:
+        return t.erase(r.key);
+      case replay::LOWER_BOUND: {
+        typename Tree::iterator it = t.lower_bound(r.key);
+        return it == t.end() ? -1 : key_of(*it);
+      }
+      default: {
+        int64_t sum = 0;
+        typename Tree::iterator it = t.lower_bound(r.key);
+        for (int n = 0; n < r.count && it != t.end(); n++, ++it) {
+          sum += int64_t(key_of(*it)) + 1;
+        }
+        return sum;
+      }
+    }
+  }
+};
+
+template < typename Vector >
+struct vector_ops {
+  static int64_t apply( Vector& v, const trace_record& r ) {
+    switch (r.op) {
+      case replay::INSERT:
+        v.insert(v.begin() + position(r.key, v.size() + 1), r.key);
+        return v.size();
+      case replay::FIND:
+        return v.empty() ? -1 : v[position(r.key, v.size())];
+      case replay::ERASE: {
+        if (v.empty()) {
+          return -1;
+        }
+        size_t i = position(r.key, v.size());
+        int64_t erased = v[i];
+        v.erase(v.begin() + i);
+        return erased;
+      }
+      case replay::PUSH:
+        v.push_back(r.key);
+        return v.size();
+      case replay::POP: {
+        if (v.empty()) {
+          return -1;
+        }
+        int64_t back = v.back();
+        v.pop_back();
+        return back;
+      }
+      default: {
+        if (v.empty()) {
+          return -1;
+        }
+        int64_t sum = 0;
+        size_t first = position(r.key, v.size());
+        for (size_t i = first; i < v.size() && i - first < r.count; i++) {
+          sum += int64_t(v[i]) + 1;
+        }
+        return sum;
+      }
+    }
+  }
+};
+
+template < typename Stack >
+struct stack_ops {
+  static int64_t apply( Stack& s, const trace_record& r ) {
+    switch (r.op) {
+      case replay::PUSH:
+        s.push(r.key);
+        return s.size();
+      case replay::POP: {
+        if (s.empty()) {
+          return -1;
+        }
+        int64_t top = s.top();
+        s.pop();
+        return top;
+      }
+      default:
+        return s.empty() ? -1 : s.top();
+    }
+  }
+};
+
+struct run_result {
+  uint64_t              elapsed_ns;
+  std::vector<uint32_t> latency[replay::OPS];   // ns, sorted
+};
+
+uint64_t clock_cost() {
+  uint64_t best = ~uint64_t(0);
+  for (int i = 0; i < 1000; i++) {
+    uint64_t start = bench::now_ns();
+    uint64_t end = bench::now_ns();
+    best = std::min(best, end - start);
+  }
+  return best;
+}
+
+/* Replays the n records from first on c, timed, results into out. */
+template < typename Container, typename Ops >
+uint64_t replay_chunk( Container& c, const trace_record* first, size_t n,
+                       int64_t* out )
+{
+  uint64_t start = bench::now_ns();
+  for (size_t i = 0; i < n; i++) {
+    out[i] = Ops::apply(c, first[i]);
+  }
+  return bench::now_ns() - start;
+}
+
+/*
+ * The throughput run of both implementations, chunk by chunk, so two
+ * chunks of results are held whatever the trace size. Returns the
+ * first record they disagree on (its results at the front of
+ * ft_results and std_results), count if none.
+ */
+template < typename FtContainer, typename FtOps,
+           typename StdContainer, typename StdOps >
+size_t replay_results( const replay::trace_file& trace, run_result& ft,
+                       run_result& ref, std::vector<int64_t>& ft_results,
+                       std::vector<int64_t>& std_results )
+{
+  const trace_record* records = trace.records();
+  const size_t count = trace.count();
+  ft_results.resize(REPLAY_CHUNK);
+  std_results.resize(REPLAY_CHUNK);
+  ft.elapsed_ns = 0;
+  ref.elapsed_ns = 0;
+
+  FtContainer f;
+  StdContainer s;
+  for (size_t base = 0; base < count; base += REPLAY_CHUNK) {
+    size_t n = std::min<size_t>(REPLAY_CHUNK, count - base);
+    ft.elapsed_ns += replay_chunk<FtContainer, FtOps>(
+                       f, records + base, n, &ft_results[0]);
+    ref.elapsed_ns += replay_chunk<StdContainer, StdOps>(
+                        s, records + base, n, &std_results[0]);
+    for (size_t i = 0; i < n; i++) {
+      if (ft_results[i] != std_results[i]) {
+        ft_results.erase(ft_results.begin(), ft_results.begin() + i);
+        std_results.erase(std_results.begin(), std_results.begin() + i);
+        return base + i;
+      }
+    }
+  }
+  return count;
+}
+
+/* The latency run, the clock read around every operation. */
+template < typename Container, typename Ops >
+void replay_latency( const replay::trace_file& trace, run_result& out ) {
+
+  const trace_record* records = trace.records();
+  const size_t count = trace.count();
+
+  size_t per_op[replay::OPS] = { 0 };
+  for (size_t i = 0; i < count; i++) {
+    per_op[records[i].op]++;
+  }
+  for (int op = 0; op < replay::OPS; op++) {
+    out.latency[op].reserve(per_op[op]);
+  }
+  const uint64_t cost = clock_cost();
+  {
+    Container c;
+    for (size_t i = 0; i < count; i++) {
+      uint64_t start = bench::now_ns();
+      bench::do_not_optimize(Ops::apply(c, records[i]));
+      uint64_t took = bench::now_ns() - start;
+      out.latency[records[i].op].push_back(took > cost ? took - cost : 0);
+    }
+  }
+  for (int op = 0; op < replay::OPS; op++) {
+    std::sort(out.latency[op].begin(), out.latency[op].end());
+  }
+}
+
+/* Nearest rank, of a sorted and non empty sample. */
+uint32_t percentile( const std::vector<uint32_t>& sorted, double p ) {
+  size_t rank = size_t(p / 100.0 * sorted.size() + 0.5);
+  return sorted[rank ? std::min(rank, sorted.size()) - 1 : 0];
+}
+
+/* Bucket b is [2^b, 2^(b+1)) ns, the first from 0, the last unbounded. */
+int bucket( uint32_t ns ) {
+  int b = 0;
+  while (ns >>= 1) {
+    b++;
+  }
+  return std::min(b, REPLAY_HISTOGRAM_BUCKETS - 1);
+}
+
+void histogram( const run_result& ft, const run_result& ref ) {
+
+  size_t ft_counts[REPLAY_HISTOGRAM_BUCKETS] = { 0 };
+  size_t std_counts[REPLAY_HISTOGRAM_BUCKETS] = { 0 };
+  size_t total = 0;
+  for (int op = 0; op < replay::OPS; op++) {
+    for (size_t i = 0; i < ft.latency[op].size(); i++) {
+      ft_counts[bucket(ft.latency[op][i])]++;
+      std_counts[bucket(ref.latency[op][i])]++;
+    }
+    total += ft.latency[op].size();
+  }
+  int first = 0;
+  int last = REPLAY_HISTOGRAM_BUCKETS - 1;
+  while (first < last && !ft_counts[first] && !std_counts[first]) {
+    first++;
+  }
+  while (last > first && !ft_counts[last] && !std_counts[last]) {
+    last--;
+  }
+
+  std::cout << std::setw(19) << "latency (ns)" << std::setw(9) << "ft %"
+            << std::setw(9) << "std %" << "  ft" << std::endl;
+  for (int b = first; b <= last; b++) {
+    double ft_share = 100.0 * ft_counts[b] / total;
+    double std_share = 100.0 * std_counts[b] / total;
+    std::cout << std::setw(8) << (b ? 1UL << b : 0) << " - ";
+    if (b == REPLAY_HISTOGRAM_BUCKETS - 1) {
+      std::cout << std::setw(8) << "";
+    } else {
+      std::cout << std::setw(8) << std::left << (1UL << (b + 1))
+                << std::right;
+    }
+    std::cout << std::setw(9) << ft_share << std::setw(9) << std_share
+              << "  " << std::string(int(ft_share / 2), '#') << std::endl;
+  }
+}
+
+void report( const replay::trace_file& trace, const run_result& ft,
+             const run_result& ref )
+{
+  const size_t count = trace.count();
+  double ft_rate = count ? count * 1e3 / std::max<uint64_t>(ft.elapsed_ns, 1)
+                         : 0;
+  double std_rate = count ? count * 1e3
+                            / std::max<uint64_t>(ref.elapsed_ns, 1)
+                          : 0;
+
+  std::cout << std::fixed << std::setprecision(2)
+            << "throughput (Mops/s)   ft " << ft_rate << "   std "
+            << std_rate << "   " << (std_rate ? ft_rate / std_rate : 0)
+            << "x" << std::endl;
+
+  std::cout << std::setw(12) << "op" << std::setw(10) << "count"
+            << std::setw(8) << "p50" << std::setw(8) << "p99"
+            << std::setw(9) << "max" << " |" << std::setw(8) << "p50"
+            << std::setw(8) << "p99" << std::setw(9) << "max"
+            << "   ns, ft | std" << std::endl;
+  for (int op = 0; op < replay::OPS; op++) {
+    const std::vector<uint32_t>& f = ft.latency[op];
+    const std::vector<uint32_t>& s = ref.latency[op];
+    if (f.empty()) {
+      continue ;
+    }
+    std::cout << std::setw(12) << replay::op_name(op) << std::setw(10)
+              << f.size() << std::setw(8) << percentile(f, 50)
+              << std::setw(8) << percentile(f, 99) << std::setw(9)
+              << f.back() << " |" << std::setw(8) << percentile(s, 50)
+              << std::setw(8) << percentile(s, 99) << std::setw(9)
+              << s.back() << std::endl;
+  }
+  if (count) {
+    histogram(ft, ref);
+  }
+}
+
+template < typename FtContainer, typename StdContainer,
+           template < typename > class Ops >
+bool compare( const replay::trace_file& trace ) {
+
+  run_result ft;
+  run_result ref;
+  std::vector<int64_t> ft_results;
+  std::vector<int64_t> std_results;
+  size_t i = replay_results< FtContainer, Ops<FtContainer>,
+                             StdContainer, Ops<StdContainer> >(
+               trace, ft, ref, ft_results, std_results);
+  if (i != trace.count()) {
+    const trace_record& r = trace.records()[i];
+    std::cout << RED_BOLD << "REPLAY MISMATCH at record " << i << " ("
+              << replay::op_name(r.op) << " " << r.key;
+    if (r.op == replay::ITERATE) {
+      std::cout << " x " << r.count;
+    }
+    std::cout << ") : ft gives " << ft_results[0] << ", std "
+              << std_results[0] << UNSET << std::endl;
+    return false;
+  }
+  replay_latency< FtContainer, Ops<FtContainer> >(trace, ft);
+  replay_latency< StdContainer, Ops<StdContainer> >(trace, ref);
+  report(trace, ft, ref);
+  return true;
+}
+
+/* 0 when the results matched, 1 when not, 2 when the trace is unusable. */
+int replay_file( const std::string& path ) {
+
+  replay::trace_file trace;
+  std::string error;
+  if (!trace.open(path, error)) {
+    std::cerr << "replay: " << error << std::endl;
+    return 2;
+  }
+  std::cout << BLUE_BOLD << path << UNSET << "  "
+            << replay::container_name(trace.container()) << "<int>, "
+            << trace.count() << " operations" << std::endl;
+
+  bool same = true;
+  switch (trace.container()) {
+    case replay::MAP:
+      same = compare< ft::map<int, int>, std::map<int, int>, tree_ops >(trace);
+      break ;
+    case replay::SET:
+      same = compare< ft::set<int>, std::set<int>, tree_ops >(trace);
+      break ;
+    case replay::VECTOR:
+      same = compare< ft::vector<int>, std::vector<int>, vector_ops >(trace);
+      break ;
+    case replay::STACK:
+      same = compare< ft::stack<int>, std::stack<int>, stack_ops >(trace);
+      break ;
+  }
+  return same ? 0 : 1;
+}
+
+int usage( const char* self ) {
+  std::cerr << "usage: " << self << " TRACE..." << std::endl
+            << "       " << self << " --generate map|set|vector|stack OPS"
+            << " TRACE [--seed N]" << std::endl;
+  return 2;
+}
+
+int generate( int argc, char** argv ) {
+
+  if (argc != 5 && !(argc == 7 && std::strcmp(argv[5], "--seed") == 0)) {
+    return usage(argv[0]);
+  }
+  int container = replay::container_from_name(argv[2]);
+  char* end;
+  long count = std::strtol(argv[3], &end, 10);
+  if (container < 0 || *end || count < 0) {
+    return usage(argv[0]);
+  }
+  if (argc == 7) {
+    unsigned long long seed = std::strtoull(argv[6], &end, 10);
+    if (*end || !*argv[6]) {
+      return usage(argv[0]);
+    }
+    bench::set_seed(seed);
+  }
+  std::string error;
+  if (!replay::write_trace(argv[4], container,
+                           replay::synthesize(container, count), error))
+  {
+    std::cerr << "replay: " << error << std::endl;
+    return 2;
+  }
+  return 0;
+}
+
+} /* namespace */
+
+int main( int argc, char** argv ) {
+
+  if (argc < 2) {
+    return usage(argv[0]);
+  }
+  if (std::strcmp(argv[1], "--generate") == 0) {
+    return generate(argc, argv);
+  }
+  int status = 0;
+  for (int i = 1; i < argc; i++) {
+    status = std::max(status, replay_file(argv[i]));
+  }
+  return status;
+}
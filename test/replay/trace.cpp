@@ -0,0 +1,223 @@
+#include "trace.hpp"
+#include "../bench/generators.hpp"
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace replay {
+
+namespace {
+
+const char* const container_names[CONTAINERS] = {
+  "map", "set", "vector", "stack"
+};
+
+const char* const op_names[OPS] = {
+  "insert", "find", "erase", "lower_bound", "iterate", "push", "pop"
+};
+
+/* Per container, the ops it takes, as a bit mask. */
+const unsigned supported[CONTAINERS] = {
+  1u << INSERT | 1u << FIND | 1u << ERASE | 1u << LOWER_BOUND | 1u << ITERATE,
+  1u << INSERT | 1u << FIND | 1u << ERASE | 1u << LOWER_BOUND | 1u << ITERATE,
+  1u << INSERT | 1u << FIND | 1u << ERASE | 1u << ITERATE | 1u << PUSH
+    | 1u << POP,
+  1u << FIND | 1u << PUSH | 1u << POP
+};
+
+/*
+ * The synthetic mixes, in percent. The vector one keeps pushes and
+ * pops about even, so the vector stays small enough for the inserts
+ * and erases in the middle not to dominate.
+ */
+struct share {
+  int op;
+  int percent;
+};
+
+const share tree_mix[] = {
+  { FIND, 40 }, { INSERT, 25 }, { ERASE, 15 }, { LOWER_BOUND, 15 },
+  { ITERATE, 5 }
+};
+
+const share vector_mix[] = {
+  { FIND, 43 }, { PUSH, 25 }, { POP, 20 }, { ITERATE, 10 }, { INSERT, 1 },
+  { ERASE, 1 }
+};
+
+const share stack_mix[] = {
+  { PUSH, 45 }, { POP, 40 }, { FIND, 15 }
+};
+
+int pick( const share* mix, size_t shares, unsigned long roll ) {
+  for (size_t i = 0; i < shares; i++) {
+    if (roll < (unsigned long)(mix[i].percent)) {
+      return mix[i].op;
+    }
+    roll -= mix[i].percent;
+  }
+  return mix[shares - 1].op;
+}
+
+std::string describe( const std::string& what, const std::string& path ) {
+  return path + ": " + what + ": " + std::strerror(errno);
+}
+
+} /* namespace */
+
+const char* container_name( int container ) {
+  return container_names[container];
+}
+
+const char* op_name( int op ) {
+  return op_names[op];
+}
+
+int container_from_name( const std::string& name ) {
+  for (int c = 0; c < CONTAINERS; c++) {
+    if (name == container_names[c]) {
+      return c;
+    }
+  }
+  return -1;
+}
+
+bool supports( int container, int op ) {
+  return (supported[container] >> op) & 1u;
+}
+
+trace_file::trace_file() : _map(0), _size(0) {}
+
+trace_file::~trace_file() {
+  if (_map) {
+    munmap(_map, _size);
+  }
+}
+
+bool trace_file::open( const std::string& path, std::string& error ) {
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    error = describe("open", path);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    error = describe("stat", path);
+    close(fd);
+    return false;
+  }
+  if (size_t(st.st_size) < sizeof(trace_header)) {
+    close(fd);
+    error = path + ": not a trace (too short for a header)";
+    return false;
+  }
+  _size = st.st_size;
+  _map = mmap(0, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (_map == MAP_FAILED) {
+    _map = 0;
+    error = describe("mmap", path);
+    return false;
+  }
+  madvise(_map, _size, MADV_SEQUENTIAL);
+
+  const trace_header& h = header();
+  std::ostringstream problem;
+  if (std::memcmp(h.magic, TRACE_MAGIC, sizeof(h.magic)) != 0) {
+    problem << "not a trace (bad magic)";
+  } else if (h.version != TRACE_VERSION) {
+    problem << "trace version " << h.version << ", this driver reads "
+            << TRACE_VERSION;
+  } else if (h.container >= CONTAINERS) {
+    problem << "unknown container " << h.container;
+  } else if (h.count != (_size - sizeof(trace_header))
+                        / sizeof(trace_record)
+             || (_size - sizeof(trace_header)) % sizeof(trace_record))
+  {
+    problem << "header says " << h.count << " records, the file holds "
+            << double(_size - sizeof(trace_header)) / sizeof(trace_record);
+  } else {
+    const trace_record* r = records();
+    for (size_t i = 0; i < count(); i++) {
+      if (r[i].op >= OPS || !supports(container(), r[i].op)) {
+        problem << "record " << i << ": op " << r[i].op << " ("
+                << (r[i].op < OPS ? op_name(r[i].op) : "unknown")
+                << ") is not a " << container_name(container()) << " op";
+        break ;
+      }
+    }
+  }
+  if (!problem.str().empty()) {
+    error = path + ": " + problem.str();
+    return false;
+  }
+  return true;
+}
+
+bool write_trace( const std::string& path, int container,
+                  const std::vector<trace_record>& records,
+                  std::string& error )
+{
+  trace_header h;
+  std::memset(&h, 0, sizeof(h));
+  std::memcpy(h.magic, TRACE_MAGIC, sizeof(h.magic));
+  h.version = TRACE_VERSION;
+  h.container = container;
+  h.count = records.size();
+
+  FILE* out = std::fopen(path.c_str(), "wb");
+  if (!out) {
+    error = describe("open", path);
+    return false;
+  }
+  bool ok = std::fwrite(&h, sizeof(h), 1, out) == 1
+            && (records.empty()
+                || std::fwrite(&records[0], sizeof(trace_record),
+                               records.size(), out) == records.size());
+  if (std::fclose(out) != 0) {
+    ok = false;
+  }
+  if (!ok) {
+    error = describe("write", path);
+  }
+  return ok;
+}
+
+std::vector<trace_record> synthesize( int container, long count ) {
+
+  const share* mix = tree_mix;
+  size_t shares = sizeof(tree_mix) / sizeof(tree_mix[0]);
+  if (container == VECTOR) {
+    mix = vector_mix;
+    shares = sizeof(vector_mix) / sizeof(vector_mix[0]);
+  } else if (container == STACK) {
+    mix = stack_mix;
+    shares = sizeof(stack_mix) / sizeof(stack_mix[0]);
+  }
+
+  // Trees get zipf keys over a quarter as many keys as operations, so
+  // finds hit and inserts collide. Vector and stack keys only pick
+  // positions and values.
+  unsigned long universe = count / 4 > 16 ? count / 4 : 16;
+  std::vector<unsigned long> keys = container == MAP || container == SET
+                                    ? bench::draw(bench::ZIPF, count, universe)
+                                    : bench::draw(bench::UNIFORM, count,
+                                                  1UL << 31);
+  bench::rng r(bench::seed() ^ 0x7472616365ULL);
+
+  std::vector<trace_record> records(count);
+  for (long i = 0; i < count; i++) {
+    records[i].op = pick(mix, shares, r.below(100));
+    records[i].count = records[i].op == ITERATE ? 1 + r.below(64) : 0;
+    records[i].key = int32_t(keys[i]);
+  }
+  return records;
+}
+
+} /* namespace replay */
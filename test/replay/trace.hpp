@@ -0,0 +1,132 @@
+#ifndef CONTAINERS_TRACE_HPP
+# define CONTAINERS_TRACE_HPP
+# pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+ * Operation traces : a recorded sequence of operations on one
+ * container, replayed by containers_replay on ft:: and std::.
+ *
+ * A trace file is a header then a packed array of 8 byte records, in
+ * host byte order (little endian everywhere we run) :
+ *
+ *    header    char     magic[8]     "FTTRACE\0"
+ *              uint32_t version      TRACE_VERSION
+ *              uint32_t container    trace_container
+ *              uint64_t count        number of records
+ *    record    uint16_t op           trace_op
+ *              uint16_t count        ITERATE : elements to walk
+ *              int32_t  key
+ *
+ * What an op means depends on the container :
+ *
+ *                  map / set             vector                stack
+ *    INSERT        insert(key)           insert at key % (size + 1)
+ *    FIND          find(key)             [key % size]          top()
+ *    ERASE         erase(key)            erase at key % size
+ *    LOWER_BOUND   lower_bound(key)
+ *    ITERATE       count elements from   count elements from
+ *                  lower_bound(key)      key % size
+ *    PUSH                                push_back(key)        push(key)
+ *    POP                                 pop_back()            pop()
+ *
+ * An op left blank for a container makes the trace invalid. A map
+ * maps key to key.
+ */
+
+namespace replay {
+
+#define TRACE_MAGIC "FTTRACE"
+#define TRACE_VERSION 1
+
+enum trace_container {
+  MAP,
+  SET,
+  VECTOR,
+  STACK,
+  CONTAINERS
+};
+
+enum trace_op {
+  INSERT,
+  FIND,
+  ERASE,
+  LOWER_BOUND,
+  ITERATE,
+  PUSH,
+  POP,
+  OPS
+};
+
+struct trace_header {
+  char      magic[8];
+  uint32_t  version;
+  uint32_t  container;
+  uint64_t  count;
+};
+
+struct trace_record {
+  uint16_t  op;
+  uint16_t  count;
+  int32_t   key;
+};
+
+const char* container_name( int container );
+const char* op_name( int op );
+
+/* -1 when name is not a container. */
+int container_from_name( const std::string& name );
+
+/* Whether op means something on container (see the table above). */
+bool supports( int container, int op );
+
+/*
+ * A trace file mapped read only. open() checks the header, the size
+ * and every record, and says what is wrong in error when it fails.
+ */
+class trace_file {
+
+  void*   _map;
+  size_t  _size;
+
+  trace_file( const trace_file& );
+  trace_file& operator=( const trace_file& );
+
+  public:
+
+  trace_file();
+  ~trace_file();
+
+  bool open( const std::string& path, std::string& error );
+
+  const trace_header& header() const {
+    return *static_cast<const trace_header*>(_map);
+  }
+
+  const trace_record* records() const {
+    return reinterpret_cast<const trace_record*>(
+             static_cast<const char*>(_map) + sizeof(trace_header));
+  }
+
+  size_t count() const { return size_t(header().count); }
+  int container() const { return int(header().container); }
+};
+
+bool write_trace( const std::string& path, int container,
+                  const std::vector<trace_record>& records,
+                  std::string& error );
+
+/*
+ * A synthetic trace of count operations on container, from the
+ * benchmark generators and bench::seed() : zipf keys, mostly lookups.
+ * For trying the driver out when no recorded trace is at hand.
+ */
+std::vector<trace_record> synthesize( int container, long count );
+
+} /* namespace replay */
+
+#endif /* CONTAINERS_TRACE_HPP */
@@ -0,0 +1,75 @@
+#include "ft/ring_buffer.hpp"
+#include "ft/queue.hpp"
+#include "ft/utils/utils.hpp"
+#include <queue>
+#include "../bench/bench.hpp"
+#include "../test.hpp"
+#include "../colors.hpp"
+#include <iostream>
+
+#define RING_CAPACITY 1024
+#define RING_OPERATIONS 5000000
+
+/*
+ * Bounded producer / consumer on one thread : the producer pushes
+ * bursts of up to 300 items, the consumer drains a burst of 280, so
+ * the fill level keeps moving and indices wrap constantly. The queues
+ * are kept under RING_CAPACITY like the ring buffer, so all of them
+ * do the same work. state.arg() items go through.
+ */
+static void ring( bench::state& state ) {
+
+  ft::ring_buffer<int> rb(RING_CAPACITY);
+  long sum = 0;
+  int produced = 0;
+  state.start();
+  while (produced < state.arg()) {
+    for (int k = 0; k < 300 && rb.push(produced); k++) {
+      ++produced;
+    }
+    for (int k = 0; k < 280 && !rb.empty(); k++) {
+      sum += rb.front();
+      rb.pop();
+    }
+  }
+  state.stop(produced);
+  bench::do_not_optimize(sum);
+}
+
+template < typename Queue >
+static void bounded_queue( bench::state& state ) {
+
+  Queue q;
+  long sum = 0;
+  int produced = 0;
+  state.start();
+  while (produced < state.arg()) {
+    for (int k = 0; k < 300 && q.size() < RING_CAPACITY; k++) {
+      q.push(produced++);
+    }
+    for (int k = 0; k < 280 && !q.empty(); k++) {
+      sum += q.front();
+      q.pop();
+    }
+  }
+  state.stop(produced);
+  bench::do_not_optimize(sum);
+}
+
+void ring_buffer_performance() {
+
+  std::cout << BLUE_BOLD
+            << "////////// [ RING BUFFER PERFORMANCE ] ////////// "
+            << UNSET << std::endl;
+
+  bench::header("ft::ring_buffer", "std::queue");
+  bench::row("ring_buffer bursts", ring, bounded_queue< std::queue<int> >,
+             RING_OPERATIONS);
+  bench::header("ft::queue", "std::queue");
+  bench::row("bounded queue bursts", bounded_queue< ft::queue<int> >,
+             bounded_queue< std::queue<int> >, RING_OPERATIONS);
+
+  std::cout << BLUE_BOLD
+            << "/////////////////////////////////////////////////"
+            << UNSET << std::endl;
+}
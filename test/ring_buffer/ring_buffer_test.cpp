@@ -0,0 +1,106 @@
+#include "ft/ring_buffer.hpp"
+#include "ft/utils/utils.hpp"
+#include <deque>
+#include <string>
+#include <cstdlib>
+#include "../test_utils.hpp"
+
+static void capacity_test();
+static void fifo_test();
+static void assignment_operator_test();
+
+void ring_buffer_test() {
+  capacity_test();
+  fifo_test();
+  assignment_operator_test();
+}
+
+/* Capacity is rounded up to a power of two and is fully usable. */
+static void capacity_test() {
+
+  ft::ring_buffer<int> one(0);
+  ft::ring_buffer<int> rb(100);
+  if (one.capacity() != 1 || rb.capacity() != 128
+      || ft::ring_buffer<int>(128).capacity() != 128)
+  {
+    return RING_BUFFER_TEST_ERROR(KO_RESERVE);
+  }
+  for (int i = 0; i < 128; i++) {
+    if (!rb.push(i)) {
+      return RING_BUFFER_TEST_ERROR(KO_RESERVE);
+    }
+  }
+  if (!rb.full() || rb.push(128) || rb.size() != 128 || rb.back() != 127) {
+    return RING_BUFFER_TEST_ERROR(KO_RESERVE);
+  }
+  int out = -1;
+  if (!rb.pop(out) || out != 0 || !rb.push(128) || rb[127] != 128) {
+    return RING_BUFFER_TEST_ERROR(KO_RESERVE);
+  }
+  rb.clear();
+  if (!rb.empty() || rb.pop(out) || out != 0) {
+    return RING_BUFFER_TEST_ERROR(KO_RESERVE);
+  }
+  return RING_BUFFER_TEST_OK(RESERVE_TAG);
+}
+
+/* Random push / pop against std::deque, wrapping many times. */
+static void fifo_test() {
+
+  ft::ring_buffer<std::string> rb(64);
+  std::deque<std::string> ref;
+
+  srand(17);
+  for (int i = 0; i < 100000; i++) {
+    if (rand() % 2) {
+      std::string value(i % 13, 'a' + i % 26);
+      bool pushed = rb.push(value);
+      if (pushed != (ref.size() < 64)) {
+        return RING_BUFFER_TEST_ERROR(KO_INSERT);
+      }
+      if (pushed) {
+        ref.push_back(value);
+      }
+    } else if (!ref.empty()) {
+      if (rb.front() != ref.front()) {
+        return RING_BUFFER_TEST_ERROR(KO_ERASE);
+      }
+      rb.pop();
+      ref.pop_front();
+    }
+    if (rb.size() != ref.size()) {
+      return RING_BUFFER_TEST_ERROR(KO_INSERT);
+    }
+  }
+  for (size_t i = 0; i < ref.size(); i++) {
+    if (rb[i] != ref[i]) {
+      return RING_BUFFER_TEST_ERROR(KO_ITERATORS);
+    }
+  }
+  return RING_BUFFER_TEST_OK(INSERT_TAG);
+}
+
+static void assignment_operator_test() {
+
+  ft::ring_buffer<std::string> a(8);
+  for (int i = 0; i < 20; i++) {
+    if (a.full()) {
+      a.pop();
+    }
+    a.push(std::string(i, 'x'));
+  }
+  ft::ring_buffer<std::string> b(a);
+  ft::ring_buffer<std::string> c(2);
+  c = a;
+  if (b.size() != 8 || c.size() != 8 || c.capacity() != 8
+      || b.front() != std::string(12, 'x') || c.back() != std::string(19, 'x'))
+  {
+    return RING_BUFFER_TEST_ERROR(KO_ASSIGNMENT);
+  }
+  c.swap(b);
+  b.pop();
+  if (b.size() != 7 || c.size() != 8) {
+    return RING_BUFFER_TEST_ERROR(KO_ASSIGNMENT);
+  }
+  return RING_BUFFER_TEST_OK(ASSIGNMENT_TAG);
+}
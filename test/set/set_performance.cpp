@@ -1,94 +1,66 @@
 #include "ft/set.hpp"
+#include "ft/counting_allocator.hpp"
 #include <set>
-#include <cmath>
-#include <string.h>
-#include "../test_utils.hpp"
+#include <string>
+#include <vector>
+#include "../bench/bench.hpp"
+#include "../bench/tree_matrix.hpp"
+#include "../bench/generators.hpp"
 #include "../test.hpp"
-
-// Timing sponge test is about right for a performance test
-void set_performance() {
-
-  std::cout << BLUE_BOLD
-            << "////////////// [ SET PERFORMANCE ] ////////////// "
-            << UNSET << std::endl;
+#include "../colors.hpp"
+#include <iostream>
 
 #define TREE_SPONGE_MAX_SIZE 10000
-  int iterations = 100;
-  int save_insertions[TREE_SPONGE_MAX_SIZE] = {0};
-
-  ft::set<int> ft_set;
-  time_t ft_start = current_timestamp();
 
-  srand(time(NULL));
+/*
+ * Sponge : state.arg() uniform keys go in, then all come out in
+ * reverse insertion order. They go in again, and come out in
+ * insertion order. The keys are drawn before the clock starts, the
+ * same ones for ft and std.
+ */
+template < typename Set >
+static void sponge( bench::state& state ) {
 
-  int insertions = 0;
-  bool invert_deletion = false; // alternates between deleting from 0 -> TREE_SPONGE_MAX_SIZE
-                                // and TREE_SPONGE_MAX_SIZE -> 0.
-  for (int i = 0; i < iterations * TREE_SPONGE_MAX_SIZE; i++) {
-    // delete all entries 
-    if (insertions == TREE_SPONGE_MAX_SIZE) {
-      if (!invert_deletion) {
-        for (int k = insertions - 1; k >= 0; k--) {
-          ft_set.erase(save_insertions[k]);
-        }
-        invert_deletion = true;
-      } else {
-        for (int k = 0; k < insertions; k++) {
-          ft_set.erase(save_insertions[k]);
-        }
-        invert_deletion = false;
-      }
-      insertions = 0;
-    }
-    int random_number = rand();
-    ft_set.insert(random_number);
-    save_insertions[insertions++] = random_number;
+  std::vector<unsigned long> keys =
+      bench::draw(bench::UNIFORM, state.arg(), 1UL << 31);
+  Set s;
+  state.start();
+  for (long i = 0; i < state.arg(); i++) {
+    s.insert(int(keys[i]));
   }
+  for (long i = state.arg() - 1; i >= 0; i--) {
+    s.erase(int(keys[i]));
+  }
+  for (long i = 0; i < state.arg(); i++) {
+    s.insert(int(keys[i]));
+  }
+  for (long i = 0; i < state.arg(); i++) {
+    s.erase(int(keys[i]));
+  }
+  state.stop(4 * state.arg());
+  bench::do_not_optimize(s.size());
+}
 
-  time_t ft_end = current_timestamp();
-  double ft_time = (double)((ft_end - ft_start)/1000.0);
-
-  memset(save_insertions, 0, sizeof(save_insertions));
+void set_performance() {
 
-  // std
-  std::set<int> std_set;
-  time_t std_start = current_timestamp();
+  std::cout << BLUE_BOLD
+            << "////////////// [ SET PERFORMANCE ] ////////////// "
+            << UNSET << std::endl;
 
-  insertions = 0;
-  invert_deletion = false;
-  for (int i = 0; i < iterations * TREE_SPONGE_MAX_SIZE; i++) {
-    // delete all entries 
-    if (insertions == TREE_SPONGE_MAX_SIZE) {
-      if (!invert_deletion) {
-        for (int k = insertions - 1; k >= 0; k--) {
-          std_set.erase(save_insertions[k]);
-        }
-        invert_deletion = true;
-      } else {
-        for (int k = 0; k < insertions; k++) {
-          std_set.erase(save_insertions[k]);
-        }
-        invert_deletion = false;
-      }
-      insertions = 0;
-    }
-    int random_number = rand();
-    std_set.insert(random_number);
-    save_insertions[insertions++] = random_number;
-  }
+  bench::header();
+  bench::row("set<int> sponge", sponge< ft::set<int> >,
+             sponge< std::set<int> >, TREE_SPONGE_MAX_SIZE);
 
-  time_t std_end = current_timestamp();
-  double std_time = (double)((std_end - std_start)/1000.0);
+  // int keys count their allocations (see bench.hpp).
+  bench::tree_matrix< ft::set<int, std::less<int>,
+                              ft::counting_allocator<int> >,
+                      std::set<int, std::less<int>,
+                               ft::counting_allocator<int> > >("set");
+  bench::tree_distributions< ft::set<int>, std::set<int> >("set");
+  bench::tree_matrix< ft::set<std::string>, std::set<std::string> >("set");
+  bench::tree_matrix< ft::set<bench::key64>, std::set<bench::key64> >("set");
 
-  std::cout << "ft time : " << ft_time << std::endl;
-  std::cout << "std time : " << std_time << std::endl;
-  std::cout << "RESULT : ft " << (fabs(std_time - ft_time)/std_time)*100.0;
-  if (ft_time < std_time) {
-    std::cout << "% faster than stl" << std::endl;
-  } else {
-    std::cout << "% slower than stl" << std::endl;
-  }
   std::cout << BLUE_BOLD
             << "////////////////////////////////////////////////"
-            << std::endl;
-}
\ No newline at end of file
+            << UNSET << std::endl;
+}
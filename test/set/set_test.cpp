@@ -1,6 +1,7 @@
 // mirror of map test. Without pairs
 #include "ft/set.hpp"
 #include <set>
+#include <string>
 #include <iostream>
 #include "../test_utils.hpp"
 #include "../test.hpp"
@@ -33,6 +34,9 @@ static void constructors_test();
 static void assignment_operator_test();
 static void reverse_iteration();
 static void range_and_bounds_test();
+#ifdef FT_CONTAINERS_CXX11
+static void move_test();
+#endif
 
 void set_test() {
   insert_no_fix();
@@ -46,6 +50,9 @@ void set_test() {
   reverse_iteration();
   assignment_operator_test();
   range_and_bounds_test();
+#ifdef FT_CONTAINERS_CXX11
+  move_test();
+#endif
 }
 
 /*
@@ -497,4 +504,42 @@ static void range_and_bounds_test() {
     return SET_TEST_ERROR(KO_RANGE);
   }
   return SET_TEST_OK(RANGE_TAG);
-}
\ No newline at end of file
+}
+
+#ifdef FT_CONTAINERS_CXX11
+static void move_test() {
+
+  ft::set<std::string> ft_set;
+  std::set<std::string> std_set;
+
+  for (int i = 0; i < 200; i++) {
+    std::string key(i % 50 + 1, 'a' + i % 26);
+    std_set.insert(key);
+    if (i % 3 == 0) {
+      ft_set.insert(std::move(key));
+    } else if (i % 3 == 1) {
+      ft_set.emplace(i % 50 + 1, 'a' + i % 26);
+    } else {
+      ft_set.emplace_hint(ft_set.begin(), key);
+    }
+  }
+  if (!Set_Equality_Check(std_set, ft_set)) {
+    return SET_TEST_ERROR(KO_MOVE);
+  }
+  ft::set<std::string> moved(std::move(ft_set));
+  if (!ft_set.empty() || !Set_Equality_Check(std_set, moved)) {
+    return SET_TEST_ERROR(KO_MOVE);
+  }
+  ft_set = std::move(moved);
+  if (!moved.empty() || !Set_Equality_Check(std_set, ft_set)) {
+    return SET_TEST_ERROR(KO_MOVE);
+  }
+  static_assert(std::is_nothrow_move_constructible<
+                  ft::set<std::string> >::value, "set move");
+  moved.insert(moved.end(), "again");
+  if (moved.size() != 1 || *moved.begin() != "again") {
+    return SET_TEST_ERROR(KO_MOVE);
+  }
+  return SET_TEST_OK(MOVE_TAG);
+}
+#endif
@@ -1,68 +1,167 @@
 #include "ft/stack.hpp"
+#include "ft/deque.hpp"
 #include "ft/utils/utils.hpp"
 #include <stack>
+#include <vector>
+#include "../bench/bench.hpp"
 #include "../test.hpp"
-#include <cmath>
 #include "../colors.hpp"
 #include <iostream>
 
-void stack_performance() {
+#define STACK_SPONGE_MAX_SIZE 100000
+#define STACK_FILL_SIZE 1000000
 
-  std::cout << BLUE_BOLD
-            << "///////////// [ STACK PERFORMANCE ] ///////////// "
-            << UNSET << std::endl;
+/* Pushes state.arg() elements, pops them all, twice. */
+template < typename Stack >
+static void sponge( bench::state& state ) {
 
-  int iterations = 100;
-#define STACK_SPONGE_MAX_SIZE 100000
+  Stack s;
+  state.start();
+  for (int round = 0; round < 2; round++) {
+    for (long i = 0; i < state.arg(); i++) {
+      s.push(42);
+    }
+    for (long i = 0; i < state.arg(); i++) {
+      s.pop();
+    }
+  }
+  state.stop(4 * state.arg());
+  bench::do_not_optimize(s.size());
+}
 
-  int insertions = 0;
+/*
+ * A fresh stack is filled to state.arg() and drained, so growth
+ * happens on every sample.
+ */
+template < typename Stack >
+static void fill_and_drain( bench::state& state ) {
 
-  ft::stack<int> ft_stack;
-  time_t ft_start = current_timestamp();
+  state.start();
+  Stack s;
+  for (long i = 0; i < state.arg(); i++) {
+    s.push(int(i));
+  }
+  while (!s.empty()) {
+    s.pop();
+  }
+  state.stop(2 * state.arg());
+}
 
-  for (int i = 0; i < iterations * STACK_SPONGE_MAX_SIZE; i++) {
-    // delete all entries 
-    if (insertions == STACK_SPONGE_MAX_SIZE) {
-      for (int k = 0; k < insertions; k++) {
-        ft_stack.pop();
-      }
-      insertions = 0;
+/*
+ * The slowest single push while filling a fresh stack to
+ * STACK_FILL_SIZE : for a vector backed stack it is the push that
+ * copies the whole stack. Not a sample statistic, so timed here.
+ */
+template < typename Stack >
+static uint64_t worst_push_ns() {
+
+  Stack s;
+  uint64_t worst = 0;
+  for (int i = 0; i < STACK_FILL_SIZE; i++) {
+    uint64_t start = bench::now_ns();
+    s.push(i);
+    uint64_t elapsed = bench::now_ns() - start;
+    if (elapsed > worst) {
+      worst = elapsed;
     }
-    ft_stack.push(42);
   }
+  return worst;
+}
 
-  time_t ft_end = current_timestamp();
-  double ft_time = (double)((ft_end - ft_start)/1000.0);
+/*
+ * ft::stack over ft::deque against ft::stack over ft::vector (the
+ * default) and std::stack (over std::deque).
+ */
+static void container_performance() {
 
-  ////////////////// STD ///////////////////////////
-  insertions = 0;
+  std::cout << BLUE_BOLD
+            << "///////// [ STACK CONTAINER PERFORMANCE ] //////// "
+            << UNSET << std::endl;
 
-  std::stack<int> std_stack;
-  time_t std_start = current_timestamp();
+  bench::header("ft", "std::stack");
+  bench::row("deque stack fill / drain",
+             fill_and_drain< ft::stack<int, ft::deque<int> > >,
+             fill_and_drain< std::stack<int> >, STACK_FILL_SIZE);
+  bench::row("vector stack fill / drain", fill_and_drain< ft::stack<int> >,
+             fill_and_drain< std::stack<int> >, STACK_FILL_SIZE);
 
-  for (int i = 0; i < iterations * STACK_SPONGE_MAX_SIZE; i++) {
-    // delete all entries 
-    if (insertions == STACK_SPONGE_MAX_SIZE) {
-      for (int k = 0; k < insertions; k++) {
-        std_stack.pop();
-      }
-      insertions = 0;
-    }
-    std_stack.push(42);
+  if (bench::selected("stack worst push")) {
+    std::cout << "worst push (ns) : ft deque stack "
+              << worst_push_ns< ft::stack<int, ft::deque<int> > >()
+              << ", ft vector stack " << worst_push_ns< ft::stack<int> >()
+              << ", std stack " << worst_push_ns< std::stack<int> >()
+              << std::endl;
+  }
+  std::cout << BLUE_BOLD
+            << "/////////////////////////////////////////////////"
+            << UNSET << std::endl;
+}
+
+#define BULK_BATCH 1000
+#define BULK_STEPS 2000
+
+/*
+ * DFS-like : every step pushes a batch of BULK_BATCH children and
+ * pops most of them. ft::stack uses push_range / pop_n, std::stack
+ * can only loop over push / pop.
+ */
+static void bulk_ft( bench::state& state ) {
+
+  std::vector<int> batch(BULK_BATCH, 7);
+  ft::stack<int> s;
+  state.start();
+  for (long step = 0; step < state.arg(); step++) {
+    s.push_range(batch.begin(), batch.end());
+    s.pop_n(BULK_BATCH - 1);
   }
+  state.stop(state.arg());
+  bench::do_not_optimize(s.top());
+}
 
-  time_t std_end = current_timestamp();
-  double std_time = (double)((std_end - std_start)/1000.0);
+static void bulk_std( bench::state& state ) {
 
-  std::cout << "ft time : " << ft_time << std::endl;
-  std::cout << "std time : " << std_time << std::endl;
-  std::cout << "RESULT : ft " << (fabs(std_time - ft_time)/std_time)*100.0;
-  if (ft_time < std_time) {
-    std::cout << "% faster than stl" << std::endl;
-  } else {
-    std::cout << "% slower than stl" << std::endl;
+  std::vector<int> batch(BULK_BATCH, 7);
+  std::stack<int, std::vector<int> > s;
+  state.start();
+  for (long step = 0; step < state.arg(); step++) {
+    for (size_t i = 0; i < batch.size(); i++) {
+      s.push(batch[i]);
+    }
+    for (int i = 0; i < BULK_BATCH - 1; i++) {
+      s.pop();
+    }
   }
+  state.stop(state.arg());
+  bench::do_not_optimize(s.top());
+}
+
+static void bulk_performance() {
+
+  std::cout << BLUE_BOLD
+            << "/////////// [ STACK BULK PERFORMANCE ] ////////// "
+            << UNSET << std::endl;
+
+  bench::header("ft push_range / pop_n", "std push / pop loop");
+  bench::row("batch of 1000 (per batch)", bulk_ft, bulk_std, BULK_STEPS);
+
   std::cout << BLUE_BOLD
             << "/////////////////////////////////////////////////"
-            << std::endl;
-}
\ No newline at end of file
+            << UNSET << std::endl;
+}
+
+void stack_performance() {
+
+  std::cout << BLUE_BOLD
+            << "///////////// [ STACK PERFORMANCE ] ///////////// "
+            << UNSET << std::endl;
+
+  bench::header();
+  bench::row("stack<int> sponge", sponge< ft::stack<int> >,
+             sponge< std::stack<int> >, STACK_SPONGE_MAX_SIZE);
+
+  std::cout << BLUE_BOLD
+            << "/////////////////////////////////////////////////"
+            << UNSET << std::endl;
+  container_performance();
+  bulk_performance();
+}
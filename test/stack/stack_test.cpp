@@ -1,6 +1,9 @@
 #include "ft/stack.hpp"
+#include "ft/deque.hpp"
 #include "ft/utils/utils.hpp"
 #include <stack>
+#include <string>
+#include <vector>
 #include "../test_utils.hpp"
 
 // operator == would not work with ft vector and std one. This does,
@@ -32,11 +35,21 @@ inline bool Stack_Equality_Check(std::stack<T> u, ft::stack<T> v) {
 static void constructor_test();
 static void assignment_operator_test();
 static void frog_on_well();
+static void shrink_test();
+static void bulk_test();
+#ifdef FT_CONTAINERS_CXX11
+static void move_test();
+#endif
 
 void stack_test() {
   constructor_test();
   assignment_operator_test();
   frog_on_well();
+  shrink_test();
+  bulk_test();
+#ifdef FT_CONTAINERS_CXX11
+  move_test();
+#endif
 }
 
 static void constructor_test() {
@@ -109,4 +122,124 @@ static void frog_on_well() {
     return STACK_TEST_ERROR(KO_FROG);
   }
   return STACK_TEST_OK(FROG_ON_WELL);
-}
\ No newline at end of file
+}
+// A stack backed by a vector gives memory back after a burst.
+static void shrink_test() {
+  ft::stack<int> ft_stack;
+  std::stack<int> std_stack;
+
+  for (int i = 0; i < 10000; i++) {
+    ft_stack.push(i);
+    std_stack.push(i);
+  }
+  for (int i = 0; i < 9990; i++) {
+    ft_stack.pop();
+    std_stack.pop();
+  }
+  ft_stack.shrink_to_fit();
+  if (!Stack_Equality_Check(std_stack, ft_stack)) {
+    return STACK_TEST_ERROR(KO_SHRINK);
+  }
+  ft_stack.set_auto_shrink(true);
+  for (int i = 0; i < 10000; i++) {
+    ft_stack.push(i);
+    std_stack.push(i);
+  }
+  for (int i = 0; i < 10000; i++) {
+    ft_stack.pop();
+    std_stack.pop();
+  }
+  if (!Stack_Equality_Check(std_stack, ft_stack)) {
+    return STACK_TEST_ERROR(KO_SHRINK);
+  }
+  return STACK_TEST_OK(SHRINK_TAG);
+}
+
+// push_range / pop_n / pop_into against a push / pop loop.
+template <typename Stack>
+static bool bulk_round() {
+
+  Stack ft_stack;
+  std::stack<std::string> std_stack;
+  std::vector<std::string> batch;
+
+  for (int round = 0; round < 50; round++) {
+    batch.clear();
+    for (int i = 0; i < round * 7; i++) {
+      batch.push_back(std::string(i % 20, 'a' + round % 26));
+    }
+    ft_stack.push_range(batch.begin(), batch.end());
+    for (size_t i = 0; i < batch.size(); i++) {
+      std_stack.push(batch[i]);
+    }
+    size_t count = std_stack.size() / 3;
+    ft_stack.pop_n(count);
+    for (size_t i = 0; i < count; i++) {
+      std_stack.pop();
+    }
+    if (!std_stack.empty()) {
+      std::string top;
+      ft_stack.pop_into(top);
+      if (top != std_stack.top()) {
+        return false;
+      }
+      std_stack.pop();
+    }
+    if (ft_stack.size() != std_stack.size()
+        || (!std_stack.empty() && ft_stack.top() != std_stack.top()))
+    {
+      return false;
+    }
+  }
+  ft_stack.pop_n(0);
+  ft_stack.pop_n(ft_stack.size());
+  return ft_stack.empty();
+}
+
+static void bulk_test() {
+
+  ft::stack<int> reserved;
+  reserved.reserve(1000);
+  int values[] = { 1, 2, 3 };
+  reserved.push_range(values, values + 3);
+  reserved.reserve(0);  // only a hint, never shrinks
+  if (reserved.size() != 3 || reserved.top() != 3) {
+    return STACK_TEST_ERROR(KO_APPEND);
+  }
+  if (!bulk_round< ft::stack<std::string> >()
+      || !bulk_round< ft::stack<std::string, ft::deque<std::string> > >())
+  {
+    return STACK_TEST_ERROR(KO_APPEND);
+  }
+  return STACK_TEST_OK(APPEND_TAG);
+}
+
+#ifdef FT_CONTAINERS_CXX11
+static void move_test() {
+
+  ft::stack<std::string> ft_stack;
+  std::stack<std::string> std_stack;
+
+  for (int i = 0; i < 100; i++) {
+    std::string value(i, 'a');
+    std_stack.push(value);
+    if (i % 2) {
+      ft_stack.push(std::move(value));
+    } else {
+      ft_stack.emplace(i, 'a');
+    }
+  }
+  if (!Stack_Equality_Check(std_stack, ft_stack)) {
+    return STACK_TEST_ERROR(KO_MOVE);
+  }
+  ft::stack<std::string> moved(std::move(ft_stack));
+  if (!ft_stack.empty() || !Stack_Equality_Check(std_stack, moved)) {
+    return STACK_TEST_ERROR(KO_MOVE);
+  }
+  ft_stack = std::move(moved);
+  if (!moved.empty() || !Stack_Equality_Check(std_stack, ft_stack)) {
+    return STACK_TEST_ERROR(KO_MOVE);
+  }
+  return STACK_TEST_OK(MOVE_TAG);
+}
+#endif
@@ -1,19 +1,32 @@
 #ifndef CONTAINERS_TEST_HPP
 # define CONTAINERS_TEST_HPP
 
-long current_timestamp();
 void LoadErrorMap();
 
 void vector_test();
 void vector_performance();
 
+void deque_test();
+
 void stack_test();
 void stack_performance();
 
+void queue_test();
+void queue_performance();
+
+void ring_buffer_test();
+void ring_buffer_performance();
+
+void concurrent_test();
+void concurrent_performance();
+
 void map_test();
 void map_performance();
 
 void set_test();
 void set_performance();
 
+void algorithm_test();
+void algorithm_performance();
+
 #endif /* CONTAINERS_TEST_HPP */
\ No newline at end of file
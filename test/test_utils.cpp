@@ -1,13 +1,5 @@
 #include "test_utils.hpp"
 #include <utility>
-#include <sys/time.h>
-
-long current_timestamp() {
-    struct timeval te; 
-    gettimeofday(&te, NULL);
-    long milliseconds = te.tv_sec*1000L + te.tv_usec/1000;
-    return milliseconds;
-}
 
 #define PAIR_INT_STRING(a, b) \
         std::pair<int, std::string>(a, b)
@@ -22,4 +14,24 @@ void LoadErrorMap() {
   error_map.insert(PAIR_INT_STRING(KO_FROG, FROG_ON_WELL));
   error_map.insert(PAIR_INT_STRING(KO_RESERVE, RESERVE_TAG));
   error_map.insert(PAIR_INT_STRING(KO_RANGE, RANGE_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_BITSET, BITSET_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_SHRINK, SHRINK_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_RESIZE, RESIZE_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_APPEND, APPEND_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_ERASE_IF, ERASE_IF_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_MOVE, MOVE_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_HEAP, HEAP_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_THREADS, THREADS_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_COMPARE, COMPARE_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_FIND, FIND_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_FILL, FILL_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_COPY, COPY_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_MIN_MAX, MIN_MAX_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_ACCUMULATE, ACCUMULATE_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_SORT, SORT_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_STABLE_SORT, STABLE_SORT_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_RADIX_SORT, RADIX_SORT_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_PARALLEL_SORT, PARALLEL_SORT_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_SIZEOF, SIZEOF_TAG));
+  error_map.insert(PAIR_INT_STRING(KO_ALLOCATION, ALLOCATION_TAG));
 }
\ No newline at end of file
@@ -11,6 +11,13 @@
 #define STACK_TAG "STACK"
 #define MAP_TAG "MAP"
 #define SET_TAG "SET"
+#define DEQUE_TAG "DEQUE"
+#define QUEUE_TAG "QUEUE"
+#define PRIORITY_QUEUE_TAG "PRIORITY_QUEUE"
+#define RING_BUFFER_TAG "RING_BUFFER"
+#define CONCURRENT_STACK_TAG "CONCURRENT_STACK"
+#define MPMC_QUEUE_TAG "MPMC_QUEUE"
+#define ALGORITHM_TAG "ALGORITHM"
 
 #define CONSTRUCTOR_TAG "CONSTRUCTOR"
 #define ITERATOR_TAG "ITERATOR"
@@ -21,6 +28,26 @@
 #define INSERT_TAG "INSERT"
 #define ERASE_TAG "ERASE"
 #define RANGE_TAG "RANGE"
+#define BITSET_TAG "VECTOR<BOOL>"
+#define SHRINK_TAG "SHRINK"
+#define RESIZE_TAG "RESIZE"
+#define APPEND_TAG "APPEND"
+#define ERASE_IF_TAG "ERASE_IF"
+#define MOVE_TAG "MOVE"
+#define HEAP_TAG "HEAP"
+#define THREADS_TAG "THREADS"
+#define COMPARE_TAG "COMPARE"
+#define FIND_TAG "FIND"
+#define FILL_TAG "FILL"
+#define COPY_TAG "COPY"
+#define MIN_MAX_TAG "MIN_MAX"
+#define ACCUMULATE_TAG "ACCUMULATE"
+#define SORT_TAG "SORT"
+#define STABLE_SORT_TAG "STABLE_SORT"
+#define RADIX_SORT_TAG "RADIX_SORT"
+#define PARALLEL_SORT_TAG "PARALLEL_SORT"
+#define SIZEOF_TAG "SIZEOF"
+#define ALLOCATION_TAG "ALLOCATION"
 
 extern std::map<int, std::string> error_map;
 
@@ -34,7 +61,27 @@ typedef enum {
   KO_ASSIGN,
   KO_FROG,
   KO_RESERVE,
-  KO_RANGE
+  KO_RANGE,
+  KO_BITSET,
+  KO_SHRINK,
+  KO_RESIZE,
+  KO_APPEND,
+  KO_ERASE_IF,
+  KO_MOVE,
+  KO_HEAP,
+  KO_THREADS,
+  KO_COMPARE,
+  KO_FIND,
+  KO_FILL,
+  KO_COPY,
+  KO_MIN_MAX,
+  KO_ACCUMULATE,
+  KO_SORT,
+  KO_STABLE_SORT,
+  KO_RADIX_SORT,
+  KO_PARALLEL_SORT,
+  KO_SIZEOF,
+  KO_ALLOCATION
 } TEST_RESULT;
 
 // why static:
@@ -65,6 +112,41 @@ static inline void printTestOk(const char* tag, const char* container) {
 #define STACK_TEST_OK(test_tag) \
         printTestOk(test_tag, STACK_TAG);
 
+#define DEQUE_TEST_ERROR(result) \
+        printTestError(result, DEQUE_TAG, __LINE__, __FILE__);
+#define DEQUE_TEST_OK(test_tag) \
+        printTestOk(test_tag, DEQUE_TAG);
+
+#define QUEUE_TEST_ERROR(result) \
+        printTestError(result, QUEUE_TAG, __LINE__, __FILE__);
+#define QUEUE_TEST_OK(test_tag) \
+        printTestOk(test_tag, QUEUE_TAG);
+
+#define PRIORITY_QUEUE_TEST_ERROR(result) \
+        printTestError(result, PRIORITY_QUEUE_TAG, __LINE__, __FILE__);
+#define PRIORITY_QUEUE_TEST_OK(test_tag) \
+        printTestOk(test_tag, PRIORITY_QUEUE_TAG);
+
+#define RING_BUFFER_TEST_ERROR(result) \
+        printTestError(result, RING_BUFFER_TAG, __LINE__, __FILE__);
+#define RING_BUFFER_TEST_OK(test_tag) \
+        printTestOk(test_tag, RING_BUFFER_TAG);
+
+#define CONCURRENT_STACK_TEST_ERROR(result) \
+        printTestError(result, CONCURRENT_STACK_TAG, __LINE__, __FILE__);
+#define CONCURRENT_STACK_TEST_OK(test_tag) \
+        printTestOk(test_tag, CONCURRENT_STACK_TAG);
+
+#define MPMC_QUEUE_TEST_ERROR(result) \
+        printTestError(result, MPMC_QUEUE_TAG, __LINE__, __FILE__);
+#define MPMC_QUEUE_TEST_OK(test_tag) \
+        printTestOk(test_tag, MPMC_QUEUE_TAG);
+
+#define ALGORITHM_TEST_ERROR(result) \
+        printTestError(result, ALGORITHM_TAG, __LINE__, __FILE__);
+#define ALGORITHM_TEST_OK(test_tag) \
+        printTestOk(test_tag, ALGORITHM_TAG);
+
 #define MAP_TEST_ERROR(result) \
         printTestError(result, MAP_TAG, __LINE__, __FILE__);
 #define MAP_TEST_OK(test_tag) \
@@ -1,85 +1,314 @@
 #include "ft/vector.hpp"
+#include "ft/counting_allocator.hpp"
 #include "ft/utils/utils.hpp"
 #include <vector>
+#include "../bench/bench.hpp"
+#include "../bench/generators.hpp"
 #include "../test.hpp"
-#include <cmath>
 #include "../colors.hpp"
 #include <iostream>
 
-void vector_performance() {
+#define VECTOR_SPONGE_MAX_SIZE 10000
+
+/*
+ * Sponge : state.arg() push_backs, then as many erases from the
+ * front. Filled again, then emptied from the middle.
+ */
+template < typename Vector >
+static void sponge( bench::state& state ) {
+
+  Vector v;
+  state.start();
+  for (long i = 0; i < state.arg(); i++) {
+    v.push_back(42);
+  }
+  for (long i = 0; i < state.arg(); i++) {
+    v.erase(v.begin());
+  }
+  for (long i = 0; i < state.arg(); i++) {
+    v.push_back(42);
+  }
+  for (long i = 0; i < state.arg(); i++) {
+    v.erase(v.begin() + (v.size() / 2));
+  }
+  state.stop(4 * state.arg());
+  bench::do_not_optimize(v.size());
+}
+
+#define VECTOR_BATCH_SIZE 1024
+#define VECTOR_BATCHES 256
+
+/*
+ * Batched ingestion : a fresh vector fed state.arg() batches of
+ * VECTOR_BATCH_SIZE ints, with a push_back loop (one capacity check
+ * per element) and with append (one capacity check and one memcpy
+ * per batch). std::vector::insert(end(), ...) is the std reference
+ * for append. One operation is one batch. The vectors count their
+ * allocations : growth is the same for all three.
+ */
+static const std::vector<int>& batch() {
+  static std::vector<int> values;
+  if (values.empty()) {
+    for (int i = 0; i < VECTOR_BATCH_SIZE; i++) {
+      values.push_back(i);
+    }
+  }
+  return values;
+}
+
+static void push_back_loop( bench::state& state ) {
+
+  const int* values = &batch()[0];
+  state.start();
+  ft::vector< int, ft::counting_allocator<int> > v;
+  for (long b = 0; b < state.arg(); b++) {
+    for (int i = 0; i < VECTOR_BATCH_SIZE; i++) {
+      v.push_back(values[i]);
+    }
+  }
+  state.stop(state.arg());
+  bench::do_not_optimize(v.back());
+}
+
+static void ft_append( bench::state& state ) {
+
+  const int* values = &batch()[0];
+  state.start();
+  ft::vector< int, ft::counting_allocator<int> > v;
+  for (long b = 0; b < state.arg(); b++) {
+    v.append(values, VECTOR_BATCH_SIZE);
+  }
+  state.stop(state.arg());
+  bench::do_not_optimize(v.back());
+}
+
+static void std_insert_end( bench::state& state ) {
+
+  const int* values = &batch()[0];
+  state.start();
+  std::vector< int, ft::counting_allocator<int> > v;
+  for (long b = 0; b < state.arg(); b++) {
+    v.insert(v.end(), values, values + VECTOR_BATCH_SIZE);
+  }
+  state.stop(state.arg());
+  bench::do_not_optimize(v.back());
+}
+
+static void append_performance() {
 
   std::cout << BLUE_BOLD
-            << "//////////// [ VECTOR PERFORMANCE ] //////////// "
+            << "///////// [ VECTOR APPEND PERFORMANCE ] ///////// "
             << UNSET << std::endl;
 
-  int iterations = 100;
-#define VECTOR_SPONGE_MAX_SIZE 100000
-
-  int insertions = 0;
-  bool invert_deletion = false;
-
-  ft::vector<int> ft_vec;
-  time_t ft_start = current_timestamp();
-
-  for (int i = 0; i < iterations * VECTOR_SPONGE_MAX_SIZE; i++) {
-    // delete all entries 
-    if (insertions == VECTOR_SPONGE_MAX_SIZE) {
-      if (!invert_deletion) {
-        for (int k = insertions - 1; k >= 0; k--) {
-          ft_vec.erase(ft_vec.begin());
-        }
-        invert_deletion = true;
-      } else {
-        for (int k = 0; k < insertions; k++) {
-          ft_vec.erase(ft_vec.begin() + (ft_vec.size() / 2));
-        }
-        invert_deletion = false;
-      }
-      insertions = 0;
-    }
-    ft_vec.push_back(42);
-  }
-
-  time_t ft_end = current_timestamp();
-  double ft_time = (double)((ft_end - ft_start)/1000.0);
-
-  ////////////////// STD ///////////////////////////
-  insertions = 0;
-
-  std::vector<int> std_vec;
-  time_t std_start = current_timestamp();
-
-  for (int i = 0; i < iterations * VECTOR_SPONGE_MAX_SIZE; i++) {
-    // delete all entries 
-    if (insertions == VECTOR_SPONGE_MAX_SIZE) {
-      if (!invert_deletion) {
-        for (int k = insertions - 1; k >= 0; k--) {
-          std_vec.erase(std_vec.begin());
-        }
-        invert_deletion = true;
-      } else {
-        for (int k = 0; k < insertions; k++) {
-          std_vec.erase(std_vec.begin() + (std_vec.size() / 2));
-        }
-        invert_deletion = false;
-      }
-      insertions = 0;
+  bench::header("ft append", "ft push_back loop");
+  bench::row("append 1024 ints vs push_back", ft_append, push_back_loop,
+             VECTOR_BATCHES);
+  bench::header("ft append", "std insert(end)");
+  bench::row("append 1024 ints vs insert", ft_append, std_insert_end,
+             VECTOR_BATCHES);
+
+  std::cout << BLUE_BOLD
+            << "/////////////////////////////////////////////////"
+            << UNSET << std::endl;
+}
+
+#define COMPARE_BYTES (1L << 23)
+
+/*
+ * Compares two vectors of state.arg() elements, enough times to go
+ * through COMPARE_BYTES bytes. For == the two are equal (a full
+ * scan), for < they differ in the last element. One operation is one
+ * compare.
+ */
+template < typename Vector, bool Less >
+static void compare( bench::state& state ) {
+
+  typedef typename Vector::value_type T;
+  Vector a(state.arg(), T(7));
+  Vector b(state.arg() - 1, T(7));
+  b.push_back(Less ? T(9) : T(7));
+  long repeat = COMPARE_BYTES / (state.arg() * sizeof(T));
+  long hits = 0;
+  state.start();
+  for (long r = 0; r < repeat; r++) {
+    hits += Less ? (a < b) : (a == b);
+    bench::clobber_memory();
+  }
+  state.stop(repeat);
+  bench::do_not_optimize(hits);
+}
+
+/* The element by element loop ft::vector used before. */
+template < typename T, bool Less >
+static void compare_loop( bench::state& state ) {
+
+  ft::vector<T> a(state.arg(), T(7));
+  ft::vector<T> b(a);
+  b.back() = Less ? T(9) : T(7);
+  long repeat = COMPARE_BYTES / (state.arg() * sizeof(T));
+  long hits = 0;
+  state.start();
+  for (long r = 0; r < repeat; r++) {
+    hits += Less ? ft::lexicographical_compare_dispatch(a.begin(), a.end(),
+                                                        b.begin(), b.end(),
+                                                        ft::false_type())
+                 : ft::equal_dispatch(a.begin(), a.end(), b.begin(),
+                                      ft::false_type());
+    bench::clobber_memory();
+  }
+  state.stop(repeat);
+  bench::do_not_optimize(hits);
+}
+
+template < typename T >
+static void compare_table( const std::string& type ) {
+
+  static const long sizes[] = { 16, 256, 4096, 1048576 };
+  const long count = sizeof(sizes) / sizeof(sizes[0]);
+
+  bench::header("ft (bytewise)", "std");
+  for (long i = 0; i < count; i++) {
+    bench::row(bench::with_arg(type + " ==", sizes[i]),
+               compare< ft::vector<T>, false >,
+               compare< std::vector<T>, false >, sizes[i]);
+    bench::row(bench::with_arg(type + " < ", sizes[i]),
+               compare< ft::vector<T>, true >,
+               compare< std::vector<T>, true >, sizes[i]);
+  }
+  bench::header("ft (bytewise)", "element loop");
+  for (long i = 0; i < count; i++) {
+    bench::row(bench::with_arg(type + " == vs loop", sizes[i]),
+               compare< ft::vector<T>, false >,
+               compare_loop<T, false>, sizes[i]);
+    bench::row(bench::with_arg(type + " <  vs loop", sizes[i]),
+               compare< ft::vector<T>, true >,
+               compare_loop<T, true>, sizes[i]);
+  }
+}
+
+/*
+ * operator== / operator< on integer vectors go through memcmp and the
+ * SIMD mismatch kernel (utils/simd.hpp).
+ */
+static void compare_performance() {
+
+  std::cout << BLUE_BOLD
+            << "//////// [ VECTOR COMPARE PERFORMANCE ] ///////// "
+            << UNSET << std::endl;
+
+  compare_table<unsigned char>("vector<uchar>");
+  compare_table<int>("vector<int>");
+
+  std::cout << BLUE_BOLD
+            << "/////////////////////////////////////////////////"
+            << UNSET << std::endl;
+}
+
+#define VECTOR_READ_SIZE (1 << 20)
+#define VECTOR_SORTED_SIZE 10000
+
+/*
+ * Reads : VECTOR_READ_SIZE ints, read at state.arg() positions drawn
+ * from D. Sequential is a prefetched stream, uniform a cache miss per
+ * read at this size, the others in between.
+ */
+template < typename Vector, bench::distribution D >
+static void read_drawn( bench::state& state ) {
+
+  Vector v(VECTOR_READ_SIZE);
+  for (long i = 0; i < VECTOR_READ_SIZE; i++) {
+    v[i] = int(i);
+  }
+  std::vector<unsigned long> at = bench::draw(D, state.arg(),
+                                              VECTOR_READ_SIZE);
+  long sum = 0;
+  state.start();
+  for (long i = 0; i < state.arg(); i++) {
+    sum += v[at[i]];
+  }
+  state.stop(state.arg());
+  bench::do_not_optimize(sum);
+}
+
+/*
+ * A sorted vector built by inserting state.arg() keys drawn from D,
+ * each where lower_bound puts it : sequential keys append, reverse
+ * keys shift everything, the others land in between.
+ */
+template < typename Vector >
+static size_t lower_bound_index( const Vector& v, int key ) {
+  size_t low = 0;
+  size_t high = v.size();
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    if (v[middle] < key) {
+      low = middle + 1;
+    } else {
+      high = middle;
     }
-    std_vec.push_back(42);
   }
+  return low;
+}
 
-  time_t std_end = current_timestamp();
-  double std_time = (double)((std_end - std_start)/1000.0);
+template < typename Vector, bench::distribution D >
+static void sorted_insert_drawn( bench::state& state ) {
 
-  std::cout << "ft time : " << ft_time << std::endl;
-  std::cout << "std time : " << std_time << std::endl;
-  std::cout << "RESULT : ft " << (fabs(std_time - ft_time)/std_time)*100.0;
-  if (ft_time < std_time) {
-    std::cout << "% faster than stl" << std::endl;
-  } else {
-    std::cout << "% slower than stl" << std::endl;
+  std::vector<unsigned long> keys = bench::draw(D, state.arg(), state.arg());
+  Vector v;
+  v.reserve(state.arg());
+  state.start();
+  for (long i = 0; i < state.arg(); i++) {
+    int key = int(keys[i]);
+    v.insert(v.begin() + lower_bound_index(v, key), key);
   }
+  state.stop(state.arg());
+  bench::do_not_optimize(v.back());
+}
+
+template < bench::distribution D >
+static void distribution_rows() {
+  const std::string name = bench::distribution_name(D);
+  bench::row("read " + name, read_drawn< ft::vector<int>, D >,
+             read_drawn< std::vector<int>, D >, VECTOR_READ_SIZE);
+  bench::row("sorted insert " + name,
+             sorted_insert_drawn< ft::vector<int>, D >,
+             sorted_insert_drawn< std::vector<int>, D >, VECTOR_SORTED_SIZE);
+}
+
+static void distribution_performance() {
+
+  std::cout << BLUE_BOLD
+            << "////// [ VECTOR DISTRIBUTION PERFORMANCE ] ////// "
+            << UNSET << std::endl;
+
+  bench::header();
+  distribution_rows<bench::SEQUENTIAL>();
+  distribution_rows<bench::REVERSE>();
+  distribution_rows<bench::UNIFORM>();
+  distribution_rows<bench::ZIPF>();
+  distribution_rows<bench::HOTSPOT>();
+  distribution_rows<bench::SLIDING_WINDOW>();
+
+  std::cout << BLUE_BOLD
+            << "/////////////////////////////////////////////////"
+            << UNSET << std::endl;
+}
+
+void vector_performance() {
+
+  std::cout << BLUE_BOLD
+            << "//////////// [ VECTOR PERFORMANCE ] //////////// "
+            << UNSET << std::endl;
+
+  bench::header();
+  bench::row("vector<int> sponge", sponge< ft::vector<int> >,
+             sponge< std::vector<int> >, VECTOR_SPONGE_MAX_SIZE);
+
   std::cout << BLUE_BOLD
             << "/////////////////////////////////////////////////"
-            << std::endl;
-}
\ No newline at end of file
+            << UNSET << std::endl;
+
+  append_performance();
+  compare_performance();
+  distribution_performance();
+}
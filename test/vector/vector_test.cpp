@@ -1,6 +1,14 @@
 #include "ft/vector.hpp"
 #include "ft/utils/utils.hpp"
+#include "ft/utils/simd.hpp"
+#include "ft/counting_allocator.hpp"
 #include <vector>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <sstream>
+#include <iterator>
 #include "../test_utils.hpp"
 
 static void constructors_test();
@@ -14,6 +22,17 @@ static void insert_range_value_test();
 static void insert_range_iterators_test();
 static void erase_range_test();
 static void erase_pos_test();
+static void vector_bool_test();
+static void shrink_test();
+static void default_init_test();
+static void append_test();
+static void erase_if_test();
+static void copy_reuse_test();
+static void compare_test();
+static void allocation_test();
+#ifdef FT_CONTAINERS_CXX11
+static void move_test();
+#endif
 
 void vector_test() {
   constructors_test();
@@ -27,6 +46,17 @@ void vector_test() {
   insert_range_iterators_test();
   erase_range_test();
   erase_pos_test();
+  vector_bool_test();
+  shrink_test();
+  default_init_test();
+  append_test();
+  erase_if_test();
+  copy_reuse_test();
+  compare_test();
+  allocation_test();
+#ifdef FT_CONTAINERS_CXX11
+  move_test();
+#endif
 }
 
 // operator == would not work with ft vector and std one. This does,
@@ -408,4 +438,744 @@ static void erase_pos_test() {
     }
   }
   return VECTOR_TEST_OK(ERASE_TAG);
-}
\ No newline at end of file
+}
+
+template <typename Alloc1, typename Alloc2>
+inline bool Bitset_Equality_Check(const std::vector<bool, Alloc1>& u,
+                                  const ft::vector<bool, Alloc2>& v)
+{
+  if (u.size() != v.size()) {
+    return ft::show_diff(u.size(), v.size());
+  }
+  for (size_t i = 0; i < u.size(); i++) {
+    if (u[i] != v[i]) {
+      return ft::show_diff(u[i], v[i]);
+    }
+  }
+  return true;
+}
+
+/*
+ * Packed vector<bool> against std::vector<bool>, with sizes
+ * crossing word boundaries (63, 64, 65 ...), plus the bitmap
+ * helpers against a naive count / scan.
+ */
+static void vector_bool_test() {
+// push_back, pop_back, insert, erase, resize
+{
+  ft::vector<bool> ft_v;
+  std::vector<bool> std_v;
+
+  for (int i = 0; i < 300; i++) {
+    ft_v.push_back(i % 3 == 0);
+    std_v.push_back(i % 3 == 0);
+  }
+  for (int i = 0; i < 10; i++) {
+    ft_v.pop_back();
+    std_v.pop_back();
+  }
+  ft_v.insert(ft_v.begin() + 60, 7, true);
+  std_v.insert(std_v.begin() + 60, 7, true);
+  ft_v.insert(ft_v.begin() + 3, false);
+  std_v.insert(std_v.begin() + 3, false);
+  ft_v.erase(ft_v.begin() + 5, ft_v.begin() + 130);
+  std_v.erase(std_v.begin() + 5, std_v.begin() + 130);
+  ft_v.erase(ft_v.begin());
+  std_v.erase(std_v.begin());
+  ft_v.resize(200, true);
+  std_v.resize(200, true);
+  ft_v[64] = false;
+  std_v[64] = false;
+  ft_v[65] = ft_v[0];
+  std_v[65] = std_v[0];
+  ft_v.resize(129);
+  std_v.resize(129);
+
+  if (!Bitset_Equality_Check(std_v, ft_v)) {
+    return VECTOR_TEST_ERROR(KO_BITSET);
+  }
+  ft::vector<bool> ft_copy(ft_v);
+  if (!(ft_copy == ft_v) || !Bitset_Equality_Check(std_v, ft_copy)) {
+    return VECTOR_TEST_ERROR(KO_BITSET);
+  }
+  ft::vector<bool>::const_reverse_iterator rit = ft_v.rbegin();
+  std::vector<bool>::const_reverse_iterator std_rit = std_v.rbegin();
+  for (; std_rit != std_v.rend(); ++rit, ++std_rit) {
+    if (*rit != *std_rit) {
+      return VECTOR_TEST_ERROR(KO_BITSET);
+    }
+  }
+}
+// count, find_first / find_next, flip and bulk operations
+{
+  for (int size = 0; size < 200; size += 7) {
+    ft::vector<bool> a(size, false);
+    ft::vector<bool> b(size, true);
+    for (int i = 0; i < size; i++) {
+      a[i] = (i * 7) % 5 == 0;
+    }
+    size_t expected = 0;
+    for (int i = 0; i < size; i++) {
+      expected += a[i];
+    }
+    if (a.count() != expected || b.count() != (size_t)size) {
+      return VECTOR_TEST_ERROR(KO_BITSET);
+    }
+    size_t found = 0;
+    size_t last = ft::vector<bool>::npos;
+    for (size_t pos = a.find_first(); pos != ft::vector<bool>::npos;
+         pos = a.find_next(pos))
+    {
+      if (!a[pos] || (last != ft::vector<bool>::npos && pos <= last)) {
+        return VECTOR_TEST_ERROR(KO_BITSET);
+      }
+      last = pos;
+      ++found;
+    }
+    if (found != expected) {
+      return VECTOR_TEST_ERROR(KO_BITSET);
+    }
+    ft::vector<bool> c(a);
+    c.flip();
+    if (c.count() != size - expected
+        || (a & c).count() != 0
+        || (a | c).count() != (size_t)size
+        || (a ^ b) != c)
+    {
+      return VECTOR_TEST_ERROR(KO_BITSET);
+    }
+  }
+}
+  return VECTOR_TEST_OK(BITSET_TAG);
+}
+
+/*
+ * shrink_to_fit gives back everything past size(). The automatic
+ * policy halves capacity once size drops under a quarter of it, and
+ * must not reallocate over and over when size oscillates.
+ */
+static void shrink_test() {
+// shrink_to_fit
+{
+  ft::vector<int> ft_vec;
+  std::vector<int> std_vec;
+  for (int i = 0; i < 1000; i++) {
+    ft_vec.push_back(i);
+    std_vec.push_back(i);
+  }
+  ft_vec.erase(ft_vec.begin() + 10, ft_vec.end());
+  std_vec.erase(std_vec.begin() + 10, std_vec.end());
+  ft_vec.shrink_to_fit();
+  if (ft_vec.capacity() != 10
+      || !ft::equal(std_vec.begin(), std_vec.end(), ft_vec.begin()))
+  {
+    return VECTOR_TEST_ERROR(KO_SHRINK);
+  }
+  ft_vec.clear();
+  ft_vec.shrink_to_fit();
+  if (ft_vec.capacity() != 0) {
+    return VECTOR_TEST_ERROR(KO_SHRINK);
+  }
+  ft_vec.push_back(1);
+  if (ft_vec.size() != 1 || ft_vec.back() != 1) {
+    return VECTOR_TEST_ERROR(KO_SHRINK);
+  }
+}
+// automatic policy
+{
+  ft::vector<int> ft_vec;
+  ft_vec.set_auto_shrink(true);
+  for (int i = 0; i < 4096; i++) {
+    ft_vec.push_back(i);
+  }
+  size_t peak = ft_vec.capacity();
+  while (ft_vec.size() > 100) {
+    ft_vec.pop_back();
+    if (ft_vec.size() < ft_vec.capacity() / 4
+        && ft_vec.capacity() > ft::vector<int>::auto_shrink_min_capacity)
+    {
+      return VECTOR_TEST_ERROR(KO_SHRINK);
+    }
+  }
+  if (!(ft_vec.capacity() < peak) || ft_vec.capacity() < ft_vec.size()) {
+    return VECTOR_TEST_ERROR(KO_SHRINK);
+  }
+  for (int i = 0; i < 100; i++) {
+    if (ft_vec[i] != i) {
+      return VECTOR_TEST_ERROR(KO_SHRINK);
+    }
+  }
+  // oscillating around the current size never reallocates
+  int* buffer = ft_vec.data();
+  for (int i = 0; i < 1000; i++) {
+    ft_vec.push_back(i);
+    ft_vec.pop_back();
+    ft_vec.pop_back();
+    ft_vec.push_back(i);
+  }
+  if (ft_vec.data() != buffer) {
+    return VECTOR_TEST_ERROR(KO_SHRINK);
+  }
+  ft_vec.erase(ft_vec.begin() + 1, ft_vec.end());
+  if (ft_vec.capacity() > ft::vector<int>::auto_shrink_min_capacity) {
+    return VECTOR_TEST_ERROR(KO_SHRINK);
+  }
+}
+// the flag follows copies, whether constructed or assigned
+{
+  ft::vector<int> on(10, 1);
+  on.set_auto_shrink(true);
+  ft::vector<int> copied(on);
+  ft::vector<int> assigned(3, 2);
+  ft::vector<int> big(1000, 3);
+  assigned = on;
+  big = on;
+  if (!copied.auto_shrink() || !assigned.auto_shrink()
+      || !big.auto_shrink() || big.size() != 10
+      || big.capacity() >= 1000)
+  {
+    return VECTOR_TEST_ERROR(KO_SHRINK);
+  }
+  ft::vector<int> off(10, 1);
+  assigned = off;
+  if (assigned.auto_shrink()) {
+    return VECTOR_TEST_ERROR(KO_SHRINK);
+  }
+}
+  return VECTOR_TEST_OK(SHRINK_TAG);
+}
+
+/*
+ * resize_default_init / append_uninitialized, filled through the
+ * returned pointer like a read() would, for a trivial and a non
+ * trivial type.
+ */
+static void default_init_test() {
+{
+  ft::vector<int> ft_vec;
+  std::vector<int> std_vec;
+  for (int chunk = 0; chunk < 20; chunk++) {
+    int* p = ft_vec.append_uninitialized(chunk * 3);
+    for (int i = 0; i < chunk * 3; i++) {
+      p[i] = chunk + i;
+      std_vec.push_back(chunk + i);
+    }
+  }
+  if (ft_vec.size() != std_vec.size()
+      || !ft::equal(std_vec.begin(), std_vec.end(), ft_vec.begin()))
+  {
+    return VECTOR_TEST_ERROR(KO_RESIZE);
+  }
+  ft_vec.resize_default_init(10);
+  std_vec.resize(10);
+  ft_vec.resize_default_init(1000);
+  for (int i = 10; i < 1000; i++) {
+    ft_vec[i] = -i;
+    std_vec.push_back(-i);
+  }
+  if (ft_vec.size() != std_vec.size()
+      || !ft::equal(std_vec.begin(), std_vec.end(), ft_vec.begin()))
+  {
+    return VECTOR_TEST_ERROR(KO_RESIZE);
+  }
+}
+{
+  ft::vector<std::string> ft_vec(3, "abc");
+  std::string* p = ft_vec.append_uninitialized(5);
+  if (ft_vec.size() != 8 || p != ft_vec.data() + 3 || !p[4].empty()) {
+    return VECTOR_TEST_ERROR(KO_RESIZE);
+  }
+  p[0] = "filled";
+  ft_vec.resize_default_init(4);
+  if (ft_vec.size() != 4 || ft_vec[3] != "filled" || ft_vec[0] != "abc") {
+    return VECTOR_TEST_ERROR(KO_RESIZE);
+  }
+}
+  return VECTOR_TEST_OK(RESIZE_TAG);
+}
+
+/*
+ * append from raw pointers, ft iterators (memcpy path), std
+ * iterators (element wise path) and for a non trivial type. A batch
+ * reallocates at most once.
+ */
+static void append_test() {
+{
+  int matrix[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  ft::vector<int> ft_src(matrix, matrix + 10);
+  std::vector<int> std_src(matrix, matrix + 10);
+
+  ft::vector<int> ft_vec;
+  std::vector<int> std_vec;
+  for (int i = 0; i < 30; i++) {
+    int* before = ft_vec.data();
+    size_t old_capacity = ft_vec.capacity();
+    switch (i % 3) {
+      case 0: ft_vec.append(matrix, i % 10); break;
+      case 1: ft_vec.append(ft_src.begin(), ft_src.begin() + i % 10); break;
+      default: ft_vec.append(std_src.begin(), std_src.begin() + i % 10);
+    }
+    std_vec.insert(std_vec.end(), matrix, matrix + i % 10);
+    if (old_capacity >= ft_vec.size() && before != ft_vec.data()) {
+      return VECTOR_TEST_ERROR(KO_APPEND);
+    }
+  }
+  if (ft_vec.size() != std_vec.size()
+      || !ft::equal(std_vec.begin(), std_vec.end(), ft_vec.begin()))
+  {
+    return VECTOR_TEST_ERROR(KO_APPEND);
+  }
+}
+{
+  std::string words[4] = {"a", "bb", "ccc", "dddd"};
+  ft::vector<std::string> ft_vec(2, "x");
+  ft_vec.append(words, 4);
+  ft_vec.append(words + 1, words + 3);
+  std::string expected[8] = {"x", "x", "a", "bb", "ccc", "dddd", "bb", "ccc"};
+  if (ft_vec.size() != 8 || !ft::equal(expected, expected + 8, ft_vec.begin())) {
+    return VECTOR_TEST_ERROR(KO_APPEND);
+  }
+  // its own elements, with and without a reallocation
+  ft_vec.shrink_to_fit();
+  ft_vec.append(ft_vec.begin() + 2, ft_vec.begin() + 4);
+  ft_vec.reserve(20);
+  ft_vec.append(ft_vec.begin(), ft_vec.end());
+  if (ft_vec.size() != 20 || ft_vec[8] != "a" || ft_vec[9] != "bb"
+      || !ft::equal(ft_vec.begin(), ft_vec.begin() + 10,
+                    ft_vec.begin() + 10))
+  {
+    return VECTOR_TEST_ERROR(KO_APPEND);
+  }
+}
+{
+  ft::vector<int> ft_vec(3, 7);
+  ft_vec.shrink_to_fit();
+  ft_vec.append(ft_vec.begin(), ft_vec.end());
+  // single pass : read once, not measured first
+  std::istringstream in("1 2 3 4 5");
+  ft_vec.append(std::istream_iterator<int>(in),
+                std::istream_iterator<int>());
+  int expected[11] = {7, 7, 7, 7, 7, 7, 1, 2, 3, 4, 5};
+  if (ft_vec.size() != 11
+      || !ft::equal(expected, expected + 11, ft_vec.begin()))
+  {
+    return VECTOR_TEST_ERROR(KO_APPEND);
+  }
+}
+  return VECTOR_TEST_OK(APPEND_TAG);
+}
+
+static bool is_odd( int x ) {
+  return x % 2 != 0;
+}
+
+static bool is_long( const std::string& x ) {
+  return x.size() > 2;
+}
+
+// is_odd, counting its calls.
+struct counted_odd {
+
+  int* calls;
+
+  explicit counted_odd( int* c ) : calls(c) {}
+
+  bool operator()( int x ) const {
+    ++*calls;
+    return is_odd(x);
+  }
+};
+
+/*
+ * ft::erase_if / ft::erase against std::remove_if + erase, and
+ * remove_indices against a loop of erase(iterator) from the back.
+ */
+static void erase_if_test() {
+  for (int vector_size = 0; vector_size < 40; vector_size++) {
+    ft::vector<int> ft_vec;
+    std::vector<int> std_vec;
+    for (int i = 0; i < vector_size; i++) {
+      ft_vec.push_back((i * 7) % 11);
+      std_vec.push_back((i * 7) % 11);
+    }
+    size_t removed = ft::erase_if(ft_vec, is_odd);
+    std_vec.erase(std::remove_if(std_vec.begin(), std_vec.end(), is_odd),
+                  std_vec.end());
+    if (removed != vector_size - std_vec.size()
+        || ft_vec.size() != std_vec.size()
+        || !ft::equal(std_vec.begin(), std_vec.end(), ft_vec.begin()))
+    {
+      return VECTOR_TEST_ERROR(KO_ERASE_IF);
+    }
+    ft::erase(ft_vec, 4);
+    std_vec.erase(std::remove(std_vec.begin(), std_vec.end(), 4),
+                  std_vec.end());
+    if (ft_vec.size() != std_vec.size()
+        || !ft::equal(std_vec.begin(), std_vec.end(), ft_vec.begin()))
+    {
+      return VECTOR_TEST_ERROR(KO_ERASE_IF);
+    }
+  }
+{
+  std::string words[6] = {"a", "bbb", "cc", "dddd", "e", "a"};
+  ft::vector<std::string> ft_vec(words, words + 6);
+  if (ft::erase_if(ft_vec, is_long) != 2 || ft::erase(ft_vec, "a") != 2
+      || ft_vec.size() != 2 || ft_vec[0] != "cc" || ft_vec[1] != "e")
+  {
+    return VECTOR_TEST_ERROR(KO_ERASE_IF);
+  }
+}
+// pred once per element, whatever the runs of survivors look like
+{
+  int values[12] = {0, 1, 2, 3, 4, 5, 6, 8, 10, 7, 9, 12};
+  for (int n = 0; n <= 12; n++) {
+    ft::vector<int> ft_vec(values, values + n);
+    int calls = 0;
+    ft::erase_if(ft_vec, counted_odd(&calls));
+    if (calls != n) {
+      return VECTOR_TEST_ERROR(KO_ERASE_IF);
+    }
+  }
+}
+// remove_indices
+{
+  size_t indices[7] = {0, 3, 3, 4, 10, 18, 19};
+  for (int n_indices = 0; n_indices <= 7; n_indices++) {
+    ft::vector<std::string> ft_vec;
+    std::vector<std::string> std_vec;
+    for (int i = 0; i < 20; i++) {
+      ft_vec.push_back(std::string(i + 1, 'x'));
+      std_vec.push_back(std::string(i + 1, 'x'));
+    }
+    ft::vector<int> ft_ints(20, 1);
+    for (int k = n_indices - 1; k >= 0; k--) {
+      if (k + 1 < n_indices && indices[k] == indices[k + 1]) {
+        continue;
+      }
+      std_vec.erase(std_vec.begin() + indices[k]);
+    }
+    ft_vec.remove_indices(indices, indices + n_indices);
+    ft_ints.remove_indices(indices, indices + n_indices);
+    if (ft_vec.size() != std_vec.size() || ft_ints.size() != std_vec.size()
+        || !ft::equal(std_vec.begin(), std_vec.end(), ft_vec.begin()))
+    {
+      return VECTOR_TEST_ERROR(KO_ERASE_IF);
+    }
+  }
+  size_t bad[2] = {5, 2};
+  ft::vector<int> ft_vec(10, 1);
+  try {
+    ft_vec.remove_indices(bad, bad + 2);
+    return VECTOR_TEST_ERROR(KO_ERASE_IF);
+  } catch (std::invalid_argument&) {}
+  if (ft_vec.size() != 10) {
+    return VECTOR_TEST_ERROR(KO_ERASE_IF);
+  }
+}
+  return VECTOR_TEST_OK(ERASE_IF_TAG);
+}
+
+// counts copy constructions and copy assignments.
+struct tracked {
+
+  static int copies;
+  static int assignments;
+
+  int value;
+
+  tracked( int v = 0 ) : value(v) {}
+  tracked( const tracked& other ) : value(other.value) { ++copies; }
+
+  tracked& operator=( const tracked& other ) {
+    value = other.value;
+    ++assignments;
+    return *this;
+  }
+
+  bool operator!=( const tracked& other ) const {
+    return value != other.value;
+  }
+};
+
+int tracked::copies = 0;
+int tracked::assignments = 0;
+
+/*
+ * Copies are right-sized, assignment reuses the elements already
+ * in place and keeps the buffer when it is big enough.
+ */
+static void copy_reuse_test() {
+{
+  ft::vector<int> big;
+  big.reserve(100000);
+  for (int i = 0; i < 10; i++) {
+    big.push_back(i);
+  }
+  ft::vector<int> copy(big);
+  if (copy.capacity() != 10 || !ft::equal(big.begin(), big.end(), copy.begin())) {
+    return VECTOR_TEST_ERROR(KO_ASSIGNMENT);
+  }
+  ft::vector<int> assigned(3, 7);
+  assigned = big;
+  if (assigned.capacity() != 10 || assigned.size() != 10
+      || !ft::equal(big.begin(), big.end(), assigned.begin()))
+  {
+    return VECTOR_TEST_ERROR(KO_ASSIGNMENT);
+  }
+}
+{
+  ft::vector<tracked> source;
+  for (int i = 0; i < 8; i++) {
+    source.push_back(tracked(i));
+  }
+  ft::vector<tracked> dest(5, tracked(-1));
+  dest.reserve(20);
+  tracked* buffer = dest.data();
+
+  tracked::copies = 0;
+  tracked::assignments = 0;
+  dest = source; // grows inside capacity : 5 assignments, 3 copies
+  if (dest.data() != buffer || tracked::assignments != 5
+      || tracked::copies != 3
+      || !ft::equal(source.begin(), source.end(), dest.begin()))
+  {
+    return VECTOR_TEST_ERROR(KO_ASSIGNMENT);
+  }
+  source.resize(2);
+  tracked::copies = 0;
+  tracked::assignments = 0;
+  dest = source; // shrinks : 2 assignments, no copy
+  if (dest.data() != buffer || dest.size() != 2
+      || tracked::assignments != 2 || tracked::copies != 0)
+  {
+    return VECTOR_TEST_ERROR(KO_ASSIGNMENT);
+  }
+}
+  return VECTOR_TEST_OK(ASSIGNMENT_TAG);
+}
+
+/*
+ * The byte kernels must agree with a plain loop for every length and
+ * mismatch position, around the 8 / 16 / 32 byte steps.
+ */
+static bool mismatch_kernels_agree() {
+
+  unsigned char a[160];
+  unsigned char b[160];
+  for (int i = 0; i < 160; i++) {
+    a[i] = (unsigned char)(i * 7);
+  }
+  for (size_t n = 0; n <= 130; n++) {
+    for (size_t pos = 0; pos <= n; pos++) {
+      std::memcpy(b, a, sizeof(a));
+      if (pos < n) {
+        b[pos] ^= 0x80;
+      }
+      if (ft::mismatch_scalar(a, b, n) != pos
+          || ft::mismatch_bytes(a, b, n) != pos)
+      {
+        return false;
+      }
+#ifdef FT_CONTAINERS_X86_SIMD
+      if (ft::mismatch_sse2(a, b, n) != pos) {
+        return false;
+      }
+      if (__builtin_cpu_supports("avx2") && ft::mismatch_avx2(a, b, n) != pos) {
+        return false;
+      }
+#endif
+    }
+  }
+  return true;
+}
+
+/*
+ * ft::vector == and < (bytewise on integers) against std::vector,
+ * random lengths, one element changed in one byte or entirely.
+ */
+template <typename T>
+static bool compare_round( unsigned seed ) {
+
+  srand(seed);
+  for (int round = 0; round < 500; round++) {
+    size_t n1 = rand() % 100;
+    size_t n2 = rand() % 3 ? n1 : rand() % 100;
+    std::vector<T> a;
+    for (size_t i = 0; i < n1; i++) {
+      a.push_back(T(rand() - RAND_MAX / 2));
+    }
+    std::vector<T> b(a.begin(), a.begin() + std::min(n1, n2));
+    b.resize(n2, T(rand()));
+    if (!b.empty() && rand() % 2) {
+      size_t k = rand() % b.size();
+      if (rand() % 2) {
+        b[k] = T(b[k] ^ (T(1) << (8 * (rand() % sizeof(T)))));
+      } else {
+        b[k] = T(rand() - RAND_MAX / 2);
+      }
+    }
+    ft::vector<T> fa(a.begin(), a.end());
+    ft::vector<T> fb(b.begin(), b.end());
+    if ((fa == fb) != (a == b) || (fa < fb) != (a < b)
+        || (fb < fa) != (b < a) || (fa <= fb) != (a <= b))
+    {
+      return false;
+    }
+    if (n1 && n1 <= n2
+        && ft::equal(&a[0], &a[0] + n1, &b[0])
+           != std::equal(a.begin(), a.end(), b.begin()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void compare_test() {
+
+  if (!mismatch_kernels_agree()) {
+    return VECTOR_TEST_ERROR(KO_COMPARE);
+  }
+  if (!compare_round<char>(1) || !compare_round<signed char>(2)
+      || !compare_round<unsigned char>(3) || !compare_round<short>(4)
+      || !compare_round<int>(5) || !compare_round<unsigned>(6)
+      || !compare_round<long>(7) || !compare_round<unsigned long long>(8))
+  {
+    return VECTOR_TEST_ERROR(KO_COMPARE);
+  }
+  // not bytewise : 0.0 == -0.0
+  ft::vector<double> zero(3, 0.0);
+  ft::vector<double> negative_zero(3, -0.0);
+  if (!(zero == negative_zero) || zero < negative_zero) {
+    return VECTOR_TEST_ERROR(KO_COMPARE);
+  }
+  return VECTOR_TEST_OK(COMPARE_TAG);
+}
+
+/*
+ * Allocation budgets : reserve allocates once, and nothing else does
+ * until the capacity runs out.
+ */
+static void allocation_test() {
+
+  typedef ft::counting_allocator<int> counting;
+  ft::allocation_stats stats;
+{
+  ft::vector<int, counting> v((counting(stats)));
+  v.reserve(100);
+  if (stats.allocations != 1 || stats.live_bytes != 100 * sizeof(int)) {
+    return VECTOR_TEST_ERROR(KO_ALLOCATION);
+  }
+  for (int i = 0; i < 100; i++) {
+    v.push_back(i);
+  }
+  v.pop_back();
+  v.insert(v.begin(), 7);
+  v.erase(v.begin());
+  v.pop_back();
+  v.resize(100);
+  if (stats.allocations != 1) {
+    return VECTOR_TEST_ERROR(KO_ALLOCATION);
+  }
+  v.push_back(100);
+  v.push_back(101);
+  if (stats.allocations != 2 || stats.deallocations != 1) {
+    return VECTOR_TEST_ERROR(KO_ALLOCATION);
+  }
+  ft::vector<int, counting> copy(v);
+  v.clear();
+  v.append(&copy[0], 100);
+  if (stats.allocations != 3 || stats.live_allocations() != 2) {
+    return VECTOR_TEST_ERROR(KO_ALLOCATION);
+  }
+}
+  if (stats.live_allocations() != 0 || stats.live_bytes != 0) {
+    return VECTOR_TEST_ERROR(KO_ALLOCATION);
+  }
+{
+  // A vector that never allocated has nothing to give back.
+  ft::vector<int, counting> empty((counting(stats)));
+}
+  if (stats.deallocations != stats.allocations) {
+    return VECTOR_TEST_ERROR(KO_ALLOCATION);
+  }
+  return VECTOR_TEST_OK(ALLOCATION_TAG);
+}
+
+#ifdef FT_CONTAINERS_CXX11
+// tracked, plus a noexcept move constructor and move assignment.
+struct movable : public tracked {
+
+  static int moves;
+
+  movable( int v = 0 ) : tracked(v) {}
+  movable( const movable& other ) : tracked(other) {}
+  movable( movable&& other ) noexcept : tracked() {
+    value = other.value;
+    other.value = -1;
+    ++moves;
+  }
+
+  movable& operator=( const movable& other ) {
+    tracked::operator=(other);
+    return *this;
+  }
+
+  movable& operator=( movable&& other ) noexcept {
+    value = other.value;
+    other.value = -1;
+    ++moves;
+    return *this;
+  }
+};
+
+int movable::moves = 0;
+
+/*
+ * C++11 mode only : growth, insertion and erasure move elements
+ * around instead of copying them, emplace builds in place and a
+ * moved vector hands its buffer over.
+ */
+static void move_test() {
+{
+  tracked::copies = 0;
+  tracked::assignments = 0;
+  ft::vector<movable> v;
+  for (int i = 0; i < 1000; i++) {
+    v.emplace_back(i);
+  }
+  v.push_back(movable(1000));
+  v.insert(v.begin(), movable(-2));
+  v.emplace(v.begin() + 10, -3);
+  v.erase(v.begin(), v.begin() + 5);
+  if (tracked::copies != 0 || tracked::assignments != 0
+      || v.size() != 998 || v[5].value != -3 || v.back().value != 1000)
+  {
+    return VECTOR_TEST_ERROR(KO_MOVE);
+  }
+  movable* buffer = v.data();
+  ft::vector<movable> stolen(std::move(v));
+  if (stolen.data() != buffer || stolen.size() != 998
+      || v.size() != 0 || v.capacity() != 0)
+  {
+    return VECTOR_TEST_ERROR(KO_MOVE);
+  }
+  v = std::move(stolen);
+  if (v.data() != buffer || stolen.size() != 0 || tracked::copies != 0) {
+    return VECTOR_TEST_ERROR(KO_MOVE);
+  }
+}
+{
+  // emplace_back from an element of the vector itself, while growing.
+  ft::vector<std::string> v(1, "aliased");
+  v.shrink_to_fit();
+  v.emplace_back(v[0]);
+  std::string s(100, 'x');
+  v.push_back(std::move(s));
+  if (v.size() != 3 || v[1] != "aliased" || v[2] != std::string(100, 'x')) {
+    return VECTOR_TEST_ERROR(KO_MOVE);
+  }
+}
+  return VECTOR_TEST_OK(MOVE_TAG);
+}
+#endif